@@ -0,0 +1,403 @@
+/**
+ * Emulator throughput benchmarks.
+ *
+ * Runs each workload in workloads/ through the C library with delayed branches off and on, and
+ * writes one tab-separated line per run: time spent assembling, loading the shared image and
+ * running (the median over --repeat runs from the same snapshot), guest MIPS per host second and
+ * host nanoseconds per guest instruction. One more run of each with collect_stats counts the
+ * instructions it executes per opcode, grouped into classes (alu, mul_div, memory, branch, fp,
+ * system); that table follows the main one. What each class costs is microbench's job. The
+ * output is stable in layout, so two commits' results can be diffed directly.
+ *
+ * bench exits 1 if any workload would take longer than the README's budget of 10,000,000 cycles
+ * in 12 seconds. With --baseline it also reports each workload's change against an earlier run:
+ *
+ *     bench --output new.tsv --baseline old.tsv --tolerance 5 --strict
+ *
+ * warns about anything more than 5% slower than in old.tsv, and with --strict fails on it too.
+ * Timings vary between machines and runs, so only the budget check fails by default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "spimbot.h"
+
+#ifndef SPIMBOT_BENCH_WORKLOADS
+#define SPIMBOT_BENCH_WORKLOADS "bench/workloads"
+#endif
+
+namespace {
+
+constexpr uint64_t BUDGET_CYCLES = 10000000;
+constexpr double BUDGET_SECONDS = 12.0;
+
+struct Workload {
+    const char *name;
+    const char *instruction_class; /* The opcode_class the workload mostly executes */
+    const char *source;
+    const char *exception_file; /* nullptr for the built-in handler */
+};
+
+const Workload WORKLOADS[] = {
+    {"alu", "alu", "alu.s", nullptr},
+    {"memory", "memory", "memory.s", nullptr},
+    {"syscall", "system", "syscall.s", nullptr},
+    {"interrupt", "system", "interrupt.s", "interrupt_handler.s"},
+};
+
+struct Options {
+    std::string workload_dir = SPIMBOT_BENCH_WORKLOADS;
+    std::string output;
+    std::string baseline;
+    std::string only;
+    uint64_t cycles = BUDGET_CYCLES;
+    int repeat = 5;
+    double tolerance = 5.0;
+    bool strict = false; /* Fail, rather than warn, when slower than the baseline */
+};
+
+struct Result {
+    std::string workload;
+    std::string instruction_class;
+    bool delayed_branches = false;
+    uint64_t instructions = 0;
+    double assemble_ms = 0;
+    double load_ms = 0;
+    double run_ms = 0;
+    std::map<std::string, uint64_t> classes; /* Instructions executed per class (opcode_class) */
+
+    double mips() const { return this->run_ms > 0 ? this->instructions / (this->run_ms * 1e3) : 0; }
+    double ns_per_inst() const { return this->instructions > 0 ? this->run_ms * 1e6 / this->instructions : 0; }
+    double budget_seconds() const { return this->ns_per_inst() * BUDGET_CYCLES * 1e-9; }
+
+    std::string key() const { return this->workload + (this->delayed_branches ? "/delayed" : "/plain"); }
+};
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void usage(FILE *out) {
+    fprintf(out,
+            "usage: bench [--output FILE] [--baseline FILE] [--tolerance PERCENT] [--strict]\n"
+            "             [--cycles N] [--repeat N] [--workloads DIR] [--only NAME]\n");
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            usage(stdout);
+            exit(0);
+        }
+        if (arg == "--strict") {
+            options.strict = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+        if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = atof(value);
+        } else if (arg == "--cycles") {
+            options.cycles = strtoull(value, nullptr, 10);
+        } else if (arg == "--repeat") {
+            options.repeat = std::max(1, atoi(value));
+        } else if (arg == "--workloads") {
+            options.workload_dir = value;
+        } else if (arg == "--only") {
+            options.only = value;
+        } else {
+            return false;
+        }
+    }
+    return options.cycles != 0;
+}
+
+/* The class an opcode's mnemonic (as in spim_dump_stats) belongs to. */
+std::string opcode_class(const std::string &name) {
+    static const std::set<std::string> MEMORY = {"lb",   "lbu",  "lh",   "lhu",  "lw",   "lwl",  "lwr",
+                                                 "ll",   "sb",   "sh",   "sw",   "swl",  "swr",  "sc",
+                                                 "lwc1", "swc1", "ldc1", "sdc1", "lwc2", "swc2"};
+    static const std::set<std::string> MUL_DIV = {"mult", "multu", "div",  "divu", "mul",  "madd",
+                                                  "maddu", "msub", "msubu", "mfhi", "mflo", "mthi", "mtlo"};
+    static const std::set<std::string> SYSTEM = {"syscall", "break", "eret", "mfc0", "mtc0"};
+    static const std::set<std::string> FP_MOVES = {"mfc1", "mtc1", "cfc1", "ctc1"};
+
+    if (MEMORY.count(name) != 0) {
+        return "memory";
+    } else if (MUL_DIV.count(name) != 0) {
+        return "mul_div";
+    } else if (SYSTEM.count(name) != 0) {
+        return "system";
+    } else if (name[0] == 'j' || (name[0] == 'b' && name != "break")) {
+        return "branch"; /* Including bc1f/bc1t */
+    } else if (name.find('.') != std::string::npos || FP_MOVES.count(name) != 0) {
+        return "fp";
+    }
+    return "alu";
+}
+
+/* Add the "opcodes" counts of the JSON that spim_dump_stats wrote to PATH, by class, to CLASSES. */
+bool read_class_counts(const std::string &path, std::map<std::string, uint64_t> &classes) {
+    FILE *in = fopen(path.c_str(), "r");
+    if (in == nullptr) {
+        return false;
+    }
+
+    /* One opcode per line between `"opcodes": {` and the closing brace. */
+    bool found = false;
+    char line[256];
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        if (!found) {
+            found = strstr(line, "\"opcodes\": {") != nullptr;
+            if (found && strchr(line, '}') != nullptr) {
+                break; /* Nothing executed */
+            }
+            continue;
+        }
+        char name[64];
+        unsigned long long count;
+        if (sscanf(line, " \"%63[^\"]\": %llu", name, &count) != 2) {
+            break;
+        }
+        classes[opcode_class(name)] += count;
+    }
+    fclose(in);
+    return found;
+}
+
+/* Run IMAGE once more on a CPU that collects statistics, and count what it executed by class. */
+bool count_classes(const Options &options, spim_options spim, const spim_image *image, Result &result) {
+    char path[] = "/tmp/spimbot_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        return false;
+    }
+    close(fd);
+
+    spim.collect_stats = 1;
+    spim_cpu *cpu = spim_create(&spim);
+    bool ok = spim_load_image(cpu, image) == SPIM_OK;
+    if (ok) {
+        spim_run(cpu, options.cycles, nullptr);
+        ok = spim_dump_stats(cpu, path) == SPIM_OK && read_class_counts(path, result.classes);
+    }
+    spim_destroy(cpu);
+    unlink(path);
+    return ok;
+}
+
+/* Assemble, share and run WORKLOAD once per repetition; false if it does not assemble. */
+bool run_workload(const Options &options, const Workload &workload, bool delayed_branches, Result &result) {
+    std::string source = options.workload_dir + "/" + workload.source;
+    std::string exception_file;
+    if (workload.exception_file != nullptr) {
+        exception_file = options.workload_dir + "/" + workload.exception_file;
+    }
+
+    spim_options spim;
+    spim_default_options(&spim);
+    spim.delayed_branches = delayed_branches;
+    spim.exception_file = exception_file.empty() ? nullptr : exception_file.c_str();
+
+    result.workload = workload.name;
+    result.instruction_class = workload.instruction_class;
+    result.delayed_branches = delayed_branches;
+
+    spim_cpu *assembler = spim_create(&spim);
+    Clock::time_point start = Clock::now();
+    spim_status status = spim_load_asm(assembler, source.c_str());
+    result.assemble_ms = ms_since(start);
+    spim_image *image = status == SPIM_OK ? spim_share_image(assembler) : nullptr;
+    spim_destroy(assembler);
+    if (image == nullptr) {
+        fprintf(stderr, "bench: %s did not assemble\n", source.c_str());
+        return false;
+    }
+
+    spim_cpu *cpu = spim_create(&spim);
+    start = Clock::now();
+    status = spim_load_image(cpu, image);
+    result.load_ms = ms_since(start);
+    if (status != SPIM_OK) {
+        fprintf(stderr, "bench: cannot load the image of %s\n", source.c_str());
+        spim_destroy(cpu);
+        spim_image_release(image);
+        return false;
+    }
+    spim_snap *loaded = spim_snapshot(cpu);
+
+    std::vector<double> runs;
+    for (int i = 0; i < options.repeat; ++i) {
+        spim_restore(cpu, loaded);
+        start = Clock::now();
+        result.instructions = spim_run(cpu, options.cycles, nullptr);
+        runs.push_back(ms_since(start));
+    }
+    std::sort(runs.begin(), runs.end());
+    result.run_ms = runs[runs.size() / 2];
+
+    spim_snapshot_release(loaded);
+    spim_destroy(cpu);
+
+    /* Counting is a separate run so that it does not slow down the timed ones. */
+    bool counted = count_classes(options, spim, image, result);
+    spim_image_release(image);
+    if (!counted) {
+        fprintf(stderr, "bench: cannot count the instructions of %s\n", source.c_str());
+    }
+    return counted;
+}
+
+void write_results(FILE *out, const std::vector<Result> &results) {
+    fprintf(out, "workload\tclass\tdelayed_branches\tinstructions\tassemble_ms\tload_ms\trun_ms\tmips\tns_per_inst\t"
+                 "budget_s\n");
+    for (const Result &r : results) {
+        fprintf(out, "%s\t%s\t%d\t%llu\t%.3f\t%.3f\t%.3f\t%.2f\t%.2f\t%.2f\n", r.workload.c_str(),
+                r.instruction_class.c_str(), r.delayed_branches, (unsigned long long)r.instructions, r.assemble_ms,
+                r.load_ms, r.run_ms, r.mips(), r.ns_per_inst(), r.budget_seconds());
+    }
+
+    /* What each run executed, by class. */
+    fprintf(out, "\nworkload\tdelayed_branches\tclass\tinstructions\tshare\n");
+    for (const Result &r : results) {
+        uint64_t executed = 0;
+        for (const auto &c : r.classes) {
+            executed += c.second;
+        }
+        for (const auto &c : r.classes) {
+            fprintf(out, "%s\t%d\t%s\t%llu\t%.4f\n", r.workload.c_str(), r.delayed_branches, c.first.c_str(),
+                    (unsigned long long)c.second, double(c.second) / executed);
+        }
+    }
+}
+
+std::vector<std::string> split_tabs(const std::string &line) {
+    std::vector<std::string> fields;
+    size_t begin = 0;
+    for (size_t tab; (tab = line.find('\t', begin)) != std::string::npos; begin = tab + 1) {
+        fields.push_back(line.substr(begin, tab - begin));
+    }
+    fields.push_back(line.substr(begin));
+    return fields;
+}
+
+/* MIPS by Result::key() from the per-workload table of an earlier run; false if unreadable. */
+bool read_baseline(const std::string &path, std::map<std::string, double> &mips) {
+    FILE *in = fopen(path.c_str(), "r");
+    if (in == nullptr) {
+        return false;
+    }
+
+    std::vector<std::string> header;
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), in) != nullptr) {
+        std::string line(buffer, strcspn(buffer, "\r\n"));
+        if (line.empty()) {
+            break; /* End of the per-workload table */
+        }
+        std::vector<std::string> fields = split_tabs(line);
+        if (header.empty()) {
+            header = fields;
+            continue;
+        }
+
+        std::map<std::string, std::string> row;
+        for (size_t i = 0; i < std::min(header.size(), fields.size()); ++i) {
+            row[header[i]] = fields[i];
+        }
+        std::string key = row["workload"] + (row["delayed_branches"] == "1" ? "/delayed" : "/plain");
+        mips[key] = atof(row["mips"].c_str());
+    }
+    fclose(in);
+    return !header.empty();
+}
+
+/* Number of results over the cycle budget, plus, if STRICT, those more than TOLERANCE percent
+   slower than BASELINE. */
+int check(const std::vector<Result> &results, const std::map<std::string, double> &baseline, double tolerance,
+          bool strict) {
+    int failures = 0;
+    for (const Result &r : results) {
+        if (r.budget_seconds() > BUDGET_SECONDS) {
+            fprintf(stderr, "bench: %s needs %.1f s for %llu cycles (budget %.0f s)\n", r.key().c_str(),
+                    r.budget_seconds(), (unsigned long long)BUDGET_CYCLES, BUDGET_SECONDS);
+            ++failures;
+        }
+
+        auto it = baseline.find(r.key());
+        if (it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+        double change = (r.mips() - it->second) / it->second * 100;
+        bool regressed = change < -tolerance;
+        fprintf(stderr, "bench: %-20s %8.2f MIPS (%+.1f%%)%s\n", r.key().c_str(), r.mips(), change,
+                regressed ? "  slower than the baseline allows" : "");
+        if (regressed && strict) {
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(stderr);
+        return 2;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!options.baseline.empty() && !read_baseline(options.baseline, baseline)) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", options.baseline.c_str());
+        return 2;
+    }
+
+    std::vector<Result> results;
+    for (const Workload &workload : WORKLOADS) {
+        if (!options.only.empty() && options.only != workload.name) {
+            continue;
+        }
+        for (bool delayed_branches : {false, true}) {
+            Result result;
+            if (!run_workload(options, workload, delayed_branches, result)) {
+                return 2;
+            }
+            results.push_back(result);
+        }
+    }
+
+    /* Workloads that print write to stdout, so results only go there when no file is given. */
+    FILE *out = options.output.empty() ? stdout : fopen(options.output.c_str(), "w");
+    if (out == nullptr) {
+        fprintf(stderr, "bench: cannot write %s\n", options.output.c_str());
+        return 2;
+    }
+    write_results(out, results);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    return check(results, baseline, options.tolerance, options.strict) == 0 ? 0 : 1;
+}
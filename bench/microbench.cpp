@@ -0,0 +1,275 @@
+/**
+ * Per-opcode-group microbenchmarks for the interpreter loop (CPU::run_spim).
+ *
+ * Each group is a synthetic program: a little setup, then a loop whose body is UNROLL copies of
+ * a short sequence exercising one group of `case` arms (integer ALU, CLZ/CLO, mult/div, taken and
+ * untaken branches, loads and stores to each segment, single and double FP, CP0). Programs run
+ * with delayed branches, so every branch's `nop` executes and each unit is insts_per_unit
+ * instructions whether or not it branches. The loop's `j` and delay slot are measured by a nop
+ * group and subtracted, so the ns column is the cost of the instructions under test alone. Where
+ * the kernel allows perf_event_open, the host's branch mispredictions and instructions are
+ * counted per guest instruction as well; otherwise those columns read -1.
+ *
+ *     microbench [--cycles N] [--repeat N] [--only GROUP]
+ *
+ * Output is tab-separated like bench's.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "spimbot.h"
+
+namespace {
+
+constexpr int UNROLL = 64;
+
+struct Group {
+    const char *name;
+    const char *setup; /* Runs once before the loop */
+    const char *unit;  /* Repeated UNROLL times; "%d" expands to a number unique to the copy */
+    int insts_per_unit;
+};
+
+/* Every unit leaves the registers it reads as it found them, so each copy does the same work. */
+const Group GROUPS[] = {
+    {"nop", "", "nop\n", 1},
+    {"alu", "li $t1, 0x1234567\nli $t2, 77\n",
+     "addu $t3, $t1, $t2\nsubu $t4, $t1, $t2\nxor $t5, $t1, $t2\nor $t6, $t1, $t2\nand $t7, $t1, $t2\n"
+     "sll $t3, $t1, 3\nsra $t4, $t1, 5\nslt $t5, $t1, $t2\naddiu $t6, $t1, -9\nlui $t7, 0x1234\n",
+     10},
+    {"clz_clo", "li $t1, 0x00ff0000\nli $t2, 0xfff00000\n", "clz $t3, $t1\nclo $t4, $t2\n", 2},
+    {"mult", "li $t1, 0x12345\nli $t2, -0x6789\n", "mult $t1, $t2\nmultu $t1, $t2\nmflo $t3\nmfhi $t4\n", 4},
+    {"madd", "li $t1, 0x12345\nli $t2, -0x6789\n", "madd $t1, $t2\nmaddu $t1, $t2\nmsub $t1, $t2\nmsubu $t1, $t2\n", 4},
+    {"div", "li $t1, 0x7654321\nli $t2, -77\n", "div $t1, $t2\ndivu $t1, $t2\nmflo $t3\nmfhi $t4\n", 4},
+    {"branch_taken", "", "beq $zero, $zero, u%d\nnop\nu%d:\n", 2},
+    {"branch_untaken", "li $t1, 1\n", "beq $zero, $t1, u%d\nnop\nu%d:\n", 2},
+    {"jump", "", "jal u%d\nnop\nu%d:\n", 2},
+    {"load_data", "la $s0, buffer\n", "lw $t1, 0($s0)\nlh $t2, 4($s0)\nlbu $t3, 9($s0)\n", 3},
+    {"store_data", "la $s0, buffer\n", "sw $t1, 0($s0)\nsh $t2, 4($s0)\nsb $t3, 9($s0)\n", 3},
+    {"load_stack", "addiu $sp, $sp, -16\n", "lw $t1, 0($sp)\nlh $t2, 4($sp)\nlbu $t3, 9($sp)\n", 3},
+    {"store_stack", "addiu $sp, $sp, -16\n", "sw $t1, 0($sp)\nsh $t2, 4($sp)\nsb $t3, 9($sp)\n", 3},
+    {"load_kdata", "la $s0, kbuffer\n", "lw $t1, 0($s0)\nlh $t2, 4($s0)\nlbu $t3, 9($s0)\n", 3},
+    {"store_kdata", "la $s0, kbuffer\n", "sw $t1, 0($s0)\nsh $t2, 4($s0)\nsb $t3, 9($s0)\n", 3},
+    {"fp_single", "li $t0, 3\nmtc1 $t0, $f2\ncvt.s.w $f2, $f2\nli $t0, 7\nmtc1 $t0, $f4\ncvt.s.w $f4, $f4\n",
+     "add.s $f6, $f2, $f4\nmul.s $f8, $f2, $f4\ndiv.s $f10, $f2, $f4\nc.lt.s $f2, $f4\n", 4},
+    {"fp_double", "li $t0, 3\nmtc1 $t0, $f2\ncvt.d.w $f2, $f2\nli $t0, 7\nmtc1 $t0, $f4\ncvt.d.w $f4, $f4\n",
+     "add.d $f6, $f2, $f4\nmul.d $f8, $f2, $f4\ndiv.d $f10, $f2, $f4\nc.lt.d $f2, $f4\n", 4},
+    {"cp0", "", "mfc0 $t1, $12\nmtc0 $t1, $12\n", 2},
+};
+
+struct Options {
+    uint64_t cycles = 10000000;
+    int repeat = 5;
+    std::string only;
+};
+
+/* Host counters around a run; fds are -1 where perf_event_open is unavailable. */
+class PerfCounters {
+   public:
+    PerfCounters() {
+#ifdef __linux__
+        this->branch_misses = open_counter(PERF_COUNT_HW_BRANCH_MISSES);
+        this->instructions = open_counter(PERF_COUNT_HW_INSTRUCTIONS);
+#endif
+    }
+
+    ~PerfCounters() {
+        for (int fd : {this->branch_misses, this->instructions}) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    void start() {
+#ifdef __linux__
+        for (int fd : {this->branch_misses, this->instructions}) {
+            if (fd != -1) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /* Counts since start(), -1 for counters that could not be opened. */
+    void stop(int64_t &branch_misses, int64_t &instructions) {
+        branch_misses = read_counter(this->branch_misses);
+        instructions = read_counter(this->instructions);
+    }
+
+   private:
+#ifdef __linux__
+    static int open_counter(uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    static int64_t read_counter(int fd) {
+        if (fd == -1) {
+            return -1;
+        }
+#ifdef __linux__
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+        int64_t count;
+        return read(fd, &count, sizeof(count)) == sizeof(count) ? count : -1;
+    }
+
+    int branch_misses = -1;
+    int instructions = -1;
+};
+
+struct Measurement {
+    uint64_t guest_insts = 0;
+    double ns_per_inst = 0;
+    int64_t branch_misses = -1;
+    int64_t host_insts = -1;
+};
+
+/* Assembly text for GROUP: a data word buffer in each segment, setup, then the unrolled loop. */
+std::string program_for(const Group &group) {
+    std::string text =
+        "\t.data\n\t.align 2\nbuffer:\t.space 64\n"
+        "\t.kdata\n\t.align 2\nkbuffer:\t.space 64\n"
+        "\t.text\n\t.globl main\nmain:\n";
+    text += group.setup;
+    text += "loop:\n";
+
+    char unit[1024];
+    for (int i = 0; i < UNROLL; ++i) {
+        snprintf(unit, sizeof(unit), group.unit, i, i);
+        text += unit;
+    }
+    text += "j loop\nnop\n";
+    return text;
+}
+
+/* Write TEXT to a temporary file and return its path, or "" on failure. */
+std::string write_temp(const std::string &text) {
+    char path[] = "/tmp/spimbot_microbench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        return "";
+    }
+    bool ok = write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size());
+    close(fd);
+    if (!ok) {
+        unlink(path);
+        return "";
+    }
+    return path;
+}
+
+bool measure(const Options &options, const Group &group, PerfCounters &perf, Measurement &result) {
+    std::string path = write_temp(program_for(group));
+    if (path.empty()) {
+        return false;
+    }
+
+    spim_options spim;
+    spim_default_options(&spim);
+    spim.delayed_branches = 1; /* So every delay slot nop executes, as insts_per_unit counts it */
+    spim_cpu *cpu = spim_create(&spim);
+    spim_status status = spim_load_asm(cpu, path.c_str());
+    unlink(path.c_str());
+    if (status != SPIM_OK) {
+        fprintf(stderr, "microbench: %s did not assemble\n", group.name);
+        spim_destroy(cpu);
+        return false;
+    }
+
+    /* Skip the setup so that only the loop is timed. */
+    spim_run(cpu, 1000, nullptr);
+    spim_snap *warm = spim_snapshot(cpu);
+
+    std::vector<Measurement> runs;
+    for (int i = 0; i < options.repeat; ++i) {
+        Measurement m;
+        spim_restore(cpu, warm);
+        auto start = std::chrono::steady_clock::now();
+        perf.start();
+        m.guest_insts = spim_run(cpu, options.cycles, nullptr);
+        perf.stop(m.branch_misses, m.host_insts);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        m.ns_per_inst = elapsed.count() / m.guest_insts;
+        runs.push_back(m);
+    }
+    std::sort(runs.begin(), runs.end(),
+              [](const Measurement &a, const Measurement &b) { return a.ns_per_inst < b.ns_per_inst; });
+    result = runs[runs.size() / 2];
+
+    spim_snapshot_release(warm);
+    spim_destroy(cpu);
+    return true;
+}
+
+double per_inst(int64_t count, uint64_t insts) { return count < 0 ? -1 : static_cast<double>(count) / insts; }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--cycles") == 0) {
+            options.cycles = strtoull(argv[i + 1], nullptr, 10);
+        } else if (strcmp(argv[i], "--repeat") == 0) {
+            options.repeat = std::max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], "--only") == 0) {
+            options.only = argv[i + 1];
+        } else {
+            fprintf(stderr, "usage: microbench [--cycles N] [--repeat N] [--only GROUP]\n");
+            return 2;
+        }
+    }
+
+    PerfCounters perf;
+    Measurement nop;
+    if (!measure(options, GROUPS[0], perf, nop)) {
+        return 2;
+    }
+
+    printf("group\tns_per_inst\tns_per_inst_raw\tbranch_misses_per_inst\thost_insts_per_inst\n");
+    for (const Group &group : GROUPS) {
+        if (!options.only.empty() && options.only != group.name) {
+            continue;
+        }
+        Measurement m;
+        if (!measure(options, group, perf, m)) {
+            return 2;
+        }
+
+        /* Per loop iteration: UNROLL units plus `j loop` and its delay slot, costed as nops. */
+        double units = UNROLL * group.insts_per_unit;
+        double iteration_ns = m.ns_per_inst * (units + 2);
+        double ns = (iteration_ns - 2 * nop.ns_per_inst) / units;
+        printf("%s\t%.2f\t%.2f\t%.4f\t%.1f\n", group.name, ns, m.ns_per_inst, per_inst(m.branch_misses, m.guest_insts),
+               per_inst(m.host_insts, m.guest_insts));
+    }
+    return 0;
+}
@@ -0,0 +1,25 @@
+# ALU-heavy: integer arithmetic, logic, shifts and multiplies in a tight loop.
+# Every branch is followed by a nop so the loop means the same with or without delayed branches.
+
+        .text
+        .globl main
+main:
+        li      $t0, 0
+        li      $t1, 12345
+        li      $t2, 0x5bd1e995
+
+loop:
+        addu    $t3, $t1, $t2
+        xor     $t1, $t1, $t3
+        sll     $t4, $t3, 5
+        srl     $t5, $t3, 3
+        or      $t4, $t4, $t5
+        subu    $t2, $t4, $t1
+        and     $t6, $t2, $t3
+        mult    $t6, $t1
+        mflo    $t7
+        slt     $t8, $t7, $t6
+        addu    $t1, $t1, $t8
+        addiu   $t0, $t0, 1
+        j       loop
+        nop
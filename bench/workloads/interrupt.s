@@ -0,0 +1,17 @@
+# Interrupt-driven: enables transmitter interrupts and computes in the foreground while the
+# handler in interrupt_handler.s keeps the transmitter busy, like a bot servicing device events.
+
+        .text
+        .globl main
+main:
+        lui     $t0, 0xffff
+        li      $t1, 2                  # Transmitter interrupt enable
+        sw      $t1, 8($t0)
+        li      $t2, 0
+
+loop:
+        addiu   $t2, $t2, 1
+        sll     $t3, $t2, 2
+        xor     $t3, $t3, $t2
+        j       loop
+        nop
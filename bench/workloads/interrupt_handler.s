@@ -0,0 +1,27 @@
+# Exception file for interrupt.s: a startup routine that unmasks the transmitter interrupt and a
+# handler that answers each one by writing a character, which keeps the device raising them.
+
+        .kdata
+interrupts:
+        .word   0
+
+        .ktext  0x80000180
+        lui     $k0, 0xffff
+        li      $k1, 46                 # '.'
+        sw      $k1, 12($k0)            # Transmitter data; not ready again for a while
+        la      $k0, interrupts
+        lw      $k1, 0($k0)
+        addiu   $k1, $k1, 1
+        sw      $k1, 0($k0)
+        eret
+
+        .text
+        .globl __start
+__start:
+        mfc0    $t0, $12                # Status
+        ori     $t0, $t0, 0x0401        # Interrupt enable, hardware interrupt 0 unmasked
+        mtc0    $t0, $12
+        jal     main
+        nop
+        li      $v0, 10                 # exit
+        syscall
@@ -0,0 +1,30 @@
+# Load/store-heavy: repeated passes over a 64 KiB array mixing word, halfword and byte accesses.
+
+        .data
+        .align  2
+array:  .space  65536
+
+        .text
+        .globl main
+main:
+        la      $s0, array
+        li      $s1, 16384              # Words in array
+
+pass:
+        move    $t0, $s0
+        move    $t1, $s1
+        li      $t2, 0
+
+word:
+        lw      $t3, 0($t0)
+        addu    $t2, $t2, $t3
+        sw      $t2, 0($t0)
+        lbu     $t4, 1($t0)
+        sh      $t4, 2($t0)
+        addiu   $t0, $t0, 4
+        addiu   $t1, $t1, -1
+        bnez    $t1, word
+        nop
+
+        j       pass
+        nop
@@ -0,0 +1,17 @@
+# Syscall-heavy: prints a counter and a newline through the console syscalls forever.
+
+        .text
+        .globl main
+main:
+        li      $t0, 0
+
+loop:
+        move    $a0, $t0
+        li      $v0, 1                  # print_int
+        syscall
+        li      $a0, 10
+        li      $v0, 11                 # print_char
+        syscall
+        addiu   $t0, $t0, 1
+        j       loop
+        nop
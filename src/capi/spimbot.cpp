@@ -0,0 +1,386 @@
+#include "spimbot.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "controllers/mips/config.h"
+#include "controllers/mips/cpu.h"
+#include "controllers/mips/host_profile.h"
+#include "controllers/mips/program_image.h"
+#include "controllers/mips/spim.h"
+
+struct spim_cpu {
+    CPUConfig config;
+    std::unique_ptr<CPU> cpu;
+};
+
+struct spim_image {
+    std::shared_ptr<const program_image_t> image;
+};
+
+struct spim_snap {
+    CPU::Snapshot snapshot;
+    const spim_cpu *source;
+};
+
+namespace {
+
+constexpr uint32_t DEFAULT_PROFILE_PERIOD = 1000;
+
+/* Counts into EXECUTED rather than returning it, so the count survives an exception. */
+template <bool PROFILED>
+void run_budget(spim_cpu *cpu, uint64_t budget, int *halted, uint64_t &executed) {
+    while (executed < budget) {
+        ++executed;
+        if (PROFILED) {
+            cpu->cpu->profile_step();
+        }
+        if (!cpu->cpu->run_spim(false)) {
+            if (halted != nullptr) {
+                *halted = 1;
+            }
+            break;
+        }
+    }
+}
+
+/* snprintf-style: as much of TEXT as fits in SIZE bytes with a NUL, and TEXT's full length. */
+size_t copy_out(const std::string &text, char *buffer, size_t size) {
+    if (buffer != nullptr && size > 0) {
+        size_t n = std::min(text.size(), size - 1);
+        memcpy(buffer, text.data(), n);
+        buffer[n] = '\0';
+    }
+    return text.size();
+}
+
+}  // namespace
+
+void spim_default_options(spim_options *options) {
+    if (options == nullptr) {
+        return;
+    }
+    *options = spim_options{};
+    options->api_version = SPIM_API_VERSION;
+    options->accept_pseudo_insts = 1;
+    options->mapped_io = 1;
+}
+
+spim_cpu *spim_create(const spim_options *options) {
+    if (options == nullptr || options->api_version != SPIM_API_VERSION) {
+        return nullptr;
+    }
+
+    CPUConfig config = {};
+    config.memory.text_size = TEXT_SIZE;
+    config.memory.data_size = DATA_SIZE;
+    config.memory.stack_size = STACK_SIZE;
+    config.memory.k_text_size = K_TEXT_SIZE;
+    config.memory.k_data_size = K_DATA_SIZE;
+    config.memory.data_limit = DATA_LIMIT;
+    config.memory.stack_limit = STACK_LIMIT;
+    config.memory.k_data_limit = K_DATA_LIMIT;
+    config.bare_machine = options->bare_machine != 0;
+    config.accept_pseudo_insts = options->accept_pseudo_insts != 0;
+    config.delayed_branches = options->delayed_branches != 0;
+    config.delayed_loads = options->delayed_loads != 0;
+    config.mapped_io = options->mapped_io != 0;
+    config.quiet = true;
+    config.exception_file_name = const_cast<char *>(options->exception_file);
+    switch (options->profile_mode) {
+        case SPIM_PROFILE_SAMPLED:
+            config.profile_mode = ProfileMode::SAMPLED;
+            break;
+        case SPIM_PROFILE_EXACT:
+            config.profile_mode = ProfileMode::EXACT;
+            break;
+        default:
+            config.profile_mode = ProfileMode::OFF;
+            break;
+    }
+    config.profile_period = options->profile_period != 0 ? options->profile_period : DEFAULT_PROFILE_PERIOD;
+    config.profile_calls = options->profile_calls != 0;
+    config.collect_stats = options->collect_stats != 0;
+
+    /* Nothing may unwind into a C caller. */
+    try {
+        auto handle = std::make_unique<spim_cpu>(spim_cpu{config, nullptr});
+        handle->cpu = std::make_unique<CPU>(handle->config);
+        return handle.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void spim_destroy(spim_cpu *cpu) { delete cpu; }
+
+spim_status spim_load_asm(spim_cpu *cpu, const char *path) {
+    if (cpu == nullptr || path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        if (!cpu->cpu->read_assembly_file(path, path)) {
+            return SPIM_ERR_ASSEMBLY;
+        }
+    } catch (...) {
+        return SPIM_ERR_ASSEMBLY;
+    }
+
+    mem_addr start = cpu->cpu->starting_address();
+    if (start == 0) {
+        return SPIM_ERR_UNDEFINED;
+    }
+    cpu->cpu->set_pc(start);
+    return SPIM_OK;
+}
+
+spim_image *spim_share_image(spim_cpu *cpu) {
+    if (cpu == nullptr) {
+        return nullptr;
+    }
+    try {
+        auto image = cpu->cpu->share_program_image();
+        if (image == nullptr) {
+            return nullptr;
+        }
+        return new spim_image{std::move(image)};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+spim_status spim_load_image(spim_cpu *cpu, const spim_image *image) {
+    if (cpu == nullptr || image == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        cpu->cpu->load_program_image(image->image);
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+
+    mem_addr start = cpu->cpu->starting_address();
+    if (start == 0) {
+        return SPIM_ERR_UNDEFINED;
+    }
+    cpu->cpu->set_pc(start);
+    return SPIM_OK;
+}
+
+void spim_image_release(spim_image *image) { delete image; }
+
+uint64_t spim_run(spim_cpu *cpu, uint64_t budget, int *halted) {
+    if (halted != nullptr) {
+        *halted = 0;
+    }
+    if (cpu == nullptr) {
+        return 0;
+    }
+    /* Separate loops so that unprofiled runs do no per-instruction profiling work at all. */
+    uint64_t executed = 0;
+    try {
+        if (cpu->cpu->profiling_steps()) {
+            run_budget<true>(cpu, budget, halted, executed);
+        } else {
+            run_budget<false>(cpu, budget, halted, executed);
+        }
+    } catch (...) {
+        if (halted != nullptr) {
+            *halted = 1;
+        }
+    }
+    return executed;
+}
+
+spim_status spim_dump_profile(const spim_cpu *cpu, const char *prof_path, const char *text_path) {
+    if (cpu == nullptr || prof_path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->dump_profile(prof_path, text_path != nullptr ? text_path : "") ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_dump_call_profile(spim_cpu *cpu, const char *folded_path, const char *summary_path) {
+    if (cpu == nullptr || folded_path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->dump_call_profile(folded_path, summary_path != nullptr ? summary_path : "")
+                   ? SPIM_OK
+                   : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_dump_stats(spim_cpu *cpu, const char *path) {
+    if (cpu == nullptr || path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->dump_stats(path) ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_host_profile_start(uint32_t hz) { return host_profile::start(hz) ? SPIM_OK : SPIM_ERR_ARGUMENT; }
+
+spim_status spim_host_profile_stop(const char *path, const spim_cpu *cpu) {
+    host_profile::stop();
+    if (path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    bool ok = true;
+    try {
+        host_profile::write(file, cpu != nullptr ? cpu->cpu->code_symbols() : symbolizer_t());
+    } catch (...) {
+        ok = false;
+    }
+    return fclose(file) == 0 && ok ? SPIM_OK : SPIM_ERR_ARGUMENT;
+}
+
+spim_status spim_trace_memory(spim_cpu *cpu, const char *path) {
+    if (cpu == nullptr || path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->start_mem_trace(path) ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_trace_memory_stop(spim_cpu *cpu) {
+    if (cpu == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->stop_mem_trace() ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_trace_exec(spim_cpu *cpu, const char *path) {
+    if (cpu == nullptr || path == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->start_exec_trace(path) ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+spim_status spim_trace_exec_stop(spim_cpu *cpu) {
+    if (cpu == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        return cpu->cpu->stop_exec_trace() ? SPIM_OK : SPIM_ERR_ARGUMENT;
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+}
+
+size_t spim_disassemble(spim_cpu *cpu, uint32_t addr, char *buffer, size_t size) {
+    if (cpu == nullptr) {
+        return 0;
+    }
+    try {
+        std::string text = cpu->cpu->inst_to_string(addr);
+        while (!text.empty() && text.back() == '\n') {
+            text.pop_back();
+        }
+        return copy_out(text, buffer, size);
+    } catch (...) {
+        return copy_out("", buffer, size);
+    }
+}
+
+size_t spim_symbolize(const spim_cpu *cpu, uint32_t addr, char *buffer, size_t size) {
+    if (cpu == nullptr) {
+        return 0;
+    }
+    try {
+        return copy_out(cpu->cpu->code_symbols().name(addr), buffer, size);
+    } catch (...) {
+        return copy_out("", buffer, size);
+    }
+}
+
+spim_status spim_read_regs(const spim_cpu *cpu, spim_regs *regs) {
+    if (cpu == nullptr || regs == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+
+    const reg_image_t &reg_image = cpu->cpu->register_image();
+    for (size_t i = 0; i < R_LENGTH; ++i) {
+        regs->r[i] = reg_image.R[i];
+    }
+    regs->hi = reg_image.HI;
+    regs->lo = reg_image.LO;
+    regs->pc = reg_image.PC;
+    for (size_t i = 0; i < FPR_LENGTH; ++i) {
+        regs->fpr[i] = reg_image.FPR[i];
+    }
+    regs->cp0_status = reg_image.CPR[0][CP0_Status_Reg];
+    regs->cp0_cause = reg_image.CPR[0][CP0_Cause_Reg];
+    regs->cp0_epc = reg_image.CPR[0][CP0_EPC_Reg];
+    regs->cp0_badvaddr = reg_image.CPR[0][CP0_BadVAddr_Reg];
+    return SPIM_OK;
+}
+
+spim_status spim_read_mem(const spim_cpu *cpu, uint32_t addr, void *buffer, size_t size) {
+    if (cpu == nullptr || (buffer == nullptr && size != 0)) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    const void *bytes = cpu->cpu->memory_image().data_reference(addr, size);
+    if (bytes == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    memcpy(buffer, bytes, size);
+    return SPIM_OK;
+}
+
+spim_snap *spim_snapshot(spim_cpu *cpu) {
+    if (cpu == nullptr) {
+        return nullptr;
+    }
+    try {
+        return new spim_snap{cpu->cpu->snapshot(), cpu};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+spim_status spim_restore(spim_cpu *cpu, const spim_snap *snap) {
+    if (cpu == nullptr || snap == nullptr) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    /* Without an image, the snapshot's instructions point into its own CPU's symbol table. */
+    if (snap->snapshot.program_image == nullptr && snap->source != cpu) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    try {
+        cpu->cpu->restore(snap->snapshot);
+    } catch (...) {
+        return SPIM_ERR_ARGUMENT;
+    }
+    return SPIM_OK;
+}
+
+void spim_snapshot_release(spim_snap *snap) { delete snap; }
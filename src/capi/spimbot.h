@@ -0,0 +1,187 @@
+/**
+ * Embeddable C interface to the Spimbot MIPS core.
+ *
+ * Lets a long-lived host process (tournament orchestration, analytics) create CPUs, load
+ * programs once and share them, run for a cycle budget, and read results out of memory instead
+ * of spawning a process per match and parsing its stdout. Does not depend on Qt.
+ *
+ * All functions are safe to call concurrently on different spim_cpu handles. A single handle
+ * must not be used from two threads at once. Images and snapshots are immutable once created;
+ * images may be used with any number of CPUs.
+ */
+
+#ifndef SPIMBOT_CAPI_H_
+#define SPIMBOT_CAPI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define SPIM_API __declspec(dllexport)
+#else
+#define SPIM_API __attribute__((visibility("default")))
+#endif
+
+/* Bumped whenever a struct below changes layout. */
+#define SPIM_API_VERSION 2
+
+typedef struct spim_cpu spim_cpu;
+typedef struct spim_image spim_image;
+typedef struct spim_snap spim_snap;
+
+typedef enum {
+    SPIM_OK = 0,
+    SPIM_ERR_ARGUMENT = -1,   /* Null handle or bad argument */
+    SPIM_ERR_ASSEMBLY = -2,   /* The program did not assemble */
+    SPIM_ERR_UNDEFINED = -3,  /* The program refers to undefined symbols */
+} spim_status;
+
+typedef enum {
+    SPIM_PROFILE_OFF = 0,     /* No profiling and no profiling overhead (the default) */
+    SPIM_PROFILE_SAMPLED = 1, /* Record the PC every profile_period instructions */
+    SPIM_PROFILE_EXACT = 2,   /* Count every branch, jump and exception edge */
+} spim_profile_mode;
+
+typedef struct {
+    uint32_t api_version; /* Must be SPIM_API_VERSION */
+    int bare_machine;
+    int accept_pseudo_insts;
+    int delayed_branches;
+    int delayed_loads;
+    int mapped_io;
+    const char *exception_file; /* NULL for the built-in handler */
+    int profile_mode;           /* A spim_profile_mode */
+    uint32_t profile_period;    /* Instructions between samples; 0 means 1000 */
+    int profile_calls;          /* Attribute instructions to guest functions */
+    int collect_stats;          /* Count opcodes, branch outcomes and loads/stores by segment */
+} spim_options;
+
+typedef struct {
+    int32_t r[32];
+    int32_t hi, lo;
+    uint32_t pc;
+    double fpr[16];
+    int32_t cp0_status, cp0_cause, cp0_epc, cp0_badvaddr;
+} spim_regs;
+
+/* Fill OPTIONS with the defaults used by QtSpimbot. */
+SPIM_API void spim_default_options(spim_options *options);
+
+/* Create a CPU; returns NULL if OPTIONS is NULL or from a different API version, or if the CPU
+   could not be allocated. */
+SPIM_API spim_cpu *spim_create(const spim_options *options);
+SPIM_API void spim_destroy(spim_cpu *cpu);
+
+/* Assemble the file at PATH into CPU and point the PC at its entry point. */
+SPIM_API spim_status spim_load_asm(spim_cpu *cpu, const char *path);
+
+/**
+ * Freeze the program loaded into CPU into an image that other CPUs can load without
+ * re-assembling. The caller owns the returned handle; NULL on failure.
+ */
+SPIM_API spim_image *spim_share_image(spim_cpu *cpu);
+
+/* Load IMAGE into CPU and point the PC at its entry point; SPIM_ERR_UNDEFINED if it has none. */
+SPIM_API spim_status spim_load_image(spim_cpu *cpu, const spim_image *image);
+SPIM_API void spim_image_release(spim_image *image);
+
+/**
+ * Execute up to BUDGET instructions. Returns the number executed; *HALTED (if not NULL) is set
+ * to 1 when the program stopped before using up its budget, or the emulator failed (ran out of
+ * memory, for example).
+ */
+SPIM_API uint64_t spim_run(spim_cpu *cpu, uint64_t budget, int *halted);
+
+/**
+ * Write CPU's profile to PROF_PATH in its binary format and, unless TEXT_PATH is NULL, as text.
+ * SPIM_ERR_ARGUMENT if the CPU was created without profiling or a file could not be written.
+ */
+SPIM_API spim_status spim_dump_profile(const spim_cpu *cpu, const char *prof_path, const char *text_path);
+
+/**
+ * Write CPU's function profile to FOLDED_PATH as folded stacks (for flamegraph.pl) and, unless
+ * SUMMARY_PATH is NULL, a tab-separated per-function summary to SUMMARY_PATH. SPIM_ERR_ARGUMENT
+ * if the CPU was created without profile_calls or a file could not be written.
+ */
+SPIM_API spim_status spim_dump_call_profile(spim_cpu *cpu, const char *folded_path, const char *summary_path);
+
+/**
+ * Write CPU's execution statistics to PATH as JSON: instructions per opcode, loads and stores
+ * per memory segment, and taken/not-taken counts per branch site. SPIM_ERR_ARGUMENT if the CPU
+ * was created without collect_stats or the file could not be written.
+ */
+SPIM_API spim_status spim_dump_stats(spim_cpu *cpu, const char *path);
+
+/**
+ * Sample the whole host process HZ times per second of CPU time (SIGPROF), recording what the
+ * interpreter was doing (dispatch, memory access, syscall, exception, or outside it) and the
+ * guest PC. SPIM_ERR_ARGUMENT if sampling is already running or unsupported on this platform.
+ */
+SPIM_API spim_status spim_host_profile_start(uint32_t hz);
+
+/**
+ * Stop sampling and write the joint host phase / guest PC histogram to PATH, tab-separated.
+ * Guest PCs are named after the labels of CPU's program if CPU is not NULL.
+ */
+SPIM_API spim_status spim_host_profile_stop(const char *path, const spim_cpu *cpu);
+
+/**
+ * Append every data load and store CPU makes (cycle, PC, address, size, value) to PATH in
+ * delta-encoded binary form until spim_trace_memory_stop. A background thread writes the file,
+ * so spim_run never waits on it; accesses it cannot keep up with are dropped, and a gap record
+ * (cycle and count) marks where. SPIM_ERR_ARGUMENT if a trace is already running, profiling was
+ * compiled out or PATH cannot be created.
+ */
+SPIM_API spim_status spim_trace_memory(spim_cpu *cpu, const char *path);
+
+/* Finish CPU's memory trace. SPIM_ERR_ARGUMENT if none was running or it could not be written. */
+SPIM_API spim_status spim_trace_memory_stop(spim_cpu *cpu);
+
+/**
+ * Record every instruction CPU executes, and the general registers, HI and LO it writes (not FP
+ * or CP0 registers), to PATH in compact binary form until spim_trace_exec_stop; tools/trace_dis
+ * turns the file back into a listing. Costs a register comparison and a few bytes per
+ * instruction, where the text trace of QtSpimbot's display mode formats every instruction.
+ * SPIM_ERR_ARGUMENT if a trace is already running, profiling was compiled out or PATH cannot be
+ * created.
+ */
+SPIM_API spim_status spim_trace_exec(spim_cpu *cpu, const char *path);
+
+/* Finish CPU's instruction trace. SPIM_ERR_ARGUMENT if none was running or it could not be
+   written. */
+SPIM_API spim_status spim_trace_exec_stop(spim_cpu *cpu);
+
+/**
+ * Write the instruction at ADDR as text ("[0x00400000]\t0x23bdfffc  addi $29, $29, -4 ...") or
+ * the closest label at or below ADDR ("main+0x1c") into BUFFER, truncated to SIZE bytes including
+ * the terminating NUL. Both return the full length, like snprintf.
+ */
+SPIM_API size_t spim_disassemble(spim_cpu *cpu, uint32_t addr, char *buffer, size_t size);
+SPIM_API size_t spim_symbolize(const spim_cpu *cpu, uint32_t addr, char *buffer, size_t size);
+
+SPIM_API spim_status spim_read_regs(const spim_cpu *cpu, spim_regs *regs);
+
+/**
+ * Copy SIZE bytes of CPU's memory starting at ADDR into BUFFER, in the guest's byte order.
+ * SPIM_ERR_ARGUMENT unless the whole range lies in the data, stack or kernel data segment.
+ */
+SPIM_API spim_status spim_read_mem(const spim_cpu *cpu, uint32_t addr, void *buffer, size_t size);
+
+/**
+ * Capture CPU's state. The snapshot can be restored into CPU and, if CPU's program came from or
+ * was frozen into an image, into any CPU loaded from that image; spim_restore returns
+ * SPIM_ERR_ARGUMENT otherwise. Taking a snapshot does not change CPU.
+ */
+SPIM_API spim_snap *spim_snapshot(spim_cpu *cpu);
+SPIM_API spim_status spim_restore(spim_cpu *cpu, const spim_snap *snap);
+SPIM_API void spim_snapshot_release(spim_snap *snap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
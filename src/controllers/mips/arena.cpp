@@ -0,0 +1,21 @@
+#include "arena.h"
+
+#include <stdint.h>
+
+void *asm_arena_t::allocate(size_t size, size_t align) {
+    uintptr_t p = (reinterpret_cast<uintptr_t>(this->next) + align - 1) & ~(uintptr_t)(align - 1);
+
+    if (this->next == nullptr || p + size > reinterpret_cast<uintptr_t>(this->limit)) {
+        /* Oversized requests get a block of their own; new[] aligns for any fundamental type. */
+        size_t n = size + align > BLOCK_SIZE ? size + align : BLOCK_SIZE;
+        this->blocks.emplace_back(new char[n]);
+        this->next = this->blocks.back().get();
+        this->limit = this->next + n;
+        p = (reinterpret_cast<uintptr_t>(this->next) + align - 1) & ~(uintptr_t)(align - 1);
+    }
+
+    char *result = reinterpret_cast<char *>(p);
+    this->used += (result + size) - this->next;
+    this->next = result + size;
+    return result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Bump allocator for the objects the assembler produces: instructions and their immediate and
+ * address expressions.
+ *
+ * Allocation is a pointer increment within a block, and nothing is ever freed individually:
+ * the whole arena is released at once when it is destroyed, which happens when the text
+ * segment owning it is reset or goes away. No destructors run, so only trivially destructible
+ * types may be allocated.
+ */
+class asm_arena_t {
+   public:
+    asm_arena_t() = default;
+
+    asm_arena_t(const asm_arena_t &) = delete;
+    asm_arena_t &operator=(const asm_arena_t &) = delete;
+
+    /* Moving keeps every allocation where it is; the source is left empty. */
+    asm_arena_t(asm_arena_t &&other) noexcept
+        : blocks(std::move(other.blocks)),
+          next(std::exchange(other.next, nullptr)),
+          limit(std::exchange(other.limit, nullptr)),
+          used(std::exchange(other.used, 0)) {}
+
+    asm_arena_t &operator=(asm_arena_t &&other) noexcept {
+        if (this != &other) {
+            this->blocks = std::move(other.blocks);
+            other.blocks.clear();
+            this->next = std::exchange(other.next, nullptr);
+            this->limit = std::exchange(other.limit, nullptr);
+            this->used = std::exchange(other.used, 0);
+        }
+        return *this;
+    }
+
+    /* Construct a T in the arena. */
+    template <typename T, typename... Args>
+    T *make(Args &&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena objects are released without running destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /* Uninitialized storage for SIZE bytes aligned to ALIGN (a power of two). */
+    void *allocate(size_t size, size_t align);
+
+    /* Total bytes handed out, including alignment padding. */
+    size_t bytes_used() const { return used; }
+
+   private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *next = nullptr;
+    char *limit = nullptr;
+    size_t used = 0;
+};
+
+#endif
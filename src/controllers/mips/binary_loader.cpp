@@ -0,0 +1,306 @@
+#include "binary_loader.h"
+
+#include <elf.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "inst.h"
+#include "mem.h"
+#include "spim.h"
+#include "sym-tbl.h"
+
+namespace {
+
+/* A read-only mapping of a whole file. */
+struct mapped_file {
+    std::shared_ptr<const void> mapping;
+    const char *data = nullptr;
+    size_t size = 0;
+};
+
+bool map_file(const std::string &path, mapped_file &file) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return true; /* Nothing to load; empty files cannot be mapped */
+    }
+
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    file.mapping = std::shared_ptr<const void>(addr, [size](const void *p) {
+        munmap(const_cast<void *>(p), size);
+    });
+    file.data = static_cast<const char *>(addr);
+    file.size = size;
+    return true;
+}
+
+/* Contents of one segment, collected before the image is built. */
+struct segment_words {
+    mem_addr bot;
+    mem_addr limit; /* First address past the region of the memory map it may occupy */
+    std::vector<int32_t> words;
+    std::vector<bool> present; /* Text only: which words were loaded (the rest stay nullptr) */
+
+    /* SIZE is the most the segment may hold (MemConfig); END is where the next region starts. */
+    segment_words(mem_addr bot, int32_t size, mem_addr end)
+        : bot(bot), limit(bot + std::min<uint64_t>(std::max<int32_t>(size, 0), end - bot)) {}
+
+    /* Copy FILESZ bytes to VADDR and reserve zeroes up to MEMSZ. False if it does not fit. */
+    bool place(mem_addr vaddr, const char *bytes, size_t filesz, size_t memsz) {
+        if (vaddr % BYTES_PER_WORD != 0 || vaddr < this->bot || vaddr >= this->limit ||
+            memsz < filesz || memsz > this->limit - vaddr) {
+            return false;
+        }
+
+        size_t first = (vaddr - this->bot) / BYTES_PER_WORD;
+        size_t end = first + (memsz + BYTES_PER_WORD - 1) / BYTES_PER_WORD;
+        if (this->words.size() < end) {
+            this->words.resize(end, 0);
+            this->present.resize(end, false);
+        }
+
+        if (filesz != 0) {
+            memcpy(this->words.data() + first, bytes, filesz);
+        }
+        std::fill(this->present.begin() + first, this->present.begin() + end, true);
+        return true;
+    }
+
+    /* Index one past the last loaded word. */
+    size_t used() const { return this->words.size(); }
+};
+
+/* Decode the loaded words of SEG into a text segment of at least MIN_SLOTS slots. */
+void build_text(const segment_words &seg, size_t min_slots, text_segment_t &text, mem_addr &top) {
+    size_t slots = std::max(min_slots, seg.used());
+    text.reset(slots);
+    top = seg.bot + slots * BYTES_PER_WORD;
+
+    std::vector<instruction *> decoded;
+    size_t i = 0;
+    while (i < seg.used()) {
+        if (!seg.present[i]) {
+            ++i;
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < seg.used() && seg.present[end]) {
+            ++end;
+        }
+        decoded.resize(end - i);
+        instruction::inst_decode_block(text.arena(), seg.words.data() + i, end - i, decoded.data());
+        for (size_t j = i; j < end; ++j) {
+            text.set(j, decoded[j - i]);
+        }
+        i = end;
+    }
+}
+
+void build_data(const segment_words &seg, size_t min_words, std::vector<mem_word> &data,
+                mem_addr &top) {
+    data.assign(std::max(min_words, seg.used()), 0);
+    std::copy(seg.words.begin(), seg.words.end(), data.begin());
+    top = seg.bot + data.size() * BYTES_PER_WORD;
+}
+
+/* Everything loaded so far, in SPIM's memory map. Text segments cannot grow at run time, so
+   they are capped at their configured size; data segments at the limit they may grow to. */
+struct image_builder {
+    const MemConfig &memory;
+    segment_words text{TEXT_BOT, memory.text_size, DATA_BOT};
+    segment_words data{DATA_BOT, memory.data_limit, STACK_TOP};
+    segment_words k_text{K_TEXT_BOT, memory.k_text_size, K_DATA_BOT};
+    segment_words k_data{K_DATA_BOT, memory.k_data_limit, 0xffff0000};
+    std::shared_ptr<SymbolTable> symbols = std::make_shared<SymbolTable>();
+    mem_addr gp_midpoint = DATA_BOT + 32 * K;
+
+    explicit image_builder(const MemConfig &memory) : memory(memory) {}
+
+    /* The segment a loadable chunk at VADDR belongs to, or nullptr if SPIM has no such memory.
+       Read-only data linked into the text range (headers, .rodata) is decoded along with the
+       code; loads from text addresses read back the original encodings. */
+    segment_words *segment_for(mem_addr vaddr) {
+        if (vaddr >= K_DATA_BOT) {
+            return &this->k_data;
+        } else if (vaddr >= K_TEXT_BOT) {
+            return &this->k_text;
+        } else if (vaddr >= DATA_BOT) {
+            return &this->data;
+        } else if (vaddr >= TEXT_BOT) {
+            return &this->text;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<const program_image_t> finish() {
+        auto image = std::make_shared<program_image_t>();
+
+        build_text(this->text, this->memory.text_size / BYTES_PER_WORD, image->text_seg, image->text_top);
+        build_text(this->k_text, this->memory.k_text_size / BYTES_PER_WORD, image->k_text_seg,
+                   image->k_text_top);
+        build_data(this->data, this->memory.data_size / BYTES_PER_WORD, image->data_seg, image->data_top);
+        build_data(this->k_data, this->memory.k_data_size / BYTES_PER_WORD, image->k_data_seg,
+                   image->k_data_top);
+
+        image->gp_midpoint = this->gp_midpoint;
+        image->next_text_pc = TEXT_BOT + this->text.used() * BYTES_PER_WORD;
+        image->next_k_text_pc = K_TEXT_BOT + this->k_text.used() * BYTES_PER_WORD;
+        image->next_data_pc = DATA_BOT + this->data.used() * BYTES_PER_WORD;
+        image->next_k_data_pc = K_DATA_BOT + this->k_data.used() * BYTES_PER_WORD;
+        image->next_gp_item_addr = DATA_BOT;
+        image->symbol_table = std::move(this->symbols);
+        return image;
+    }
+};
+
+bool load_raw_segment(const std::string &path, segment_words &seg) {
+    if (path.empty()) {
+        return true;
+    }
+    mapped_file file;
+    if (!map_file(path, file) || file.size % BYTES_PER_WORD != 0) {
+        return false;
+    }
+    return seg.place(seg.bot, file.data, file.size, file.size);
+}
+
+/* Bounds-checked view of a POD at OFFSET in FILE. */
+template <typename T>
+const T *at(const mapped_file &file, size_t offset, size_t count = 1) {
+    if (offset > file.size || count > (file.size - offset) / sizeof(T)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T *>(file.data + offset);
+}
+
+bool load_elf_symbols(const mapped_file &file, const Elf32_Ehdr &ehdr, image_builder &builder) {
+    if (ehdr.e_shoff == 0 || ehdr.e_shnum == 0) {
+        return true; /* Stripped */
+    }
+    if (ehdr.e_shentsize != sizeof(Elf32_Shdr)) {
+        return false;
+    }
+    const Elf32_Shdr *sections = at<Elf32_Shdr>(file, ehdr.e_shoff, ehdr.e_shnum);
+    if (sections == nullptr) {
+        return false;
+    }
+
+    for (size_t s = 0; s < ehdr.e_shnum; ++s) {
+        const Elf32_Shdr &symtab = sections[s];
+        if (symtab.sh_type != SHT_SYMTAB || symtab.sh_link >= ehdr.e_shnum) {
+            continue;
+        }
+        const Elf32_Shdr &strtab = sections[symtab.sh_link];
+        const Elf32_Sym *syms =
+            at<Elf32_Sym>(file, symtab.sh_offset, symtab.sh_size / sizeof(Elf32_Sym));
+        const char *strings = at<char>(file, strtab.sh_offset, strtab.sh_size);
+        if (syms == nullptr || strings == nullptr || strtab.sh_size == 0 ||
+            strings[strtab.sh_size - 1] != '\0') {
+            return false;
+        }
+
+        for (size_t i = 0; i < symtab.sh_size / sizeof(Elf32_Sym); ++i) {
+            const Elf32_Sym &sym = syms[i];
+            int type = ELF32_ST_TYPE(sym.st_info);
+            int bind = ELF32_ST_BIND(sym.st_info);
+            if (sym.st_name == 0 || sym.st_name >= strtab.sh_size || sym.st_shndx == SHN_UNDEF ||
+                (type != STT_NOTYPE && type != STT_OBJECT && type != STT_FUNC)) {
+                continue;
+            }
+
+            const char *name = strings + sym.st_name;
+            if (strcmp(name, "_gp") == 0) {
+                builder.gp_midpoint = sym.st_value;
+            }
+
+            label *l = builder.symbols->lookup_label(name);
+            l->addr = sym.st_value;
+            l->global_flag = bind == STB_GLOBAL || bind == STB_WEAK;
+            l->const_flag = sym.st_shndx == SHN_ABS;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+std::shared_ptr<const program_image_t> BinaryLoader::load_raw(const raw_paths &paths, const MemConfig &memory) {
+    image_builder builder(memory);
+
+    if (!load_raw_segment(paths.text, builder.text) ||
+        !load_raw_segment(paths.data, builder.data) ||
+        !load_raw_segment(paths.k_text, builder.k_text) ||
+        !load_raw_segment(paths.k_data, builder.k_data)) {
+        return nullptr;
+    }
+
+    label *start = builder.symbols->lookup_label(DEFAULT_RUN_LOCATION);
+    start->addr = TEXT_BOT;
+    start->global_flag = true;
+    return builder.finish();
+}
+
+std::shared_ptr<const program_image_t> BinaryLoader::load_elf(const std::string &path, const MemConfig &memory) {
+    mapped_file file;
+    if (!map_file(path, file)) {
+        return nullptr;
+    }
+
+    const Elf32_Ehdr *ehdr = at<Elf32_Ehdr>(file, 0);
+    if (ehdr == nullptr || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr->e_ident[EI_CLASS] != ELFCLASS32 || ehdr->e_ident[EI_DATA] != ELFDATA2LSB ||
+        ehdr->e_type != ET_EXEC || ehdr->e_machine != EM_MIPS ||
+        ehdr->e_phentsize != sizeof(Elf32_Phdr)) {
+        return nullptr;
+    }
+
+    const Elf32_Phdr *phdrs = at<Elf32_Phdr>(file, ehdr->e_phoff, ehdr->e_phnum);
+    if (phdrs == nullptr) {
+        return nullptr;
+    }
+
+    image_builder builder(memory);
+    for (size_t i = 0; i < ehdr->e_phnum; ++i) {
+        const Elf32_Phdr &ph = phdrs[i];
+        if (ph.p_type != PT_LOAD || ph.p_memsz == 0) {
+            continue;
+        }
+        const char *bytes = at<char>(file, ph.p_offset, ph.p_filesz);
+        segment_words *seg = builder.segment_for(ph.p_vaddr);
+        if (bytes == nullptr || seg == nullptr ||
+            !seg->place(ph.p_vaddr, bytes, ph.p_filesz, ph.p_memsz)) {
+            return nullptr;
+        }
+    }
+
+    if (!load_elf_symbols(file, *ehdr, builder)) {
+        return nullptr;
+    }
+
+    label *start = builder.symbols->lookup_label(DEFAULT_RUN_LOCATION);
+    start->addr = ehdr->e_entry;
+    start->global_flag = true;
+    return builder.finish();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef BINARY_LOADER_H
+#define BINARY_LOADER_H
+
+#include <memory>
+#include <string>
+
+#include "config.h"
+#include "program_image.h"
+
+/**
+ * Build program images straight from machine code, skipping the parser and assembler.
+ *
+ * Machine-generated bots (big lookup tables) and teams using a cross-compiler can hand over
+ * binaries instead of .s files. The result is an ordinary program_image_t, so it is shared and
+ * loaded like an assembled or cached one:
+ *
+ *     auto image = BinaryLoader::load_elf("bot.elf", config.memory);
+ *     if (image != nullptr) {
+ *         cpu.load_program_image(image);
+ *     }
+ *
+ * Words are decoded in bulk through instruction::inst_decode_block. Both formats must be
+ * little-endian, like the host. An image that needs an exception handler has to bring its own
+ * kernel text, as nothing is linked in.
+ */
+class BinaryLoader {
+   public:
+    /* Files holding raw little-endian word images; an empty path leaves that segment empty. */
+    struct raw_paths {
+        std::string text;   /* Loaded at TEXT_BOT; its first word is the entry point */
+        std::string data;   /* Loaded at DATA_BOT */
+        std::string k_text; /* Loaded at K_TEXT_BOT */
+        std::string k_data; /* Loaded at K_DATA_BOT */
+    };
+
+    /**
+     * Return the image made of PATHS, or nullptr if a file cannot be read or does not fit in
+     * MEMORY: text segments hold at most their configured size, data segments their limit.
+     */
+    static std::shared_ptr<const program_image_t> load_raw(const raw_paths &paths, const MemConfig &memory);
+
+    /**
+     * Return the image of the ELF32 MIPS executable at PATH, or nullptr if it is not one or its
+     * loadable segments fall outside SPIM's memory map or do not fit in MEMORY as for load_raw.
+     * Each PT_LOAD segment goes to the text, data, kernel text or kernel data segment whose range
+     * holds its address. Defined symbols from .symtab populate the symbol table, `_gp` (if
+     * present) sets the $gp midpoint and e_entry becomes `__start`.
+     */
+    static std::shared_ptr<const program_image_t> load_elf(const std::string &path, const MemConfig &memory);
+};
+
+#endif
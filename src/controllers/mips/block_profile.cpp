@@ -0,0 +1,246 @@
+#include "block_profile.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "util/hash.h"
+
+namespace {
+
+constexpr char PROFILE_MAGIC[4] = {'S', 'P', 'B', 'P'};
+constexpr uint32_t PROFILE_VERSION = 1;
+constexpr uint32_t FLAG_DELAYED_BRANCHES = 0x1;
+
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t RECORD_SIZE = 20; /* from, to, kind (u32 each), count (u64) */
+
+void put32(std::vector<unsigned char> &out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+    }
+}
+
+void put64(std::vector<unsigned char> &out, uint64_t v) {
+    put32(out, static_cast<uint32_t>(v));
+    put32(out, static_cast<uint32_t>(v >> 32));
+}
+
+uint32_t get32(const unsigned char *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+
+uint64_t get64(const unsigned char *p) { return get32(p) | (uint64_t)get32(p + 4) << 32; }
+
+const char *kind_name(profile_edge_t::kind_t kind) {
+    switch (kind) {
+        case profile_edge_t::BRANCH:
+            return "branch";
+        case profile_edge_t::INDIRECT:
+            return "indirect";
+        case profile_edge_t::EXCEPTION:
+            return "exception";
+        case profile_edge_t::ENTRY:
+            return "entry";
+        case profile_edge_t::SAMPLE:
+            return "sample";
+    }
+    return "?";
+}
+
+}  // namespace
+
+void block_profile_t::reset(mem_addr text_bot, size_t text_words, mem_addr k_text_bot, size_t k_text_words) {
+    this->text_bot = text_bot;
+    this->k_text_bot = k_text_bot;
+    this->text_words = text_words;
+    this->k_text_words = k_text_words;
+    this->text_sites.clear();
+    this->k_text_sites.clear();
+    this->transfers.clear();
+    this->samples.clear();
+}
+
+void block_profile_t::transfer(mem_addr from, mem_addr to, profile_edge_t::kind_t kind) {
+    auto &entry = this->transfers[(uint64_t)from << 32 | to];
+    entry.first = kind;
+    ++entry.second;
+}
+
+profile_data_t block_profile_t::data(bool delayed_branches) const {
+    profile_data_t data;
+    data.delayed_branches = delayed_branches;
+    mem_addr fall_through = delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD;
+
+    auto add_sites = [&](const std::vector<site_t> &sites, mem_addr bot) {
+        for (size_t i = 0; i < sites.size(); ++i) {
+            const site_t &site = sites[i];
+            mem_addr pc = bot + i * BYTES_PER_WORD;
+            if (site.taken != 0) {
+                data.edges.push_back({pc, site.target, profile_edge_t::BRANCH, site.taken});
+            }
+            if (site.not_taken != 0) {
+                data.edges.push_back({pc, pc + fall_through, profile_edge_t::BRANCH, site.not_taken});
+            }
+        }
+    };
+    add_sites(this->text_sites, this->text_bot);
+    add_sites(this->k_text_sites, this->k_text_bot);
+
+    for (const auto &t : this->transfers) {
+        data.edges.push_back({static_cast<mem_addr>(t.first >> 32), static_cast<mem_addr>(t.first), t.second.first,
+                              t.second.second});
+    }
+    for (const auto &s : this->samples) {
+        data.edges.push_back({s.first, s.first, profile_edge_t::SAMPLE, s.second});
+    }
+
+    std::sort(data.edges.begin(), data.edges.end(), [](const profile_edge_t &a, const profile_edge_t &b) {
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+    return data;
+}
+
+bool block_profile_t::write(const std::string &path, const profile_data_t &data) {
+    std::vector<unsigned char> bytes(PROFILE_MAGIC, PROFILE_MAGIC + sizeof(PROFILE_MAGIC));
+    bytes.reserve(HEADER_SIZE + data.edges.size() * RECORD_SIZE + 4);
+    put32(bytes, PROFILE_VERSION);
+    put32(bytes, data.delayed_branches ? FLAG_DELAYED_BRANCHES : 0);
+    put32(bytes, static_cast<uint32_t>(data.edges.size()));
+    for (const profile_edge_t &edge : data.edges) {
+        put32(bytes, edge.from);
+        put32(bytes, edge.to);
+        put32(bytes, edge.kind);
+        put64(bytes, edge.count);
+    }
+    put32(bytes, util::crc32(bytes.data(), bytes.size()));
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool block_profile_t::read(const std::string &path, profile_data_t &data) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[64 * 1024];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) != 0;) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    fclose(file);
+
+    if (bytes.size() < HEADER_SIZE + 4 || memcmp(bytes.data(), PROFILE_MAGIC, sizeof(PROFILE_MAGIC)) != 0 ||
+        get32(&bytes[4]) != PROFILE_VERSION) {
+        return false;
+    }
+    size_t count = get32(&bytes[12]);
+    if (bytes.size() != HEADER_SIZE + count * RECORD_SIZE + 4 ||
+        util::crc32(bytes.data(), bytes.size() - 4) != get32(&bytes[bytes.size() - 4])) {
+        return false;
+    }
+
+    data.delayed_branches = (get32(&bytes[8]) & FLAG_DELAYED_BRANCHES) != 0;
+    data.edges.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char *record = &bytes[HEADER_SIZE + i * RECORD_SIZE];
+        data.edges[i] = {get32(record), get32(record + 4), static_cast<profile_edge_t::kind_t>(get32(record + 8)),
+                         get64(record + 12)};
+    }
+    return true;
+}
+
+void block_profile_t::render_text(FILE *out, const profile_data_t &data) {
+    const mem_addr slot = data.delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD;
+
+    /* Entries into each block start, and the first address past each block-ending transfer. */
+    std::map<mem_addr, uint64_t> incoming;
+    std::vector<mem_addr> block_ends;
+    std::vector<profile_edge_t> samples;
+    uint64_t total_samples = 0;
+    for (const profile_edge_t &edge : data.edges) {
+        if (edge.kind == profile_edge_t::SAMPLE) {
+            samples.push_back(edge);
+            total_samples += edge.count;
+            continue;
+        }
+        incoming[edge.to] += edge.count;
+        if (edge.kind == profile_edge_t::BRANCH || edge.kind == profile_edge_t::INDIRECT) {
+            block_ends.push_back(edge.from + slot);
+        }
+    }
+    std::sort(block_ends.begin(), block_ends.end());
+    block_ends.erase(std::unique(block_ends.begin(), block_ends.end()), block_ends.end());
+
+    struct block_t {
+        mem_addr start;
+        mem_addr end; /* 0 if nothing after START ends the block */
+        uint64_t entries;
+    };
+    std::vector<block_t> blocks;
+    bool falls_through = false;
+    for (auto it = incoming.begin(); it != incoming.end(); ++it) {
+        block_t block = {it->first, 0, it->second};
+        if (falls_through && !blocks.empty() && blocks.back().end == block.start) {
+            block.entries += blocks.back().entries;
+        }
+
+        /* User and kernel text are far apart; never let a block run from one into the other. */
+        auto next = std::next(it);
+        if (next != incoming.end() && ((next->first ^ block.start) & 0x80000000) != 0) {
+            next = incoming.end();
+        }
+        auto end = std::upper_bound(block_ends.begin(), block_ends.end(), block.start);
+        if (end != block_ends.end() && ((*end - BYTES_PER_WORD) ^ block.start) & 0x80000000) {
+            end = block_ends.end();
+        }
+        falls_through = false;
+        if (end != block_ends.end() && (next == incoming.end() || *end <= next->first)) {
+            block.end = *end;
+        } else if (next != incoming.end()) {
+            block.end = next->first;
+            falls_through = true;
+        }
+        blocks.push_back(block);
+    }
+
+    auto executed = [](const block_t &b) {
+        return b.end == 0 ? 0 : b.entries * ((b.end - b.start) / BYTES_PER_WORD);
+    };
+    std::stable_sort(blocks.begin(), blocks.end(),
+                     [&](const block_t &a, const block_t &b) { return executed(a) > executed(b); });
+
+    fprintf(out, "# blocks (delayed branches %s): start end entries instructions\n",
+            data.delayed_branches ? "on" : "off");
+    for (const block_t &b : blocks) {
+        if (b.end == 0) {
+            fprintf(out, "0x%08x          - %12llu            -\n", b.start, (unsigned long long)b.entries);
+        } else {
+            fprintf(out, "0x%08x 0x%08x %12llu %12llu\n", b.start, b.end, (unsigned long long)b.entries,
+                    (unsigned long long)executed(b));
+        }
+    }
+
+    fprintf(out, "\n# edges: from to kind count\n");
+    for (const profile_edge_t &edge : data.edges) {
+        if (edge.kind != profile_edge_t::SAMPLE) {
+            fprintf(out, "0x%08x 0x%08x %-9s %12llu\n", edge.from, edge.to, kind_name(edge.kind),
+                    (unsigned long long)edge.count);
+        }
+    }
+
+    if (samples.empty()) {
+        return;
+    }
+    std::stable_sort(samples.begin(), samples.end(),
+                     [](const profile_edge_t &a, const profile_edge_t &b) { return a.count > b.count; });
+    fprintf(out, "\n# samples: pc count percent\n");
+    for (const profile_edge_t &s : samples) {
+        fprintf(out, "0x%08x %12llu %6.2f%%\n", s.from, (unsigned long long)s.count, 100.0 * s.count / total_samples);
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef BLOCK_PROFILE_H
+#define BLOCK_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "spim.h"
+
+/* One control-flow edge and how often it was taken. */
+struct profile_edge_t {
+    enum kind_t : uint32_t {
+        BRANCH,    /* Branch or j/jal; TO is its target or fall-through */
+        INDIRECT,  /* jr, jalr or eret */
+        EXCEPTION, /* Exception or interrupt; FROM is the instruction it interrupted */
+        ENTRY,     /* PC set from outside the program (FROM is 0) */
+        SAMPLE,    /* Not an edge: FROM (and TO) was the PC at COUNT samples */
+    };
+
+    mem_addr from;
+    mem_addr to;
+    kind_t kind;
+    uint64_t count;
+};
+
+/* A profile as written to disk: everything needed to rebuild blocks without the program. */
+struct profile_data_t {
+    bool delayed_branches = false;
+    std::vector<profile_edge_t> edges; /* Sorted by (from, to) */
+};
+
+/**
+ * Basic-block profile of a running program.
+ *
+ * Instead of counting every instruction fetch, the interpreter reports each control transfer:
+ * branches and direct jumps bump a taken or fall-through counter in a dense per-site table,
+ * while the rarer indirect jumps, exceptions and entries go to a hash map. The cost is one
+ * increment per executed block rather than per instruction.
+ *
+ * Blocks are not tracked while running. They are derived offline from the edges (render_text):
+ * every edge target starts a block, every branch or indirect jump ends one, and a block's entry
+ * count is the sum of its incoming edges plus whatever falls into it from the block before.
+ * An exception splits the block it interrupts at the instruction it returns to.
+ */
+class block_profile_t {
+   public:
+    /* Clear all counts and cover text segments of the given number of words at TEXT_BOT and
+       K_TEXT_BOT. */
+    void reset(mem_addr text_bot, size_t text_words, mem_addr k_text_bot, size_t k_text_words);
+
+    /* The branch at PC, whose target is TARGET, was executed; TAKEN if it jumped. */
+    inline void branch(mem_addr pc, mem_addr target, bool taken) {
+        site_t *site = this->site(pc);
+        if (site != nullptr) {
+            site->target = target;
+            ++(taken ? site->taken : site->not_taken);
+        }
+    }
+
+    /* Control passed from FROM to TO through a jump whose target is not fixed. */
+    void transfer(mem_addr from, mem_addr to, profile_edge_t::kind_t kind);
+
+    /* The instruction at PC is about to run at a sample point. */
+    void sample(mem_addr pc) { ++this->samples[pc]; }
+
+    /* Call F(pc, target, taken, not_taken) for every branch or direct jump that was executed. */
+    template <typename F>
+    void for_each_branch_site(F &&f) const {
+        for (const auto &segment : {std::make_pair(&this->text_sites, this->text_bot),
+                                    std::make_pair(&this->k_text_sites, this->k_text_bot)}) {
+            const std::vector<site_t> &sites = *segment.first;
+            for (size_t i = 0; i < sites.size(); ++i) {
+                if (sites[i].taken != 0 || sites[i].not_taken != 0) {
+                    f(static_cast<mem_addr>(segment.second + i * BYTES_PER_WORD), sites[i].target, sites[i].taken,
+                      sites[i].not_taken);
+                }
+            }
+        }
+    }
+
+    /* All edges and samples with a non-zero count. Fall-through edges skip the delay slot if DELAYED_BRANCHES. */
+    profile_data_t data(bool delayed_branches) const;
+
+    /* Compact binary form: a header, fixed-size little-endian records and a CRC-32. */
+    static bool write(const std::string &path, const profile_data_t &data);
+    static bool read(const std::string &path, profile_data_t &data);
+
+    /* Blocks with their entry and instruction counts, hottest first, followed by the edges and then
+       the sampled PCs, if any. */
+    static void render_text(FILE *out, const profile_data_t &data);
+
+   private:
+    struct site_t {
+        uint64_t taken = 0;
+        uint64_t not_taken = 0;
+        mem_addr target = 0;
+    };
+
+    /* The tables are only allocated once a branch is recorded, so CPUs that never profile pay
+       nothing for them. */
+    site_t *site(mem_addr pc) {
+        if (pc >= this->text_bot && (pc - this->text_bot) / BYTES_PER_WORD < this->text_words) {
+            if (this->text_sites.empty()) {
+                this->text_sites.resize(this->text_words);
+            }
+            return &this->text_sites[(pc - this->text_bot) / BYTES_PER_WORD];
+        } else if (pc >= this->k_text_bot && (pc - this->k_text_bot) / BYTES_PER_WORD < this->k_text_words) {
+            if (this->k_text_sites.empty()) {
+                this->k_text_sites.resize(this->k_text_words);
+            }
+            return &this->k_text_sites[(pc - this->k_text_bot) / BYTES_PER_WORD];
+        }
+        return nullptr;
+    }
+
+    mem_addr text_bot = 0;
+    mem_addr k_text_bot = 0;
+    size_t text_words = 0;
+    size_t k_text_words = 0;
+    std::vector<site_t> text_sites;
+    std::vector<site_t> k_text_sites;
+
+    /* Keyed by (from << 32 | to); the kind is fixed by the instruction at FROM. */
+    std::unordered_map<uint64_t, std::pair<profile_edge_t::kind_t, uint64_t>> transfers;
+
+    std::unordered_map<mem_addr, uint64_t> samples;
+};
+
+#endif
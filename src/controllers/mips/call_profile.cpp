@@ -0,0 +1,196 @@
+#include "call_profile.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+
+void symbolizer_t::add(mem_addr addr, std::string_view name) {
+    this->labels.emplace_back(addr, std::string(name));
+    this->sorted = false;
+}
+
+void symbolizer_t::sort() const {
+    if (!this->sorted) {
+        /* Stable, so the first label added at an address names it. */
+        std::stable_sort(this->labels.begin(), this->labels.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        this->sorted = true;
+    }
+}
+
+std::string symbolizer_t::name(mem_addr addr) const {
+    this->sort();
+    auto it = std::upper_bound(this->labels.begin(), this->labels.end(), addr,
+                               [](mem_addr a, const auto &l) { return a < l.first; });
+
+    char buffer[32];
+    if (it == this->labels.begin()) {
+        snprintf(buffer, sizeof(buffer), "0x%08x", addr);
+        return buffer;
+    }
+    mem_addr base = std::prev(it)->first;
+    while (it != this->labels.begin() && std::prev(it)->first == base) {
+        --it; /* First label at BASE */
+    }
+    if (base == addr) {
+        return it->second;
+    }
+    snprintf(buffer, sizeof(buffer), "+0x%x", addr - base);
+    return it->second + buffer;
+}
+
+void call_profile_t::reset() {
+    this->nodes.assign(1, node_t{0, NONE, NONE, NONE, 0, 0});
+    this->stack.clear();
+    this->clock = 0;
+    this->last_clock = 0;
+}
+
+void call_profile_t::charge() {
+    if (!this->stack.empty()) {
+        this->nodes[this->stack.back().node].self += this->clock - this->last_clock;
+    }
+    this->last_clock = this->clock;
+}
+
+uint32_t call_profile_t::child(uint32_t parent, mem_addr function) {
+    for (uint32_t c = this->nodes[parent].first_child; c != NONE; c = this->nodes[c].next_sibling) {
+        if (this->nodes[c].function == function) {
+            return c;
+        }
+    }
+    uint32_t c = static_cast<uint32_t>(this->nodes.size());
+    this->nodes.push_back(node_t{function, parent, NONE, this->nodes[parent].first_child, 0, 0});
+    this->nodes[parent].first_child = c;
+    return c;
+}
+
+void call_profile_t::push(mem_addr function, mem_addr return_addr, bool exception) {
+    if (this->stack.size() >= MAX_DEPTH) {
+        ++this->nodes[this->stack.back().node].calls;
+        return;
+    }
+    uint32_t parent = this->stack.empty() ? ROOT : this->stack.back().node;
+    uint32_t node = this->child(parent, function);
+    ++this->nodes[node].calls;
+    this->stack.push_back(frame_t{node, return_addr, exception});
+}
+
+void call_profile_t::enter(mem_addr pc) {
+    if (this->nodes.empty()) {
+        this->reset();
+    }
+    this->charge();
+    this->stack.clear();
+    this->push(pc, 0, false);
+}
+
+void call_profile_t::call(mem_addr target, mem_addr return_addr) {
+    this->charge();
+    this->push(target, return_addr, false);
+}
+
+void call_profile_t::jump_register(mem_addr target) {
+    /* Frame 0 is the entry point, which has nothing to return to. */
+    for (size_t i = this->stack.size(); i-- > 1;) {
+        const frame_t &frame = this->stack[i];
+        if (frame.exception) {
+            return; /* Handlers do not return with jr */
+        }
+        if (frame.return_addr == target) {
+            this->charge();
+            this->stack.resize(i);
+            return;
+        }
+    }
+}
+
+void call_profile_t::exception(mem_addr handler) {
+    this->charge();
+    this->push(handler, 0, true);
+}
+
+void call_profile_t::exception_return() {
+    for (size_t i = this->stack.size(); i-- > 1;) {
+        if (this->stack[i].exception) {
+            this->charge();
+            this->stack.resize(i);
+            return;
+        }
+    }
+}
+
+void call_profile_t::write_folded(FILE *out, const symbolizer_t &symbols) {
+    this->charge();
+
+    std::unordered_map<mem_addr, std::string> names;
+    auto name = [&](mem_addr function) -> const std::string & {
+        auto it = names.find(function);
+        if (it == names.end()) {
+            it = names.emplace(function, symbols.name(function)).first;
+        }
+        return it->second;
+    };
+
+    std::vector<uint32_t> path;
+    for (uint32_t n = 1; n < this->nodes.size(); ++n) {
+        if (this->nodes[n].self == 0) {
+            continue;
+        }
+        path.clear();
+        for (uint32_t p = n; p != ROOT; p = this->nodes[p].parent) {
+            path.push_back(p);
+        }
+        for (size_t i = path.size(); i-- > 0;) {
+            fprintf(out, "%s%s", name(this->nodes[path[i]].function).c_str(), i == 0 ? "" : ";");
+        }
+        fprintf(out, " %llu\n", (unsigned long long)this->nodes[n].self);
+    }
+}
+
+void call_profile_t::write_summary(FILE *out, const symbolizer_t &symbols) {
+    this->charge();
+
+    /* Children are always created after their parents, so one backwards pass sums subtrees. */
+    std::vector<uint64_t> inclusive(this->nodes.size());
+    for (uint32_t n = static_cast<uint32_t>(this->nodes.size()); n-- > 1;) {
+        inclusive[n] += this->nodes[n].self;
+        inclusive[this->nodes[n].parent] += inclusive[n];
+    }
+
+    struct function_t {
+        uint64_t calls = 0;
+        uint64_t self = 0;
+        uint64_t total = 0;
+    };
+    std::map<mem_addr, function_t> functions;
+    uint64_t all = inclusive[ROOT];
+    for (uint32_t n = 1; n < this->nodes.size(); ++n) {
+        const node_t &node = this->nodes[n];
+        function_t &f = functions[node.function];
+        f.calls += node.calls;
+        f.self += node.self;
+
+        /* Under recursion only the outermost activation counts towards the total. */
+        bool outermost = true;
+        for (uint32_t p = node.parent; p != ROOT && outermost; p = this->nodes[p].parent) {
+            outermost = this->nodes[p].function != node.function;
+        }
+        if (outermost) {
+            f.total += inclusive[n];
+        }
+    }
+
+    std::vector<std::pair<mem_addr, function_t>> sorted(functions.begin(), functions.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto &a, const auto &b) { return a.second.self > b.second.self; });
+
+    fprintf(out, "function\taddress\tcalls\tself\ttotal\tself_percent\ttotal_percent\n");
+    for (const auto &entry : sorted) {
+        const function_t &f = entry.second;
+        fprintf(out, "%s\t0x%08x\t%llu\t%llu\t%llu\t%.2f\t%.2f\n", symbols.name(entry.first).c_str(), entry.first,
+                (unsigned long long)f.calls, (unsigned long long)f.self, (unsigned long long)f.total,
+                all == 0 ? 0.0 : 100.0 * f.self / all, all == 0 ? 0.0 : 100.0 * f.total / all);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef CALL_PROFILE_H
+#define CALL_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "spim.h"
+
+/* Names code addresses after the closest label at or below them ("f", "f+0x1c" or "0x00400100"). */
+class symbolizer_t {
+   public:
+    void add(mem_addr addr, std::string_view name);
+    std::string name(mem_addr addr) const;
+
+   private:
+    void sort() const;
+
+    mutable std::vector<std::pair<mem_addr, std::string>> labels;
+    mutable bool sorted = true;
+};
+
+/**
+ * Function-level profile of a running program.
+ *
+ * The interpreter reports calls (jal, jalr, bgezal/bltzal and so bal), returns (a jr to the return
+ * address of a frame on the stack) and exceptions; nothing is done for other instructions. A
+ * shadow call stack follows the guest's, and at every event the instructions executed since the
+ * previous one are charged to the function on top of it. Charges go to a calling-context tree,
+ * one node per distinct call path, from which both Brendan Gregg's folded stacks (for
+ * flamegraph.pl and speedscope) and a per-function summary are written.
+ *
+ * Returns that match no frame (hand-written code jumping through $ra) are ignored, and a jr
+ * that skips frames, like longjmp, unwinds all of them. Past MAX_DEPTH frames, calls are
+ * counted but the stack stops growing, so jal used as a plain jump cannot exhaust memory.
+ */
+class call_profile_t {
+   public:
+    static constexpr size_t MAX_DEPTH = 1024;
+
+    /* Instructions executed so far. Advanced by the driver loop; read only at events. */
+    uint64_t clock = 0;
+
+    /* Forget everything recorded so far. */
+    void reset();
+
+    /* Execution (re)starts at PC with nothing on the call stack. */
+    void enter(mem_addr pc);
+
+    /* A call to TARGET that returns to RETURN_ADDR. */
+    void call(mem_addr target, mem_addr return_addr);
+
+    /* A jump through a register to TARGET, which may return from one or more frames. */
+    void jump_register(mem_addr target);
+
+    /* An exception or interrupt entered the handler at HANDLER; exception_return is its eret. */
+    void exception(mem_addr handler);
+    void exception_return();
+
+    /* One line per call path: "main;f;g 1234", weighted by instructions executed in g itself. */
+    void write_folded(FILE *out, const symbolizer_t &symbols);
+
+    /* Tab-separated calls, self and total (inclusive) instructions per function, by self. */
+    void write_summary(FILE *out, const symbolizer_t &symbols);
+
+   private:
+    struct node_t {
+        mem_addr function;
+        uint32_t parent;
+        uint32_t first_child;
+        uint32_t next_sibling;
+        uint64_t self;
+        uint64_t calls;
+    };
+
+    struct frame_t {
+        uint32_t node;
+        mem_addr return_addr; /* 0 for the entry frame and exception frames */
+        bool exception;
+    };
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t ROOT = 0; /* Parent of entry points; never printed */
+
+    /* Charge the instructions since the last event to the top frame. */
+    void charge();
+    void push(mem_addr function, mem_addr return_addr, bool exception);
+    uint32_t child(uint32_t parent, mem_addr function);
+
+    std::vector<node_t> nodes;
+    std::vector<frame_t> stack;
+    uint64_t last_clock = 0;
+};
+
+#endif
@@ -6,6 +6,11 @@
 
 #include "spim.h"
 
+/* Build with SPIMBOT_PROFILING=0 to drop every profiling hook from the interpreter at compile time. */
+#ifndef SPIMBOT_PROFILING
+#define SPIMBOT_PROFILING 1
+#endif
+
 struct MemConfig {
     // Starting Config details
     int32_t text_size, data_size, stack_size, k_text_size, k_data_size;
@@ -14,6 +19,13 @@ struct MemConfig {
     // Hard limits
 };
 
+/* How a CPU profiles the program it runs; fixed when the CPU is created. */
+enum class ProfileMode : uint8_t {
+    OFF,     /* No profiling; the interpreter does no extra work */
+    SAMPLED, /* Record the PC once every profile_period instructions */
+    EXACT,   /* Count every branch, jump and exception (block_profile_t) */
+};
+
 struct CPUConfig {
     MemConfig memory;
 
@@ -29,6 +41,10 @@ struct CPUConfig {
     bool delayed_branches;               /* => simulate delayed branches */
     bool delayed_loads;                  /* => simulate delayed loads */
     bool quiet;                          /* => no warning messages */
+    ProfileMode profile_mode;            /* OFF unless a profile was asked for */
+    uint32_t profile_period;             /* Instructions between samples when SAMPLED */
+    bool profile_calls;                  /* => attribute instructions to guest functions */
+    bool collect_stats;                  /* => count opcodes, branch outcomes and accesses by segment */
     char* exception_file_name = nullptr; /* The path from which to load the exception handler, if desired */
     int spim_return_value;               /* Value returned when spim exits */
 };
@@ -32,12 +32,18 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <unordered_map>
 
 #include "TODO/spim-utils.h"
+#include "call_profile.h"
 #include "config.h"
+#include "exec_stats.h"
+#include "exec_trace.h"
 #include "inst.h"
 #include "mem.h"
+#include "mem_trace.h"
+#include "program_image.h"
 #include "reg.h"
 #include "scanner.h"
 #include "sym-tbl.h"
@@ -56,8 +62,25 @@ class CPU {
     reg_image_t registers;
     SymbolTable symbol_table;
 
+    /* Shared, read-only program this CPU was loaded from (nullptr if it assembled its own). */
+    std::shared_ptr<const program_image_t> program_image;
+
     std::unordered_map<mem_addr, bkpt> breakpoints;
 
+    /* Guest function profile (CPUConfig::profile_calls) and the count towards the next PC sample
+       (ProfileMode::SAMPLED). */
+    call_profile_t call_prof;
+    uint32_t since_sample = 0;
+
+    /* Opcode and memory segment counters (CPUConfig::collect_stats). */
+    exec_stats_t stats;
+
+    /* Load and store trace, while one is running (start_mem_trace). */
+    std::unique_ptr<mem_trace_t> mem_trace;
+
+    /* Instruction trace, while one is running (start_exec_trace). */
+    std::unique_ptr<exec_trace_t> exec_trace;
+
     mem_addr last_exception_addr;
 
     bool force_break;           /* => stop interpreter loop  */
@@ -138,6 +161,119 @@ class CPU {
 
     mem_addr starting_address();
 
+    /* Read-only view of the registers, for embedders and debuggers. */
+    const reg_image_t &register_image() const { return this->registers; }
+    const mem_image_t &memory_image() const { return this->memory; }
+
+    /* The profiling chosen at creation. Constant false without SPIMBOT_PROFILING, so every hook
+       behind these compiles away. */
+    bool profiling_exact() const {
+        return SPIMBOT_PROFILING && this->config.profile_mode == ProfileMode::EXACT;
+    }
+    bool profiling_sampled() const {
+        return SPIMBOT_PROFILING && this->config.profile_mode == ProfileMode::SAMPLED;
+    }
+    bool profiling_calls() const { return SPIMBOT_PROFILING && this->config.profile_calls; }
+    bool collecting_stats() const { return SPIMBOT_PROFILING && this->config.collect_stats; }
+
+    /* Branch outcomes feed both the exact profile and the statistics. */
+    bool recording_branches() const { return this->profiling_exact() || this->collecting_stats(); }
+
+    bool tracing_memory() const { return SPIMBOT_PROFILING && this->mem_trace != nullptr; }
+    bool tracing_exec() const { return SPIMBOT_PROFILING && this->exec_trace != nullptr; }
+
+    /* True if the driver loop must call profile_step() before every instruction. */
+    bool profiling_steps() const {
+        return this->profiling_sampled() || this->profiling_calls() || this->tracing_memory() ||
+               this->tracing_exec();
+    }
+
+    void profile_step() {
+        if (this->profiling_calls()) {
+            ++this->call_prof.clock;
+        }
+        if (this->tracing_memory()) {
+            ++this->mem_trace->clock;
+        }
+        if (this->tracing_exec()) {
+            this->exec_trace->step(this->registers.PC, this->registers.R.data(), this->registers.HI,
+                                   this->registers.LO);
+        }
+        if (this->profiling_sampled() && ++this->since_sample >= this->config.profile_period) {
+            this->since_sample = 0;
+            this->memory.block_prof.sample(this->registers.PC);
+        }
+    }
+
+    /* Write the profile (see mem_image_t::mem_dump_profile); false if there is none or it failed. */
+    bool dump_profile(const std::string &prof_file_name, const std::string &text_file_name = "") const;
+
+    /* Write the function profile as folded stacks and, unless SUMMARY_FILE_NAME is empty, as a
+       per-function summary; false if calls are not profiled or a file could not be written. */
+    bool dump_call_profile(const std::string &folded_file_name, const std::string &summary_file_name = "");
+
+    /* Write the statistics as JSON; false if they are not collected or the file could not be written. */
+    bool dump_stats(const std::string &file_name);
+
+    /* Trace every data load and store to PATH (see mem_trace_t) until stop_mem_trace(). False if
+       a trace is already running, profiling is compiled out or PATH cannot be created. */
+    bool start_mem_trace(const std::string &path);
+
+    /* Finish the trace; false if none was running or writing it failed. */
+    bool stop_mem_trace();
+
+    /* Record every instruction executed, and the registers it wrote, to PATH (see exec_trace_t)
+       until stop_exec_trace(). False if a trace is already running, profiling is compiled out or
+       PATH cannot be created. */
+    bool start_exec_trace(const std::string &path);
+
+    /* Finish the trace; false if none was running or writing it failed. */
+    bool stop_exec_trace();
+
+    /* Names for code addresses, from the labels of the loaded program (for profiles). */
+    symbolizer_t code_symbols() const;
+
+    /* Continue execution at ADDR on the next step. */
+    void set_pc(mem_addr addr) {
+        if (this->profiling_exact()) {
+            this->memory.block_prof.transfer(0, addr, profile_edge_t::ENTRY);
+        }
+        if (this->profiling_calls()) {
+            this->call_prof.enter(addr);
+        }
+        this->registers.PC = addr;
+    }
+
+    /**
+     * Freeze the program assembled into this CPU into an immutable image that other CPUs can
+     * load without re-assembling. The text segments become shared (copy-on-write) and the
+     * symbol table moves into the image. Returns nullptr if some symbols are still undefined.
+     */
+    std::shared_ptr<const program_image_t> share_program_image();
+
+    /**
+     * Replace this CPU's program with IMAGE. Text and symbols are shared with every other CPU
+     * using the image; data segments are copied so this CPU can write to them.
+     */
+    void load_program_image(std::shared_ptr<const program_image_t> image);
+
+    /**
+     * Machine state at some point of a run. The text is shared copy-on-write, so taking a
+     * snapshot costs about as much as copying the data and stack segments.
+     */
+    struct Snapshot {
+        mem_image_t memory;
+        reg_image_t registers;
+        std::shared_ptr<const program_image_t> program_image;
+        mem_addr last_exception_addr;
+        bool done;
+    };
+
+    Snapshot snapshot() const;
+
+    /* Rewind to SNAPSHOT, which may have been taken on another CPU loaded from the same image. */
+    void restore(const Snapshot &snapshot);
+
     /* Set a breakpoint at memory location ADDR. */
 
     void add_breakpoint(mem_addr addr);
@@ -228,6 +364,10 @@ class CPU {
     /* Store an INSTRUCTION in memory at the next location. */
     void store_instruction(instruction *inst);
 
+    /* Arena that the assembler allocates instructions and expressions for the current text
+       segment from. Released when that segment is reset. */
+    asm_arena_t &text_arena();
+
     /* Print the instruction stored at the memory ADDRESS. */
 
     void print_inst(port message_out, mem_addr addr);
@@ -272,7 +412,7 @@ class CPU {
         }
 
         if (!l->global_flag) {
-            symbol_table.local_labels.push_front(std::ref(*l));
+            symbol_table.record_local_label(l);
         }
         return l;
     }
@@ -312,9 +452,9 @@ class CPU {
 
     void i_type_inst(int opcode, int rt, int rs, imm_expr *expr);
 
-    void i_type_inst_free(int opcode, int rt, int rs, imm_expr *expr);
-
-    void free_inst(instruction *inst);
+    /* Load the value of EXPR into register RT with a lui/ori pair, or just one of them when
+       VALUE is known to fit. */
+    void produce_immediate(imm_expr *expr, int rt, int value_known, int32 value);
 
     void i_type_inst_full_word(int opcode, int rt, int rs, imm_expr *expr, int value_known,
                                int32 value);
@@ -322,8 +462,9 @@ class CPU {
     /* Code to test encode/decode of instructions. */
 
     inline void test_assembly(instruction *inst) {
+        asm_arena_t scratch;
         instruction *new_inst =
-            instruction::inst_decode(inst->inst_encode(config.correct_branches));
+            instruction::inst_decode(scratch, inst->inst_encode(config.correct_branches));
 
         if (inst != new_inst) {
             std::stringstream stream;
@@ -333,7 +474,6 @@ class CPU {
             instruction::format_an_inst(stream, new_inst, 0);
             stream << "=================== Not Equal ===================\n";
         }
-        free_inst(new_inst);
     }
 
     /* DATA Methods */
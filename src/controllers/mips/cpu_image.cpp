@@ -0,0 +1,123 @@
+#include "cpu.h"
+#include "mem.h"
+#include "program_image.h"
+#include "spim.h"
+
+/* Return the address of the program's entry point, or 0 if it is undefined. */
+
+mem_addr CPU::starting_address() {
+    if (this->program_image != nullptr) {
+        const label *l = this->program_image->symbol_table->label_is_defined(DEFAULT_RUN_LOCATION);
+        return l == nullptr ? 0 : l->addr;
+    }
+    return this->symbol_table.find_symbol_address(DEFAULT_RUN_LOCATION);
+}
+
+std::shared_ptr<const program_image_t> CPU::share_program_image() {
+    if (this->program_image != nullptr) {
+        return this->program_image;
+    }
+
+    std::string undefined = this->symbol_table.undefined_symbol_string();
+    if (!undefined.empty()) {
+        error("Cannot share a program with undefined symbols:\n%s", undefined.c_str());
+        return nullptr;
+    }
+
+    const mem_image_t &mem_image = this->memory;
+    const reg_image_t &reg_image = this->registers;
+
+    auto image = std::make_shared<program_image_t>();
+
+    image->text_seg = mem_image.text_seg;
+    image->text_top = mem_image.text_top;
+    image->k_text_seg = mem_image.k_text_seg;
+    image->k_text_top = mem_image.k_text_top;
+
+    image->data_seg = mem_image.data_seg;
+    image->data_top = mem_image.data_top;
+    image->gp_midpoint = mem_image.gp_midpoint;
+    image->k_data_seg = mem_image.k_data_seg;
+    image->k_data_top = mem_image.k_data_top;
+
+    image->next_text_pc = reg_image.next_text_pc;
+    image->next_k_text_pc = reg_image.next_k_text_pc;
+    image->next_data_pc = reg_image.next_data_pc;
+    image->next_k_data_pc = reg_image.next_k_data_pc;
+    image->next_gp_item_addr = reg_image.next_gp_item_addr;
+
+    /* Moving the table keeps its nodes, so the labels instructions point to stay valid. */
+    image->symbol_table = std::make_shared<const SymbolTable>(std::move(this->symbol_table));
+    this->symbol_table = SymbolTable();
+
+    this->program_image = image;
+    return image;
+}
+
+void CPU::load_program_image(std::shared_ptr<const program_image_t> image) {
+    mem_image_t &mem_image = this->memory;
+    reg_image_t &reg_image = this->registers;
+
+    /* Shared, copy-on-write. */
+    mem_image.text_seg = image->text_seg;
+    mem_image.text_top = image->text_top;
+    mem_image.k_text_seg = image->k_text_seg;
+    mem_image.k_text_top = image->k_text_top;
+
+    /* Profile counts are per CPU. */
+    mem_image.block_prof.reset(TEXT_BOT, mem_image.text_seg.size(), K_TEXT_BOT, mem_image.k_text_seg.size());
+
+    mem_image.data_seg = image->data_seg;
+    mem_image.data_seg_b = (BYTE_TYPE *)mem_image.data_seg.data();
+    mem_image.data_seg_h = (short *)mem_image.data_seg.data();
+    mem_image.data_top = image->data_top;
+    mem_image.gp_midpoint = image->gp_midpoint;
+
+    mem_image.k_data_seg = image->k_data_seg;
+    mem_image.k_data_seg_b = (BYTE_TYPE *)mem_image.k_data_seg.data();
+    mem_image.k_data_seg_h = (short *)mem_image.k_data_seg.data();
+    mem_image.k_data_top = image->k_data_top;
+
+    reg_image.next_text_pc = image->next_text_pc;
+    reg_image.next_k_text_pc = image->next_k_text_pc;
+    reg_image.next_data_pc = image->next_data_pc;
+    reg_image.next_k_data_pc = image->next_k_data_pc;
+    reg_image.next_gp_item_addr = image->next_gp_item_addr;
+    if (!config.bare_machine) {
+        reg_image.R[REG_GP] = image->gp_midpoint;
+    }
+
+    mem_image.text_modified = true;
+    mem_image.data_modified = true;
+
+    this->symbol_table.initialize_symbol_table(false);
+    this->program_image = std::move(image);
+}
+
+CPU::Snapshot CPU::snapshot() const {
+    /* Without a program image, the instructions' labels belong to this CPU's symbol table, so the
+       snapshot is only good for this CPU. */
+    Snapshot snapshot = {this->memory, this->registers, this->program_image,
+                         this->last_exception_addr, this->done};
+    snapshot.memory.reset_segment_views();
+    snapshot.registers.FGR = (float *)snapshot.registers.FPR.data();
+    snapshot.registers.FWR = (int *)snapshot.registers.FPR.data();
+    return snapshot;
+}
+
+void CPU::restore(const Snapshot &snapshot) {
+    this->memory = snapshot.memory;
+    this->memory.reset_segment_views();
+
+    this->registers = snapshot.registers;
+    this->registers.FGR = (float *)this->registers.FPR.data();
+    this->registers.FWR = (int *)this->registers.FPR.data();
+
+    if (snapshot.program_image != nullptr) {
+        this->symbol_table.initialize_symbol_table(false);
+        this->program_image = snapshot.program_image;
+    }
+    this->last_exception_addr = snapshot.last_exception_addr;
+    this->done = snapshot.done;
+    this->force_break = false;
+}
@@ -26,12 +26,21 @@ inline void CPU::increment_text_pc(int delta) {
 
 inline void CPU::user_kernel_text_segment(bool to_kernel) { this->registers.in_kernel = to_kernel; }
 
+/* Return the arena that instructions for the current text segment are allocated from. */
+
+asm_arena_t &CPU::text_arena() {
+    if (this->registers.in_kernel) {
+        return this->memory.k_text_seg.arena();
+    }
+    return this->memory.text_seg.arena();
+}
+
 /* Store an INSTRUCTION in memory at the next location. */
 
 inline void CPU::store_instruction(instruction *inst) {
     if (data_dir) {
+        /* Only the encoding is kept; the instruction stays in the arena until it is reset. */
         store_word(inst->inst_encode());
-        free_inst(inst);
     } else if (text_dir) {
         this->registers.exception_occurred = false;
         this->set_mem_inst(this->registers.INST_PC(), inst);
@@ -77,15 +86,18 @@ std::string CPU::inst_to_string(mem_addr addr) {
 Any of the three parts may be omitted. */
 
 addr_expr *CPU::make_addr_expr(int offs, char *sym, int reg_no) {
-    addr_expr *expr = (addr_expr *)xmalloc(sizeof(addr_expr));
+    asm_arena_t &arena = this->text_arena();
+    addr_expr *expr = arena.make<addr_expr>();
     label *lab;
 
+    /* SYM is only used to look up the label, which keeps its own copy of the name. */
     if (reg_no == 0 && sym != nullptr && (lab = symbol_table.lookup_label(sym))->gp_flag) {
         expr->reg_no = REG_GP;
-        expr->imm = imm_expr::make_imm_expr(offs + lab->addr - this->memory.gp_midpoint, nullptr, false);
+        expr->imm = imm_expr::make_imm_expr(arena, offs + lab->addr - this->memory.gp_midpoint,
+                                            nullptr, false);
     } else {
         expr->reg_no = (unsigned char)reg_no;
-        expr->imm = imm_expr::make_imm_expr(offs, (sym ? str_copy(sym) : sym), false);
+        expr->imm = imm_expr::make_imm_expr(arena, offs, sym, false);
     }
     return (expr);
 }
@@ -101,12 +113,13 @@ bool CPU::inst_is_breakpoint(mem_addr addr) const {
    routine will not produce more than one instruction. */
 
 void CPU::j_type_inst(int opcode, imm_expr *target) {
-    instruction *inst = new instruction();
+    asm_arena_t &arena = this->text_arena();
+    instruction *inst = arena.make<instruction>();
 
     inst->SET_OPCODE(opcode);
     target->offset = 0; /* Not PC relative */
     target->pc_relative = false;
-    inst->SET_EXPR(imm_expr::copy_imm_expr(target));
+    inst->SET_EXPR(imm_expr::copy_imm_expr(arena, target));
     if (target->symbol == nullptr || SYMBOL_IS_DEFINED(target->symbol)) {
         resolve_a_label(target->symbol, inst);
     } else {
@@ -119,7 +132,7 @@ void CPU::j_type_inst(int opcode, imm_expr *target) {
    fields. */
 
 void CPU::r_co_type_inst(int opcode, int fd, int fs, int ft) {
-    instruction *inst = instruction::make_r_type_inst(opcode, fs, 0, ft);
+    instruction *inst = instruction::make_r_type_inst(this->text_arena(), opcode, fs, 0, ft);
     inst->SET_FD(fd);
     store_instruction(inst);
 }
@@ -128,14 +141,14 @@ void CPU::r_co_type_inst(int opcode, int fd, int fs, int ft) {
    fields. */
 
 void CPU::r_type_inst(int opcode, int rd, int rs, int rt) {
-    store_instruction(instruction::make_r_type_inst(opcode, rd, rs, rt));
+    store_instruction(instruction::make_r_type_inst(this->text_arena(), opcode, rd, rs, rt));
 }
 
 /* Return a register-shift instruction with the given OPCODE, RD, RT, and
    SHAMT fields.*/
 
 void CPU::r_sh_type_inst(int opcode, int rd, int rt, int shamt) {
-    instruction *inst = instruction::make_r_type_inst(opcode, rd, 0, rt);
+    instruction *inst = instruction::make_r_type_inst(this->text_arena(), opcode, rd, 0, rt);
     inst->SET_SHAMT(shamt & 0x1f);
     store_instruction(inst);
 }
@@ -144,7 +157,7 @@ void CPU::r_sh_type_inst(int opcode, int rd, int rt, int shamt) {
    FS, FT, and CC fields.*/
 
 void CPU::r_cond_type_inst(int opcode, int fs, int ft, int cc) {
-    instruction *inst = instruction::make_r_type_inst(opcode, fs, 0, ft);
+    instruction *inst = instruction::make_r_type_inst(this->text_arena(), opcode, fs, 0, ft);
     inst->SET_FD(cc << 2);
     switch (opcode) {
         case Y_C_EQ_D_OP:
@@ -253,12 +266,13 @@ void CPU::r_cond_type_inst(int opcode, int fs, int ft, int cc) {
    that fit into instruction's immediate field. */
 
 void CPU::i_type_inst(int opcode, int rt, int rs, imm_expr *expr) {
-    instruction *inst = new instruction();
+    asm_arena_t &arena = this->text_arena();
+    instruction *inst = arena.make<instruction>();
 
     inst->SET_OPCODE(opcode);
     inst->SET_RS(rs);
     inst->SET_RT(rt);
-    inst->SET_EXPR(imm_expr::copy_imm_expr(expr));
+    inst->SET_EXPR(imm_expr::copy_imm_expr(arena, expr));
 
     if (expr->symbol == nullptr || SYMBOL_IS_DEFINED(expr->symbol)) {
         /* Evaluate the instruction's expression. */
@@ -273,8 +287,7 @@ void CPU::i_type_inst(int opcode, int rt, int rs, imm_expr *expr) {
                   ? ((value & 0xffff8000) != 0 && (value & 0xffff8000) != 0xffff8000)
                   // Not sign-extended:
                   : (value & 0xffff0000) != 0))) {
-            // Non-immediate value
-            free_inst(inst);
+            // Non-immediate value; INST is abandoned to the arena
             i_type_inst_full_word(opcode, rt, rs, expr, 1, value);
             return;
         } else {
@@ -287,8 +300,6 @@ void CPU::i_type_inst(int opcode, int rt, int rs, imm_expr *expr) {
         /* Don't know the expressions's value and want all of its bits,
            so assume that it will not produce a small result and generate
            sequence for 32 bit value. */
-        free_inst(inst);
-
         i_type_inst_full_word(opcode, rt, rs, expr, 0, 0);
         return;
     }
@@ -296,16 +307,19 @@ void CPU::i_type_inst(int opcode, int rt, int rs, imm_expr *expr) {
     store_instruction(inst);
 }
 
-void CPU::i_type_inst_free(int opcode, int rt, int rs, imm_expr *expr) {
-    i_type_inst(opcode, rt, rs, expr);
-    delete expr;
-}
+/* Load the value of EXPR into register RT with a lui/ori pair, or just one of them when
+   VALUE is known to fit. */
+
+void CPU::produce_immediate(imm_expr *expr, int rt, int value_known, int32 value) {
+    asm_arena_t &arena = this->text_arena();
 
-void CPU::free_inst(instruction *inst) {
-    if (inst != break_inst) {
-        /* Don't free the breakpoint insructions since we only have one. */
-        delete inst;
-        inst = nullptr;
+    if (value_known && (value & 0xffff) == 0) {
+        i_type_inst(Y_LUI_OP, rt, 0, imm_expr::upper_bits_of_expr(arena, expr));
+    } else if (value_known && (value & 0xffff0000) == 0) {
+        i_type_inst(Y_ORI_OP, rt, 0, imm_expr::lower_bits_of_expr(arena, expr));
+    } else {
+        i_type_inst(Y_LUI_OP, 1, 0, imm_expr::upper_bits_of_expr(arena, expr));
+        i_type_inst(Y_ORI_OP, rt, 1, imm_expr::lower_bits_of_expr(arena, expr));
     }
 }
 
@@ -314,13 +328,15 @@ void CPU::free_inst(instruction *inst) {
 
 void CPU::i_type_inst_full_word(int opcode, int rt, int rs, imm_expr *expr, int value_known,
                                 int32 value) {  // XXX: FIXME
+    asm_arena_t &arena = this->text_arena();
+
     if (opcode_is_load_store(opcode)) {
         int32 offset;
 
         if (expr->symbol != nullptr && expr->symbol->gp_flag && rs == 0 &&
             (int32)IMM_MIN <= (offset = expr->symbol->addr + expr->offset) &&
             offset <= (int32)IMM_MAX) {
-            i_type_inst_free(opcode, rt, REG_GP, imm_expr::make_imm_expr(offset, nullptr, false));
+            i_type_inst(opcode, rt, REG_GP, imm_expr::make_imm_expr(arena, offset, nullptr, false));
         } else if (value_known) {
             int low, high;
 
@@ -334,30 +350,30 @@ void CPU::i_type_inst_full_word(int opcode, int rt, int rs, imm_expr *expr, int
                     high += 1;
                 }
 
-                i_type_inst_free(Y_LUI_OP, 1, 0, imm_expr::const_imm_expr(high));
+                i_type_inst(Y_LUI_OP, 1, 0, imm_expr::const_imm_expr(arena, high));
                 if (rs != 0) /* Base register */
                 {
                     r_type_inst(Y_ADDU_OP, 1, 1, rs);
                 }
-                i_type_inst_free(opcode, rt, 1,
-                                 imm_expr::lower_bits_of_expr(imm_expr::const_imm_expr(low)));
+                i_type_inst(opcode, rt, 1,
+                            imm_expr::lower_bits_of_expr(arena, imm_expr::const_imm_expr(arena, low)));
             } else {
                 /* Special case, sign-extension of low 16 bits sets high to 0xffff */
-                i_type_inst_free(opcode, rt, rs, imm_expr::const_imm_expr(low));
+                i_type_inst(opcode, rt, rs, imm_expr::const_imm_expr(arena, low));
             }
         } else {
             /* Use $at */
             /* Need to adjust if lower bits are negative */
-            i_type_inst_free(Y_LUI_OP, 1, 0, imm_expr::upper_bits_of_expr(expr));
+            i_type_inst(Y_LUI_OP, 1, 0, imm_expr::upper_bits_of_expr(arena, expr));
             if (rs != 0) /* Base register */
             {
                 r_type_inst(Y_ADDU_OP, 1, 1, rs);
             }
-            i_type_inst_free(opcode, rt, 1, imm_expr::lower_bits_of_expr(expr));
+            i_type_inst(opcode, rt, 1, imm_expr::lower_bits_of_expr(arena, expr));
         }
     } else if (opcode_is_branch(opcode)) {
         /* This only allows branches +/- 32K, which is not correct! */
-        i_type_inst_free(opcode, rt, rs, imm_expr::lower_bits_of_expr(expr));
+        i_type_inst(opcode, rt, rs, imm_expr::lower_bits_of_expr(arena, expr));
     } else {
         /* Computation instruction */
         int offset;
@@ -365,16 +381,16 @@ void CPU::i_type_inst_full_word(int opcode, int rt, int rs, imm_expr *expr, int
         if (expr->symbol != nullptr && expr->symbol->gp_flag && rs == 0 &&
             (int32)IMM_MIN <= (offset = expr->symbol->addr + expr->offset) &&
             offset <= (int32)IMM_MAX) {
-            i_type_inst_free((opcode == Y_LUI_OP ? Y_ADDIU_OP : opcode), rt, REG_GP,
-                             imm_expr::make_imm_expr(offset, nullptr, false));
+            i_type_inst((opcode == Y_LUI_OP ? Y_ADDIU_OP : opcode), rt, REG_GP,
+                        imm_expr::make_imm_expr(arena, offset, nullptr, false));
         } else {
             /* Use $at */
             if ((opcode == Y_ORI_OP || opcode == Y_ADDI_OP || opcode == Y_ADDIU_OP ||
                  opcode == Y_LUI_OP) &&
                 rs == 0) {
-                expr->produce_immediate(rt, value_known, value);
+                produce_immediate(expr, rt, value_known, value);
             } else {
-                expr->produce_immediate(1, value_known, value);
+                produce_immediate(expr, 1, value_known, value);
                 r_type_inst(imm_op_to_op(opcode), rt, rs, 1);
             }
         }
@@ -1,19 +1,86 @@
 #include "cpu.h"
+#include "host_profile.h"
 #include "inst.h"
 #include "mem.h"
 
 /* Access memory */
 
+namespace {
+
+/* The segment holding ADDR, as counted by exec_stats_t. Mirrors the dispatch order below. */
+mem_segment_t segment_of(const mem_image_t &mem_image, mem_addr addr) {
+    if (addr >= DATA_BOT && addr < mem_image.data_top) {
+        return mem_segment_t::DATA;
+    } else if (addr >= mem_image.stack_bot && addr < STACK_TOP) {
+        return mem_segment_t::STACK;
+    } else if (addr >= K_DATA_BOT && addr < mem_image.k_data_top) {
+        return mem_segment_t::K_DATA;
+    } else if (addr >= SPECIAL_BOT && addr < SPECIAL_TOP) {
+        return mem_segment_t::SPECIAL;
+    } else if (addr >= MM_IO_BOT) {
+        return mem_segment_t::MMIO;
+    } else if (addr >= TEXT_BOT && addr < mem_image.text_top) {
+        return mem_segment_t::TEXT;
+    } else if (addr >= K_TEXT_BOT && addr < mem_image.k_text_top) {
+        return mem_segment_t::K_TEXT;
+    }
+    return mem_segment_t::UNMAPPED;
+}
+
+}  // namespace
+
 void *CPU::mem_reference(mem_addr addr) const { return this->memory.mem_reference(addr); }
 
+bool CPU::dump_profile(const std::string &prof_file_name, const std::string &text_file_name) const {
+    if (!this->profiling_exact() && !this->profiling_sampled()) {
+        return false;
+    }
+    return this->memory.mem_dump_profile(prof_file_name, this->config.delayed_branches, text_file_name);
+}
+
+bool CPU::dump_stats(const std::string &file_name) {
+    if (!this->collecting_stats()) {
+        return false;
+    }
+
+    std::vector<branch_site_t> branches;
+    this->memory.block_prof.for_each_branch_site(
+        [&](mem_addr pc, mem_addr target, uint64_t taken, uint64_t not_taken) {
+            instruction *inst = this->read_mem_inst(pc);
+            branches.push_back({pc, target, inst != nullptr ? inst->OPCODE() : -1, taken, not_taken});
+        });
+
+    FILE *file = fopen(file_name.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    this->stats.write_json(file, branches, opcode_name);
+    return fclose(file) == 0;
+}
+
+bool CPU::start_mem_trace(const std::string &path) {
+    if (!SPIMBOT_PROFILING || this->mem_trace != nullptr) {
+        return false;
+    }
+    this->mem_trace = mem_trace_t::open(path);
+    return this->mem_trace != nullptr;
+}
+
+bool CPU::stop_mem_trace() {
+    if (this->mem_trace == nullptr) {
+        return false;
+    }
+    bool ok = this->mem_trace->close();
+    this->mem_trace.reset();
+    return ok;
+}
+
 instruction *CPU::read_mem_inst(mem_addr addr) {
     mem_image_t &mem_image = this->memory;
 
     if ((addr >= TEXT_BOT) && (addr < mem_image.text_top) && !(addr & 0x3)) {
-        ++mem_image.text_prof[(addr - TEXT_BOT) >> 2];
         return mem_image.text_seg[(addr - TEXT_BOT) >> 2];
     } else if ((addr >= K_TEXT_BOT) && (addr < mem_image.k_text_top) && !(addr & 0x3)) {
-        ++mem_image.k_text_prof[(addr - K_TEXT_BOT) >> 2];
         return mem_image.k_text_seg[(addr - K_TEXT_BOT) >> 2];
     } else {
         return this->bad_text_read(addr);
@@ -21,51 +88,81 @@ instruction *CPU::read_mem_inst(mem_addr addr) {
 }
 
 reg_word CPU::read_mem_byte(mem_addr addr) {
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.load(segment_of(mem_image, addr));
+    }
 
+    reg_word value;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top)) {
-        return mem_image.data_seg_b[addr - DATA_BOT];
+        value = mem_image.data_seg_b[addr - DATA_BOT];
     } else if ((addr >= mem_image.stack_bot) && (addr < STACK_TOP)) {
-        return mem_image.stack_seg_b[addr - mem_image.stack_bot];
+        value = mem_image.stack_seg_b[addr - mem_image.stack_bot];
     } else if ((addr >= K_DATA_BOT) && (addr < mem_image.k_data_top)) {
-        return mem_image.k_data_seg_b[addr - K_DATA_BOT];
+        value = mem_image.k_data_seg_b[addr - K_DATA_BOT];
     } else if ((addr >= SPECIAL_BOT) && (addr < SPECIAL_TOP)) {
-        return mem_image.special_seg_b[addr - SPECIAL_BOT];
+        value = mem_image.special_seg_b[addr - SPECIAL_BOT];
     } else {
-        return this->bad_mem_read(addr, 0);
+        value = this->bad_mem_read(addr, 0);
+    }
+
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 1, value, false);
     }
+    return value;
 }
 
 reg_word CPU::read_mem_half(mem_addr addr) {
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.load(segment_of(mem_image, addr));
+    }
 
+    reg_word value;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top) && !(addr & 0x1)) {
-        return mem_image.data_seg_h[(addr - DATA_BOT) >> 1];
+        value = mem_image.data_seg_h[(addr - DATA_BOT) >> 1];
     } else if ((addr >= mem_image.stack_bot) && (addr < STACK_TOP) && !(addr & 0x1)) {
-        return mem_image.stack_seg_h[(addr - mem_image.stack_bot) >> 1];
+        value = mem_image.stack_seg_h[(addr - mem_image.stack_bot) >> 1];
     } else if ((addr >= K_DATA_BOT) && (addr < mem_image.k_data_top) && !(addr & 0x1)) {
-        return mem_image.k_data_seg_h[(addr - K_DATA_BOT) >> 1];
+        value = mem_image.k_data_seg_h[(addr - K_DATA_BOT) >> 1];
     } else if ((addr >= SPECIAL_BOT) && (addr < SPECIAL_TOP) && !(addr & 0x1)) {
-        return mem_image.special_seg_h[(addr - SPECIAL_BOT) >> 1];
+        value = mem_image.special_seg_h[(addr - SPECIAL_BOT) >> 1];
     } else {
-        return this->bad_mem_read(addr, 0x1);
+        value = this->bad_mem_read(addr, 0x1);
+    }
+
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 2, value, false);
     }
+    return value;
 }
 
 reg_word CPU::read_mem_word(mem_addr addr) {
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.load(segment_of(mem_image, addr));
+    }
 
+    reg_word value;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top) && !(addr & 0x3)) {
-        return mem_image.data_seg[(addr - DATA_BOT) >> 2];
+        value = mem_image.data_seg[(addr - DATA_BOT) >> 2];
     } else if ((addr >= mem_image.stack_bot) && (addr < STACK_TOP) && !(addr & 0x3)) {
-        return mem_image.stack_seg[(addr - mem_image.stack_bot) >> 2];
+        value = mem_image.stack_seg[(addr - mem_image.stack_bot) >> 2];
     } else if ((addr >= K_DATA_BOT) && (addr < mem_image.k_data_top) && !(addr & 0x3)) {
-        return mem_image.k_data_seg[(addr - K_DATA_BOT) >> 2];
+        value = mem_image.k_data_seg[(addr - K_DATA_BOT) >> 2];
     } else if ((addr >= SPECIAL_BOT) && (addr < SPECIAL_TOP) && !(addr & 0x3)) {
-        return mem_image.special_seg[(addr - SPECIAL_BOT) >> 2];
+        value = mem_image.special_seg[(addr - SPECIAL_BOT) >> 2];
     } else {
-        return this->bad_mem_read(addr, 0x3);
+        value = this->bad_mem_read(addr, 0x3);
     }
+
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 4, value, false);
+    }
+    return value;
 }
 
 void CPU::set_mem_inst(mem_addr addr, instruction *inst) {  // XXX
@@ -73,16 +170,23 @@ void CPU::set_mem_inst(mem_addr addr, instruction *inst) {  // XXX
 
     mem_image.text_modified = true;
     if ((addr >= TEXT_BOT) && (addr < mem_image.text_top) && !(addr & 0x3)) {
-        mem_image.text_seg[(addr - TEXT_BOT) >> 2] = inst;
+        mem_image.text_seg.set((addr - TEXT_BOT) >> 2, inst);
     } else if ((addr >= K_TEXT_BOT) && (addr < mem_image.k_text_top) && !(addr & 0x3)) {
-        mem_image.k_text_seg[(addr - K_TEXT_BOT) >> 2] = inst;
+        mem_image.k_text_seg.set((addr - K_TEXT_BOT) >> 2, inst);
     } else {
         this->bad_text_write(addr, inst);  // TODO: UPDATE after fixing bad_text_read
     }
 }
 
 void CPU::set_mem_byte(mem_addr addr, reg_word value) {  // XXX
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.store(segment_of(mem_image, addr));
+    }
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 1, (BYTE_TYPE)value, true);
+    }
 
     mem_image.data_modified = true;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top)) {
@@ -99,7 +203,14 @@ void CPU::set_mem_byte(mem_addr addr, reg_word value) {  // XXX
 }
 
 void CPU::set_mem_half(mem_addr addr, reg_word value) {  // XXX
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.store(segment_of(mem_image, addr));
+    }
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 2, (short)value, true);
+    }
 
     mem_image.data_modified = true;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top) && !(addr & 0x1)) {
@@ -116,7 +227,14 @@ void CPU::set_mem_half(mem_addr addr, reg_word value) {  // XXX
 }
 
 void CPU::set_mem_word(mem_addr addr, reg_word value) {  // XXX
+    host_phase_scope phase(host_phase_t::MEMORY);
     mem_image_t &mem_image = this->memory;
+    if (this->collecting_stats()) {
+        this->stats.store(segment_of(mem_image, addr));
+    }
+    if (this->tracing_memory()) {
+        this->mem_trace->record(this->registers.PC, addr, 4, value, true);
+    }
 
     mem_image.data_modified = true;
     if ((addr >= DATA_BOT) && (addr < mem_image.data_top) && !(addr & 0x3)) {
@@ -139,7 +257,10 @@ instruction *CPU::bad_text_read(mem_addr addr) {
     if (exception_raised) {
         this->registers.CP0_BadVAddr() = addr;
     }
-    return (inst_decode(0));
+    /* Decoded once: allocating per bad fetch would grow (or, if shared, copy) a text arena. */
+    static asm_arena_t arena;
+    static instruction *const nop = instruction::inst_decode(arena, 0);
+    return nop;
 }
 
 void CPU::bad_text_write(mem_addr addr, instruction *inst) {
@@ -261,10 +382,17 @@ void CPU::bad_mem_write(mem_addr addr, mem_word value, int mask) {
             }
         }
 
-        if (mem_image.text_seg[(addr - TEXT_BOT) >> 2] != nullptr) {
-            free_inst(mem_image.text_seg[(addr - TEXT_BOT) >> 2]);
+        /* arena() copies the segment first if another CPU shares it, after which the slot's
+           instruction is this CPU's own and can be decoded over in place: allocating a new one
+           per store would grow the arena without bound under self-modifying code. */
+        size_t slot = (addr - TEXT_BOT) >> 2;
+        asm_arena_t &arena = mem_image.text_seg.arena();
+        instruction *inst = mem_image.text_seg[slot];
+        if (inst == nullptr) {
+            mem_image.text_seg.set(slot, instruction::inst_decode(arena, tmp));
+        } else {
+            instruction::inst_redecode(inst, tmp);
         }
-        mem_image.text_seg[(addr - TEXT_BOT) >> 2] = inst_decode(tmp);
 
         mem_image.text_modified = true;
     } else if (addr > mem_image.data_top &&
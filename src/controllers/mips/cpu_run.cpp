@@ -44,6 +44,8 @@ bool NaN(double X) { return X != X; }
 #include <math.h>
 #include <stdio.h>
 
+#include <algorithm>
+
 #ifdef _WIN32
 #define VC_EXTRALEAN
 #include <Windows.h>
@@ -54,6 +56,7 @@ bool NaN(double X) { return X != X; }
 #include <sys/time.h>
 #endif
 
+#include "host_profile.h"
 #include "inst.h"
 #include "mem.h"
 #include "parser_yacc.h"
@@ -92,14 +95,12 @@ constexpr bool ARITH_OVFL(int32_t RESULT, int32_t OP1, int32_t OP2) {
 }
 
 bool CPU::run_spim(bool display) {
+    /* Per instruction rather than per run, so sampling started mid-run still sees DISPATCH. */
+    host_phase_scope phase(host_phase_t::DISPATCH, &this->registers.PC);
+
     // Initialize variables for use in lambas
     reg_image_t &reg_image = this->registers;
 
-    static reg_word *delayed_load_addr1 = nullptr;
-    static reg_word *delayed_load_addr2 = nullptr;
-    static reg_word delayed_load_value1 = 0;
-    static reg_word delayed_load_value2 = 0;
-
     reg_image.R[0] = 0; /* Maintain invariant value */
 
     /*
@@ -124,6 +125,9 @@ bool CPU::run_spim(bool display) {
     };
 
     auto BRANCH_INST = [=](bool TEST, mem_addr TARGET, bool NULLIFY) {
+        if (this->recording_branches()) {
+            this->memory.block_prof.branch(this->registers.PC, TARGET, TEST);
+        }
         if (TEST) {
             mem_addr target = TARGET;
             if (this->config.delayed_branches) {
@@ -143,12 +147,12 @@ bool CPU::run_spim(bool display) {
      * not available until the subsequent instruction has executed (as in the
      * real machine). We need a two element shift register for the value and its
      * destination, as the instruction following the load can itself be a load
-     * instruction.
+     * instruction. It lives in the register image, so that every CPU has its own.
      */
     auto LOAD_INST_BASE = [=](reg_word *DEST_A, reg_word VALUE) {
         if (this->config.delayed_loads) {
-            delayed_load_addr1 = (DEST_A);
-            delayed_load_value1 = (VALUE);
+            this->registers.delayed_load_dest1 = this->registers.offset_of(DEST_A);
+            this->registers.delayed_load_value1 = (VALUE);
         } else {
             *(DEST_A) = (VALUE);
         }
@@ -158,14 +162,37 @@ bool CPU::run_spim(bool display) {
         LOAD_INST_BASE(DEST_A, (LD & (MASK)));
     };
 
+    /* Jumps whose target depends on a register. */
+    auto INDIRECT_JUMP_INST = [=](mem_addr TARGET) {
+        if (this->profiling_exact()) {
+            this->memory.block_prof.transfer(this->registers.PC, TARGET, profile_edge_t::INDIRECT);
+        }
+        JUMP_INST(TARGET);
+    };
+
+    auto DIRECT_JUMP_INST = [=](mem_addr TARGET) {
+        if (this->recording_branches()) {
+            this->memory.block_prof.branch(this->registers.PC, TARGET, true);
+        }
+        JUMP_INST(TARGET);
+    };
+
+    /* Calls for the function profile; returns are found among the indirect jumps. */
+    auto CALL_INST = [=](bool TEST, mem_addr TARGET, mem_addr RETURN) {
+        if (this->profiling_calls() && TEST) {
+            this->call_prof.call(TARGET, RETURN);
+        }
+    };
+
     auto DO_DELAYED_UPDATE = [=]() {
         if (this->config.delayed_loads) { /* Check for delayed updates */
-            if (delayed_load_addr2 != nullptr) {
-                *delayed_load_addr2 = delayed_load_value2;
+            reg_image_t &regs = this->registers;
+            if (regs.delayed_load_dest2 != -1) {
+                *regs.at_offset(regs.delayed_load_dest2) = regs.delayed_load_value2;
             }
-            delayed_load_addr2 = delayed_load_addr1;
-            delayed_load_value2 = delayed_load_value1;
-            delayed_load_addr1 = nullptr;
+            regs.delayed_load_dest2 = regs.delayed_load_dest1;
+            regs.delayed_load_value2 = regs.delayed_load_value1;
+            regs.delayed_load_dest1 = -1;
         }
     };
 
@@ -194,6 +221,10 @@ bool CPU::run_spim(bool display) {
 
     DO_DELAYED_UPDATE();
 
+    if (this->collecting_stats()) {
+        this->stats.instruction(inst->OPCODE());
+    }
+
     switch (inst->OPCODE()) {
         case Y_ADD_OP: {
             reg_word vs = reg_image.R[inst->RS()], vt = reg_image.R[inst->RT()];
@@ -267,12 +298,14 @@ bool CPU::run_spim(bool display) {
         case Y_BGEZAL_OP: {
             reg_image.R[31] = reg_image.PC +
                               (this->config.delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD);
+            CALL_INST(SIGN_BIT(reg_image.R[inst->RS()]) == 0, reg_image.PC + inst->IDISP(), reg_image.R[31]);
             BRANCH_INST(SIGN_BIT(reg_image.R[inst->RS()]) == 0, reg_image.PC + inst->IDISP(), 0);
             break;
         }
         case Y_BGEZALL_OP: {
             reg_image.R[31] = reg_image.PC +
                               (this->config.delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD);
+            CALL_INST(SIGN_BIT(reg_image.R[inst->RS()]) == 0, reg_image.PC + inst->IDISP(), reg_image.R[31]);
             BRANCH_INST(SIGN_BIT(reg_image.R[inst->RS()]) == 0, reg_image.PC + inst->IDISP(), 1);
             break;
         }
@@ -307,6 +340,7 @@ bool CPU::run_spim(bool display) {
         case Y_BLTZAL_OP: {
             reg_image.R[31] = reg_image.PC +
                               (this->config.delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD);
+            CALL_INST(SIGN_BIT(reg_image.R[inst->RS()]) != 0, reg_image.PC + inst->IDISP(), reg_image.R[31]);
             BRANCH_INST(SIGN_BIT(reg_image.R[inst->RS()]) != 0, reg_image.PC + inst->IDISP(), 0);
             break;
         }
@@ -314,6 +348,7 @@ bool CPU::run_spim(bool display) {
         case Y_BLTZALL_OP: {
             reg_image.R[31] = reg_image.PC +
                               (this->config.delayed_branches ? 2 * BYTES_PER_WORD : BYTES_PER_WORD);
+            CALL_INST(SIGN_BIT(reg_image.R[inst->RS()]) != 0, reg_image.PC + inst->IDISP(), reg_image.R[31]);
             BRANCH_INST(SIGN_BIT(reg_image.R[inst->RS()]) != 0, reg_image.PC + inst->IDISP(), 1);
             break;
         }
@@ -421,12 +456,15 @@ bool CPU::run_spim(bool display) {
 
         case Y_ERET_OP: {
             reg_image.CP0_Status() &= ~CP0_Status_EXL; /* Clear EXL bit */
-            JUMP_INST(reg_image.CP0_EPC());            /* Jump to EPC */
+            if (this->profiling_calls()) {
+                this->call_prof.exception_return();
+            }
+            INDIRECT_JUMP_INST(reg_image.CP0_EPC()); /* Jump to EPC */
             break;
         }
 
         case Y_J_OP: {
-            JUMP_INST(((reg_image.PC & 0xf0000000) | inst->TARGET() << 2));
+            DIRECT_JUMP_INST(((reg_image.PC & 0xf0000000) | inst->TARGET() << 2));
             break;
         }
 
@@ -436,7 +474,8 @@ bool CPU::run_spim(bool display) {
             } else {
                 reg_image.R[31] = reg_image.PC + BYTES_PER_WORD;
             }
-            JUMP_INST(((reg_image.PC & 0xf0000000) | (inst->TARGET() << 2)));
+            CALL_INST(true, (reg_image.PC & 0xf0000000) | (inst->TARGET() << 2), reg_image.R[31]);
+            DIRECT_JUMP_INST(((reg_image.PC & 0xf0000000) | (inst->TARGET() << 2)));
             break;
         }
 
@@ -448,12 +487,16 @@ bool CPU::run_spim(bool display) {
             } else {
                 reg_image.R[inst->RD()] = reg_image.PC + BYTES_PER_WORD;
             }
-            JUMP_INST(tmp);
+            CALL_INST(true, tmp, reg_image.R[inst->RD()]);
+            INDIRECT_JUMP_INST(tmp);
         } break;
 
         case Y_JR_OP: {
             mem_addr tmp = reg_image.R[inst->RS()];
-            JUMP_INST(tmp);
+            if (this->profiling_calls()) {
+                this->call_prof.jump_register(tmp);
+            }
+            INDIRECT_JUMP_INST(tmp);
             break;
         }
 
@@ -1779,3 +1822,24 @@ void CPU::CLEAR_INTERRUPT(int32_t LEVEL) {
     /* Clear IP (pending) bit for interrupt level. */
     this->registers.CLEAR_INTERRUPT(LEVEL);
 }
+
+bool CPU::start_exec_trace(const std::string &path) {
+    if (!SPIMBOT_PROFILING || this->exec_trace != nullptr) {
+        return false;
+    }
+    int32_t registers[exec_trace_t::REGS];
+    std::copy(this->registers.R.begin(), this->registers.R.end(), registers);
+    registers[exec_trace_t::REG_HI] = this->registers.HI;
+    registers[exec_trace_t::REG_LO] = this->registers.LO;
+    this->exec_trace = exec_trace_t::open(path, registers, this->config.delayed_branches);
+    return this->exec_trace != nullptr;
+}
+
+bool CPU::stop_exec_trace() {
+    if (this->exec_trace == nullptr) {
+        return false;
+    }
+    bool ok = this->exec_trace->close(this->registers.R.data(), this->registers.HI, this->registers.LO);
+    this->exec_trace.reset();
+    return ok;
+}
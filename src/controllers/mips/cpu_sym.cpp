@@ -9,20 +9,20 @@ void CPU::resolve_a_label(label *sym, instruction *inst) {
 
 /**
  * Given a newly-defined LABEL, resolve the previously encountered
- * instructions and data locations that refer to the label.
+ * instructions and data locations that refer to the label, in one pass over its fixups.
  */
 void CPU::resolve_label_uses(label *sym) {
     mem_image_t &mem_image = this->memory;
 
-    for (auto &use : sym->uses) {
+    for (const label_use &use : sym->uses) {
         resolve_a_label_sub(sym, use.inst, use.addr);
         if (use.inst != nullptr && use.addr >= DATA_BOT && use.addr < mem_image.stack_bot) {
             set_mem_word(use.addr, use.inst->inst_encode());  // XXX: Replace
-            free_inst(use.inst);
         }
     }
 
-    sym->uses.clear();
+    /* A label is defined once, so give the fixup storage back rather than keeping capacity. */
+    std::vector<label_use>().swap(sym->uses);
 }
 
 void CPU::resolve_a_label_sub(label *sym, instruction *inst, mem_addr pc) {
@@ -108,7 +108,45 @@ void CPU::resolve_a_label_sub(label *sym, instruction *inst, mem_addr pc) {
             inst->SET_ENCODING(inst->inst_encode());
         } else {
             error("Resolving undefined symbol: %s\n",
-                  (inst->EXPR()->symbol == nullptr) ? "" : inst->EXPR()->symbol->name);
+                  (inst->EXPR()->symbol == nullptr) ? "" : inst->EXPR()->symbol->name.data());
         }
     }
-}
\ No newline at end of file
+}
+
+/* Name code addresses after the labels in the program's symbol table. */
+symbolizer_t CPU::code_symbols() const {
+    const SymbolTable &table = this->program_image != nullptr ? *this->program_image->symbol_table
+                                                              : this->symbol_table;
+    symbolizer_t symbols;
+    table.for_each_defined_label([&](const label &l) {
+        if (l.addr < DATA_BOT || (l.addr >= K_TEXT_BOT && l.addr < K_DATA_BOT)) {
+            symbols.add(l.addr, l.name);
+        }
+    });
+    return symbols;
+}
+
+/* Write the function profile. */
+bool CPU::dump_call_profile(const std::string &folded_file_name, const std::string &summary_file_name) {
+    if (!this->profiling_calls()) {
+        return false;
+    }
+
+    symbolizer_t symbols = this->code_symbols();
+    FILE *folded = fopen(folded_file_name.c_str(), "w");
+    if (folded == nullptr) {
+        return false;
+    }
+    this->call_prof.write_folded(folded, symbols);
+    bool ok = fclose(folded) == 0;
+
+    if (!summary_file_name.empty()) {
+        FILE *summary = fopen(summary_file_name.c_str(), "w");
+        if (summary == nullptr) {
+            return false;
+        }
+        this->call_prof.write_summary(summary, symbols);
+        ok = fclose(summary) == 0 && ok;
+    }
+    return ok;
+}
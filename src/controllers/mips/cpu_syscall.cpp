@@ -43,6 +43,7 @@
 #endif
 
 #include "cpu.h"
+#include "host_profile.h"
 #include "inst.h"
 #include "mem.h"
 #include "reg.h"
@@ -99,6 +100,8 @@ mem_addr last_exception_addr;
    exit syscall and non-zero to continue execution. */
 
 int CPU::do_syscall() {
+    host_phase_scope phase(host_phase_t::SYSCALL);
+
 #ifdef _WIN32
     windowsParameterHandlingControl(0);
 #endif
@@ -135,7 +138,7 @@ int CPU::do_syscall() {
             break;
         }
         case Syscall::READ_INT: {
-            static char str[256];
+            char str[256] = {};
 
             read_input(str, 256);
             reg_image.R[REG_RES] = atol(str);
@@ -143,7 +146,7 @@ int CPU::do_syscall() {
         }
 
         case Syscall::READ_FLOAT: {
-            static char str[256];
+            char str[256] = {};
 
             read_input(str, 256);
             reg_image.SET_FPR_S(REG_FRES, (float)atof(str));
@@ -151,7 +154,7 @@ int CPU::do_syscall() {
         }
 
         case Syscall::READ_DOUBLE: {
-            static char str[256];
+            char str[256] = {};
 
             read_input(str, 256);
             reg_image.FPR[REG_FRES] = atof(str);
@@ -178,7 +181,7 @@ int CPU::do_syscall() {
             break;
         }
         case Syscall::READ_CHARACTER: {
-            static char str[2];
+            char str[2] = {};
 
             read_input(str, 2);
             if (*str == '\0') {
@@ -280,6 +283,7 @@ int CPU::do_syscall() {
 }
 
 void CPU::handle_exception() {
+    host_phase_scope phase(host_phase_t::EXCEPTION);
     reg_image_t &reg_image = this->registers;
     if (this->should_fail_on_exception && reg_image.CP0_ExCode() != ExcCode_Int) {
         this->done = true;
@@ -291,6 +295,12 @@ void CPU::handle_exception() {
     }
 
     reg_image.exception_occurred = false;
+    if (this->profiling_exact()) {
+        this->memory.block_prof.transfer(last_exception_addr, EXCEPTION_ADDR, profile_edge_t::EXCEPTION);
+    }
+    if (this->profiling_calls()) {
+        this->call_prof.exception(EXCEPTION_ADDR);
+    }
     reg_image.PC = EXCEPTION_ADDR;
 
     switch (reg_image.CP0_ExCode()) {
@@ -0,0 +1,77 @@
+#include "exec_stats.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+const char *const SEGMENT_NAMES[] = {"text", "data", "stack", "k_text", "k_data", "special", "mmio", "unmapped"};
+static_assert(sizeof(SEGMENT_NAMES) / sizeof(SEGMENT_NAMES[0]) == static_cast<size_t>(mem_segment_t::COUNT),
+              "a name for every mem_segment_t");
+
+void write_segments(FILE *out, const char *key, const uint64_t *counts) {
+    fprintf(out, "  \"%s\": {", key);
+    for (size_t i = 0; i < static_cast<size_t>(mem_segment_t::COUNT); ++i) {
+        fprintf(out, "%s\"%s\": %llu", i == 0 ? "" : ", ", SEGMENT_NAMES[i], (unsigned long long)counts[i]);
+    }
+    fprintf(out, "},\n");
+}
+
+}  // namespace
+
+void exec_stats_t::reset() {
+    this->opcodes.clear();
+    std::fill(std::begin(this->loads), std::end(this->loads), 0);
+    std::fill(std::begin(this->stores), std::end(this->stores), 0);
+}
+
+void exec_stats_t::write_json(FILE *out, const std::vector<branch_site_t> &branches,
+                              const char *(*name)(int)) const {
+    std::vector<std::pair<int, uint64_t>> executed;
+    uint64_t total = 0;
+    for (size_t op = 0; op < this->opcodes.size(); ++op) {
+        if (this->opcodes[op] != 0) {
+            executed.emplace_back(static_cast<int>(op), this->opcodes[op]);
+            total += this->opcodes[op];
+        }
+    }
+    std::stable_sort(executed.begin(), executed.end(),
+                     [](const auto &a, const auto &b) { return a.second > b.second; });
+
+    /* Opcodes the table does not know are keyed by number, so that no count is lost. */
+    auto mnemonic = [&](int opcode, char *buffer, size_t size) {
+        const char *n = opcode < 0 ? "?" : name(opcode);
+        if (n == nullptr) {
+            snprintf(buffer, size, "op%d", opcode);
+            return static_cast<const char *>(buffer);
+        }
+        return n;
+    };
+    char buffer[16];
+
+    fprintf(out, "{\n  \"instructions\": %llu,\n  \"opcodes\": {", (unsigned long long)total);
+    for (size_t i = 0; i < executed.size(); ++i) {
+        fprintf(out, "%s\n    \"%s\": %llu", i == 0 ? "" : ",", mnemonic(executed[i].first, buffer, sizeof(buffer)),
+                (unsigned long long)executed[i].second);
+    }
+    fprintf(out, "%s},\n", executed.empty() ? "" : "\n  ");
+
+    write_segments(out, "loads", this->loads);
+    write_segments(out, "stores", this->stores);
+
+    std::vector<branch_site_t> sites = branches;
+    std::stable_sort(sites.begin(), sites.end(), [](const branch_site_t &a, const branch_site_t &b) {
+        return a.taken + a.not_taken > b.taken + b.not_taken;
+    });
+    fprintf(out, "  \"branches\": [");
+    for (size_t i = 0; i < sites.size(); ++i) {
+        const branch_site_t &b = sites[i];
+        fprintf(out,
+                "%s\n    {\"pc\": \"0x%08x\", \"opcode\": \"%s\", \"target\": \"0x%08x\", \"taken\": %llu, "
+                "\"not_taken\": %llu}",
+                i == 0 ? "" : ",", b.pc, mnemonic(b.opcode, buffer, sizeof(buffer)), b.target,
+                (unsigned long long)b.taken, (unsigned long long)b.not_taken);
+    }
+    fprintf(out, "%s]\n}\n", sites.empty() ? "" : "\n  ");
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#ifndef EXEC_STATS_H
+#define EXEC_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "spim.h"
+
+/* Where a load or store went. */
+enum class mem_segment_t : uint8_t {
+    TEXT,
+    DATA,
+    STACK,
+    K_TEXT,
+    K_DATA,
+    SPECIAL,
+    MMIO,
+    UNMAPPED, /* Anything else; becomes an exception */
+    COUNT,
+};
+
+/* One branch site's outcomes, for exec_stats_t::write_json. */
+struct branch_site_t {
+    mem_addr pc;
+    mem_addr target;
+    int opcode; /* -1 if the site no longer holds an instruction */
+    uint64_t taken;
+    uint64_t not_taken;
+};
+
+/**
+ * Counters for tuning the interpreter: instructions executed per opcode, and loads and stores
+ * per memory segment. Every update is one increment into a flat array that stays in L1 (a few
+ * hundred opcodes), so the counters are cheap enough to leave on for whole tournament runs.
+ * Branch outcomes per site come from block_profile_t's dense site table, which the CPU fills
+ * while these counters are on.
+ */
+class exec_stats_t {
+   public:
+    void reset();
+
+    /* OPCODE is an instruction's int16_t opcode, so the table never outgrows 32K entries. */
+    void instruction(int16_t opcode) {
+        if (opcode < 0) {
+            return;
+        }
+        if (static_cast<size_t>(opcode) >= this->opcodes.size()) {
+            this->opcodes.resize(static_cast<size_t>(opcode) + 1);
+        }
+        ++this->opcodes[opcode];
+    }
+
+    void load(mem_segment_t segment) { ++this->loads[static_cast<size_t>(segment)]; }
+    void store(mem_segment_t segment) { ++this->stores[static_cast<size_t>(segment)]; }
+
+    /* Everything as one JSON object, opcodes and branch sites by count. NAME gives an opcode's
+       mnemonic (opcode_name), or nullptr for one it does not know. */
+    void write_json(FILE *out, const std::vector<branch_site_t> &branches, const char *(*name)(int)) const;
+
+   private:
+    std::vector<uint64_t> opcodes;
+    uint64_t loads[static_cast<size_t>(mem_segment_t::COUNT)] = {};
+    uint64_t stores[static_cast<size_t>(mem_segment_t::COUNT)] = {};
+};
+
+#endif
@@ -0,0 +1,204 @@
+#include "exec_trace.h"
+
+#include <string.h>
+
+namespace {
+
+constexpr char TRACE_MAGIC[4] = {'S', 'P', 'X', 'T'};
+constexpr uint32_t TRACE_VERSION = 1;
+constexpr uint32_t FLAG_DELAYED_BRANCHES = 0x1;
+
+constexpr size_t FLUSH_SIZE = 64 * 1024;
+constexpr uint32_t WRITES_FOLLOW = 3;
+
+void put32(std::vector<unsigned char> &out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+    }
+}
+
+void put_varint(std::vector<unsigned char> &out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+uint32_t zigzag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+
+int32_t unzigzag(uint32_t v) { return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1); }
+
+bool get32(FILE *file, uint32_t &v) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, file) != 4) {
+        return false;
+    }
+    v = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+    return true;
+}
+
+bool get_varint(FILE *file, uint64_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = getc(file);
+        if (byte == EOF) {
+            return false;
+        }
+        v |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+std::unique_ptr<exec_trace_t> exec_trace_t::open(const std::string &path, const int32_t *registers,
+                                                  bool delayed_branches) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return nullptr;
+    }
+    std::unique_ptr<exec_trace_t> trace(new exec_trace_t(file, registers));
+    std::vector<unsigned char> &header = trace->buffer;
+    header.insert(header.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+    put32(header, TRACE_VERSION);
+    put32(header, delayed_branches ? FLAG_DELAYED_BRANCHES : 0);
+    for (size_t r = 0; r < REGS; ++r) {
+        put32(header, static_cast<uint32_t>(registers[r]));
+    }
+    return trace;
+}
+
+exec_trace_t::exec_trace_t(FILE *file, const int32_t *registers) : file(file) {
+    memcpy(this->shadow, registers, sizeof(this->shadow));
+    this->buffer.reserve(FLUSH_SIZE + 256);
+}
+
+exec_trace_t::~exec_trace_t() { this->close(this->shadow, this->shadow[REG_HI], this->shadow[REG_LO]); }
+
+void exec_trace_t::record(const int32_t *gpr, int32_t hi, int32_t lo) {
+    uint8_t regs[REGS];
+    int32_t deltas[REGS];
+    uint32_t writes = 0;
+    for (uint8_t r = 1; r < 32; ++r) {
+        if (gpr[r] != this->shadow[r]) {
+            regs[writes] = r;
+            deltas[writes++] = static_cast<int32_t>(static_cast<uint32_t>(gpr[r]) - this->shadow[r]);
+            this->shadow[r] = gpr[r];
+        }
+    }
+    if (hi != this->shadow[REG_HI]) {
+        regs[writes] = REG_HI;
+        deltas[writes++] = static_cast<int32_t>(static_cast<uint32_t>(hi) - this->shadow[REG_HI]);
+        this->shadow[REG_HI] = hi;
+    }
+    if (lo != this->shadow[REG_LO]) {
+        regs[writes] = REG_LO;
+        deltas[writes++] = static_cast<int32_t>(static_cast<uint32_t>(lo) - this->shadow[REG_LO]);
+        this->shadow[REG_LO] = lo;
+    }
+
+    uint32_t pc_delta = zigzag(static_cast<int32_t>(this->pc - this->next_pc));
+    put_varint(this->buffer, (uint64_t)pc_delta << 2 | (writes < WRITES_FOLLOW ? writes : WRITES_FOLLOW));
+    if (writes >= WRITES_FOLLOW) {
+        put_varint(this->buffer, writes);
+    }
+    for (uint32_t i = 0; i < writes; ++i) {
+        this->buffer.push_back(regs[i]);
+        put_varint(this->buffer, zigzag(deltas[i]));
+    }
+    this->next_pc = this->pc + 4;
+
+    if (this->buffer.size() >= FLUSH_SIZE) {
+        this->flush();
+    }
+}
+
+void exec_trace_t::flush() {
+    if (!this->failed && fwrite(this->buffer.data(), 1, this->buffer.size(), this->file) != this->buffer.size()) {
+        this->failed = true;
+    }
+    this->buffer.clear();
+}
+
+bool exec_trace_t::close(const int32_t *gpr, int32_t hi, int32_t lo) {
+    if (this->file == nullptr) {
+        return !this->failed;
+    }
+    if (this->pending) {
+        this->record(gpr, hi, lo);
+        this->pending = false;
+    }
+    this->flush();
+    if (fclose(this->file) != 0) {
+        this->failed = true;
+    }
+    this->file = nullptr;
+    return !this->failed;
+}
+
+exec_trace_reader_t::~exec_trace_reader_t() {
+    if (this->file != nullptr) {
+        fclose(this->file);
+    }
+}
+
+bool exec_trace_reader_t::open(const std::string &path) {
+    if (this->file != nullptr) {
+        fclose(this->file);
+    }
+    this->file = fopen(path.c_str(), "rb");
+    if (this->file == nullptr) {
+        return false;
+    }
+
+    char magic[sizeof(TRACE_MAGIC)];
+    uint32_t version;
+    if (fread(magic, 1, sizeof(magic), this->file) != sizeof(magic) ||
+        memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0 || !get32(this->file, version) ||
+        version != TRACE_VERSION || !get32(this->file, this->flags)) {
+        return false;
+    }
+    for (size_t r = 0; r < exec_trace_t::REGS; ++r) {
+        uint32_t value;
+        if (!get32(this->file, value)) {
+            return false;
+        }
+        this->regs[r] = static_cast<int32_t>(value);
+    }
+    this->next_pc = 0;
+    return true;
+}
+
+bool exec_trace_reader_t::next(exec_step_t &step) {
+    uint64_t head, writes;
+    if (this->file == nullptr || !get_varint(this->file, head)) {
+        return false;
+    }
+    writes = head & WRITES_FOLLOW;
+    if (writes == WRITES_FOLLOW && !get_varint(this->file, writes)) {
+        return false;
+    }
+    if (writes > exec_trace_t::REGS) {
+        return false;
+    }
+
+    step.pc = this->next_pc + unzigzag(static_cast<uint32_t>(head >> 2));
+    step.writes = writes;
+    for (size_t i = 0; i < writes; ++i) {
+        int reg = getc(this->file);
+        uint64_t delta;
+        if (reg == EOF || reg >= static_cast<int>(exec_trace_t::REGS) || !get_varint(this->file, delta)) {
+            return false;
+        }
+        step.reg[i] = static_cast<uint8_t>(reg);
+        step.value[i] = static_cast<int32_t>(static_cast<uint32_t>(this->regs[reg]) +
+                                             static_cast<uint32_t>(unzigzag(static_cast<uint32_t>(delta))));
+        this->regs[reg] = step.value[i];
+    }
+    this->next_pc = step.pc + 4;
+    return true;
+}
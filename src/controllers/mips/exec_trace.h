@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef EXEC_TRACE_H
+#define EXEC_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Binary instruction-level trace: the PC of every instruction executed and the registers it
+ * wrote, for post-mortems of whole matches. The cheap replacement for run_spim's DISPLAY flag,
+ * which formats every instruction as text; disassembly happens offline instead (tools/trace_dis),
+ * against the program's symbol table.
+ *
+ * The CPU calls step() before each instruction. step() compares the general registers, HI and
+ * LO with a shadow copy, which attributes every write (including delayed loads and exception
+ * handling) to the instruction that was current. With delayed branches, a taken branch and its
+ * delay slot are one step. Floating-point and coprocessor 0 registers are not shadowed, so writes
+ * to them (mtc1, lwc1, FP arithmetic, mtc0, exception entry's Cause/EPC/BadVAddr) do not appear;
+ * the trace still has their PCs, and where they move a value into a general register (mfc1, mfc0)
+ * that write is recorded.
+ *
+ * File format, little-endian: "SPXT", u32 version, u32 flags (bit 0: delayed branches), the 34
+ * registers (0-31, HI, LO) as they were when the trace started as u32s, then one record per
+ * instruction: a LEB128 varint holding the zigzagged difference between the PC and the one after
+ * the previous instruction's, shifted left 2 and or'ed with the number of register writes (3
+ * meaning "3 or more, count follows as a varint"), then per write a register number byte and the
+ * zigzagged difference from its old value as a varint. Straight-line code costs 3-4 bytes per
+ * instruction. Records are self-delimiting, so a trace cut short by a crash decodes up to its last
+ * complete record.
+ *
+ * Uses only fixed-width types, so that offline tools can build the reader without the core.
+ */
+
+class exec_trace_t {
+   public:
+    static constexpr size_t REGS = 34; /* 0-31 general registers, HI, LO */
+    static constexpr uint8_t REG_HI = 32;
+    static constexpr uint8_t REG_LO = 33;
+
+    /* Create PATH with REGISTERS (REGS values) as the starting state; nullptr if it cannot be
+       created. */
+    static std::unique_ptr<exec_trace_t> open(const std::string &path, const int32_t *registers,
+                                              bool delayed_branches);
+
+    /* Stops the trace if close() was not called. */
+    ~exec_trace_t();
+
+    exec_trace_t(const exec_trace_t &) = delete;
+    exec_trace_t &operator=(const exec_trace_t &) = delete;
+
+    /* Before executing the instruction at PC: record the previous instruction with whatever it
+       left in GPR (32 registers), HI and LO. */
+    void step(uint32_t pc, const int32_t *gpr, int32_t hi, int32_t lo) {
+        if (this->pending) {
+            this->record(gpr, hi, lo);
+        }
+        this->pending = true;
+        this->pc = pc;
+    }
+
+    /* Record the last instruction, flush and close the file. False if any write failed. */
+    bool close(const int32_t *gpr, int32_t hi, int32_t lo);
+
+   private:
+    explicit exec_trace_t(FILE *file, const int32_t *registers);
+
+    void record(const int32_t *gpr, int32_t hi, int32_t lo);
+    void flush();
+
+    FILE *file;
+    std::vector<unsigned char> buffer;
+    bool failed = false;
+
+    int32_t shadow[REGS];
+    bool pending = false;
+    uint32_t pc = 0;
+    uint32_t next_pc = 0; /* PC after the previously recorded instruction */
+};
+
+/* One instruction read back from a trace. */
+struct exec_step_t {
+    uint32_t pc;
+    size_t writes; /* Entries of REG and VALUE in use */
+    uint8_t reg[exec_trace_t::REGS];
+    int32_t value[exec_trace_t::REGS]; /* New values */
+};
+
+/* Reads a trace written by exec_trace_t, one instruction at a time. */
+class exec_trace_reader_t {
+   public:
+    ~exec_trace_reader_t();
+
+    /* False if PATH is missing or not a trace. */
+    bool open(const std::string &path);
+
+    /* The next instruction; false at the end of the trace or a truncated record. */
+    bool next(exec_step_t &step);
+
+    bool delayed_branches() const { return this->flags & 0x1; }
+
+    /* All registers as of the last step read (or the start of the trace). */
+    const int32_t *registers() const { return this->regs; }
+
+   private:
+    FILE *file = nullptr;
+    uint32_t flags = 0;
+    int32_t regs[exec_trace_t::REGS] = {};
+    uint32_t next_pc = 0;
+};
+
+#endif
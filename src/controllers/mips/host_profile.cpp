@@ -0,0 +1,162 @@
+#include "host_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#endif
+
+thread_local const host_context_t *volatile host_thread_context = nullptr;
+
+std::atomic<bool> host_profile::running{false};
+
+namespace {
+
+const char *const PHASE_NAMES[] = {"engine", "dispatch", "memory", "syscall", "exception"};
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == static_cast<size_t>(host_phase_t::COUNT),
+              "a name for every host_phase_t");
+
+/**
+ * (phase, guest PC) histogram filled from the signal handler: open addressing with atomic keys,
+ * so samples on several threads at once need no lock. A key is phase << 32 | PC, plus one so
+ * that 0 marks an empty slot. Samples that find the table full are only counted in DROPPED.
+ */
+constexpr size_t SLOTS = 1 << 16;
+std::atomic<uint64_t> keys[SLOTS];
+std::atomic<uint64_t> counts[SLOTS];
+std::atomic<uint64_t> dropped{0};
+
+void record(uint64_t key) {
+    size_t slot = (key * 0x9e3779b97f4a7c15ull) >> 48;
+    for (size_t probes = 0; probes < SLOTS; ++probes, slot = (slot + 1) & (SLOTS - 1)) {
+        uint64_t found = keys[slot].load(std::memory_order_relaxed);
+        if (found == 0 && keys[slot].compare_exchange_strong(found, key, std::memory_order_relaxed)) {
+            found = key;
+        }
+        if (found == key) {
+            counts[slot].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifndef _WIN32
+struct sigaction previous_action;
+
+void on_sigprof(int) {
+    const host_context_t *context = host_thread_context;
+    std::atomic_signal_fence(std::memory_order_acquire);
+    if (context == nullptr) {
+        record(((uint64_t)host_phase_t::ENGINE << 32) + 1);
+        return;
+    }
+    mem_addr pc = context->guest_pc != nullptr ? *context->guest_pc : 0;
+    record(((uint64_t)context->phase << 32 | pc) + 1);
+}
+#endif
+
+}  // namespace
+
+namespace host_profile {
+
+bool start(unsigned hz) {
+#ifdef _WIN32
+    (void)hz;
+    return false;
+#else
+    if (hz == 0 || running.exchange(true)) {
+        return false;
+    }
+    for (size_t i = 0; i < SLOTS; ++i) {
+        keys[i].store(0, std::memory_order_relaxed);
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    dropped.store(0, std::memory_order_relaxed);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_sigprof;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_sec = hz == 1 ? 1 : 0;
+    timer.it_interval.tv_usec = hz == 1 ? 0 : 1000000 / hz;
+    timer.it_value = timer.it_interval;
+
+    if (sigaction(SIGPROF, &action, &previous_action) != 0) {
+        running = false;
+        return false;
+    }
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        sigaction(SIGPROF, &previous_action, nullptr);
+        running = false;
+        return false;
+    }
+    return true;
+#endif
+}
+
+void stop() {
+#ifndef _WIN32
+    if (!running) {
+        return;
+    }
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sigaction(SIGPROF, &previous_action, nullptr);
+    running = false;
+#endif
+}
+
+void write(FILE *out, const symbolizer_t &symbols) {
+    struct entry_t {
+        host_phase_t phase;
+        mem_addr pc;
+        uint64_t count;
+    };
+    std::vector<entry_t> entries;
+    uint64_t phase_totals[static_cast<size_t>(host_phase_t::COUNT)] = {};
+    uint64_t total = 0;
+    for (size_t i = 0; i < SLOTS; ++i) {
+        uint64_t key = keys[i].load(std::memory_order_relaxed);
+        uint64_t count = counts[i].load(std::memory_order_relaxed);
+        if (key == 0 || count == 0) {
+            continue;
+        }
+        auto phase = static_cast<host_phase_t>((key - 1) >> 32);
+        entries.push_back({phase, static_cast<mem_addr>(key - 1), count});
+        phase_totals[static_cast<size_t>(phase)] += count;
+        total += count;
+    }
+    std::sort(entries.begin(), entries.end(), [](const entry_t &a, const entry_t &b) {
+        return a.count != b.count ? a.count > b.count : a.pc < b.pc;
+    });
+
+    auto percent = [&](uint64_t count) { return total == 0 ? 0.0 : 100.0 * count / total; };
+    fprintf(out, "phase\tsamples\tpercent\n");
+    for (size_t p = 0; p < static_cast<size_t>(host_phase_t::COUNT); ++p) {
+        fprintf(out, "%s\t%llu\t%.2f\n", PHASE_NAMES[p], (unsigned long long)phase_totals[p],
+                percent(phase_totals[p]));
+    }
+    if (dropped != 0) {
+        fprintf(out, "dropped\t%llu\t-\n", (unsigned long long)dropped.load());
+    }
+
+    fprintf(out, "\nphase\tguest_pc\tsymbol\tsamples\tpercent\n");
+    for (const entry_t &e : entries) {
+        std::string name = e.pc == 0 ? "-" : symbols.name(e.pc);
+        fprintf(out, "%s\t0x%08x\t%s\t%llu\t%.2f\n", PHASE_NAMES[static_cast<size_t>(e.phase)], e.pc, name.c_str(),
+                (unsigned long long)e.count, percent(e.count));
+    }
+}
+
+}  // namespace host_profile
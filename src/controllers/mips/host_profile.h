@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef HOST_PROFILE_H
+#define HOST_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+
+#include "call_profile.h"
+#include "config.h"
+#include "spim.h"
+
+/**
+ * Sampling profiler for the host process, attributing each sample both to what the host was
+ * doing and to the guest instruction being run.
+ *
+ * Interpreter entry points mark the thread's current phase with a host_phase_scope. When no
+ * sampling is running that costs a load of a global flag and an untaken branch; otherwise it
+ * saves and sets the thread-local context. CPU::run_spim opens a DISPATCH scope for every
+ * instruction, so a run that was already going when sampling started is attributed from its next
+ * instruction on. While sampling, SIGPROF fires every 1/HZ seconds of process CPU time; the
+ * handler reads the interrupted thread's phase and guest PC and bumps a lock-free (phase, PC)
+ * histogram. The joint histogram shows, for example, which guest
+ * loads spend their time in the slow memory paths.
+ *
+ * Sampling is process-wide (one interval timer); threads outside the interpreter are counted as
+ * ENGINE. Only available where setitimer and SIGPROF are (not on Windows).
+ */
+
+enum class host_phase_t : uint8_t {
+    ENGINE,    /* Outside the interpreter: the embedding engine, UI or tooling */
+    DISPATCH,  /* Fetching, decoding and executing instructions (CPU::run_spim) */
+    MEMORY,    /* Data loads and stores (cpu_mem.cpp) */
+    SYSCALL,   /* CPU::do_syscall */
+    EXCEPTION, /* CPU::handle_exception */
+    COUNT,
+};
+
+/* What the SIGPROF handler reads for the thread it interrupted. */
+struct host_context_t {
+    host_phase_t phase;
+    const volatile mem_addr *guest_pc; /* PC of the CPU this thread is running, or nullptr */
+};
+
+/* The innermost host_phase_scope's context, or nullptr (ENGINE, no guest PC) outside them all.
+   Switching contexts is one pointer store, so the handler never sees a phase paired with
+   another scope's PC. */
+extern thread_local const host_context_t *volatile host_thread_context;
+
+namespace host_profile {
+
+/* Whether sampling is running; host_phase_scope does nothing while it is not. */
+extern std::atomic<bool> running;
+
+}  // namespace host_profile
+
+/* Marks the calling thread as being in PHASE (and running the CPU whose PC is at GUEST_PC, or
+   the enclosing scope's CPU if GUEST_PC is nullptr) for the scope's lifetime, if sampling was
+   running when the scope began. Compiles to nothing without SPIMBOT_PROFILING. */
+class host_phase_scope {
+   public:
+    explicit host_phase_scope(host_phase_t phase, const mem_addr *guest_pc = nullptr) {
+#if SPIMBOT_PROFILING
+        this->active = host_profile::running.load(std::memory_order_relaxed);
+        if (this->active) {
+            this->saved = host_thread_context;
+            this->context.phase = phase;
+            this->context.guest_pc =
+                guest_pc != nullptr ? guest_pc : this->saved != nullptr ? this->saved->guest_pc : nullptr;
+            /* The handler runs on this thread: the context must be complete before it is seen. */
+            std::atomic_signal_fence(std::memory_order_release);
+            host_thread_context = &this->context;
+        }
+#else
+        (void)phase;
+        (void)guest_pc;
+#endif
+    }
+
+    ~host_phase_scope() {
+#if SPIMBOT_PROFILING
+        if (this->active) {
+            host_thread_context = this->saved;
+        }
+#endif
+    }
+
+    host_phase_scope(const host_phase_scope &) = delete;
+    host_phase_scope &operator=(const host_phase_scope &) = delete;
+
+   private:
+#if SPIMBOT_PROFILING
+    bool active;
+    host_context_t context;
+    const host_context_t *saved;
+#endif
+};
+
+namespace host_profile {
+
+/* Start sampling HZ times per second of CPU time, clearing earlier samples. False if sampling is
+   already running, HZ is 0 or the platform has no SIGPROF. */
+bool start(unsigned hz);
+
+/* Stop sampling; the samples stay available to write(). */
+void stop();
+
+/* Per-phase totals, then the (phase, guest PC) histogram by sample count, tab-separated. Guest
+   PCs are named by SYMBOLS. */
+void write(FILE *out, const symbolizer_t &symbols);
+
+}  // namespace host_profile
+
+#endif
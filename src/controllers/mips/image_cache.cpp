@@ -0,0 +1,388 @@
+#include "image_cache.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+#include "inst.h"
+#include "sym-tbl.h"
+#include "util/hash.h"
+
+/*
+ * Object file layout (all fields little-endian, every section 4-byte aligned):
+ *
+ *   image_file_header
+ *   text presence bitmap   (text_words + 31) / 32 words, bit set => slot holds an instruction
+ *   text encodings         text_words words
+ *   k_text presence bitmap, k_text encodings
+ *   data                   data_words words (trailing zero words are not stored)
+ *   k_data                 k_data_words words
+ *   symbols                num_symbols image_symbol records
+ *   source line map        num_lines image_line records
+ *   strings                strings_size bytes of NUL-terminated names and source lines
+ */
+
+namespace {
+
+constexpr char IMAGE_MAGIC[8] = {'S', 'P', 'I', 'M', 'I', 'M', 'G', '\0'};
+constexpr uint32_t IMAGE_VERSION = 1;
+
+/* Kernel text slots in the line map have this bit set. */
+constexpr uint32_t LINE_IN_KERNEL = 0x80000000u;
+
+constexpr uint32_t SYM_GLOBAL = 0x1;
+constexpr uint32_t SYM_GP = 0x2;
+constexpr uint32_t SYM_CONST = 0x4;
+
+struct image_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t key;
+
+    uint32_t text_top, k_text_top, data_top, k_data_top, gp_midpoint;
+    uint32_t next_text_pc, next_k_text_pc, next_data_pc, next_k_data_pc, next_gp_item_addr;
+
+    /* Full segment sizes, in words, and how many leading words are stored. */
+    uint32_t text_slots, text_words;
+    uint32_t k_text_slots, k_text_words;
+    uint32_t data_slots, data_words;
+    uint32_t k_data_slots, k_data_words;
+
+    uint32_t num_symbols, num_lines, strings_size;
+    uint32_t payload_crc; /* CRC-32 of everything after the header */
+};
+
+struct image_symbol {
+    uint32_t name;
+    uint32_t addr;
+    uint32_t flags;
+};
+
+struct image_line {
+    uint32_t slot;
+    uint32_t text;
+};
+
+/* Index one past the last non-null instruction. */
+uint32_t used_slots(const text_segment_t &seg) {
+    size_t n = seg.size();
+    while (n > 0 && seg[n - 1] == nullptr) {
+        --n;
+    }
+    return n;
+}
+
+uint32_t used_words(const std::vector<mem_word> &seg) {
+    size_t n = seg.size();
+    while (n > 0 && seg[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+template <typename T>
+void append(std::vector<char> &out, const T *data, size_t count) {
+    const char *bytes = reinterpret_cast<const char *>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+class string_pool {
+   public:
+    uint32_t add(const char *str) {
+        auto it = offsets.find(str);
+        if (it != offsets.end()) {
+            return it->second;
+        }
+        uint32_t offset = bytes.size();
+        bytes.insert(bytes.end(), str, str + strlen(str) + 1);
+        offsets.emplace(str, offset);
+        return offset;
+    }
+
+    std::vector<char> bytes;
+
+   private:
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+void append_text(std::vector<char> &out, const text_segment_t &seg, uint32_t words,
+                 uint32_t kernel_bit, std::vector<image_line> &lines, string_pool &strings) {
+    std::vector<uint32_t> present((words + 31) / 32, 0);
+    std::vector<int32_t> encodings(words, 0);
+
+    for (uint32_t i = 0; i < words; ++i) {
+        const instruction *inst = seg[i];
+        if (inst == nullptr) {
+            continue;
+        }
+        present[i / 32] |= 1u << (i % 32);
+        encodings[i] = inst->encoding;
+        if (inst->source_line != nullptr) {
+            lines.push_back({i | kernel_bit, strings.add(inst->source_line)});
+        }
+    }
+    append(out, present.data(), present.size());
+    append(out, encodings.data(), encodings.size());
+}
+
+/* Bounds-checked reader over the mapped payload. */
+class section_reader {
+   public:
+    section_reader(const char *begin, const char *end) : cur(begin), end(end) {}
+
+    template <typename T>
+    const T *take(size_t count) {
+        size_t size = count * sizeof(T);
+        if ((size_t)(end - cur) < size) {
+            ok = false;
+            return nullptr;
+        }
+        const T *result = reinterpret_cast<const T *>(cur);
+        cur += size;
+        return result;
+    }
+
+    bool ok = true;
+
+   private:
+    const char *cur;
+    const char *end;
+};
+
+bool load_text(section_reader &in, text_segment_t &seg, uint32_t slots, uint32_t words) {
+    const uint32_t *present = in.take<uint32_t>((words + 31) / 32);
+    const int32_t *encodings = in.take<int32_t>(words);
+    if (!in.ok || words > slots) {
+        return false;
+    }
+
+    seg.reset(slots);
+
+    /* Decode each run of present words in one batch. */
+    std::vector<instruction *> decoded;
+    uint32_t i = 0;
+    while (i < words) {
+        if (!(present[i / 32] & (1u << (i % 32)))) {
+            ++i;
+            continue;
+        }
+        uint32_t end = i + 1;
+        while (end < words && (present[end / 32] & (1u << (end % 32)))) {
+            ++end;
+        }
+        decoded.resize(end - i);
+        instruction::inst_decode_block(seg.arena(), encodings + i, end - i, decoded.data());
+        for (uint32_t j = i; j < end; ++j) {
+            seg.set(j, decoded[j - i]);
+        }
+        i = end;
+    }
+    return true;
+}
+
+bool load_data(section_reader &in, std::vector<mem_word> &seg, uint32_t slots, uint32_t words) {
+    const mem_word *data = in.take<mem_word>(words);
+    if (!in.ok || words > slots) {
+        return false;
+    }
+    seg.assign(slots, 0);
+    std::copy(data, data + words, seg.begin());
+    return true;
+}
+
+}  // namespace
+
+ImageCache::ImageCache(std::string directory) : directory(std::move(directory)) {}
+
+std::string ImageCache::path_for(uint64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.spimg", (unsigned long long)key);
+    return this->directory + "/" + name;
+}
+
+std::optional<uint64_t> ImageCache::key(const std::vector<std::string> &sources, const CPUConfig &config) {
+    uint64_t hash = util::fnv1a_64(IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    hash = util::fnv1a_64(&IMAGE_VERSION, sizeof(IMAGE_VERSION), hash);
+
+    for (const std::string &source : sources) {
+        std::ifstream file(source, std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        std::string contents((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+        uint64_t size = contents.size();
+        hash = util::fnv1a_64(&size, sizeof(size), hash);
+        hash = util::fnv1a_64(contents, hash);
+    }
+
+    const unsigned char flags[] = {config.bare_machine, config.accept_pseudo_insts,
+                                   config.delayed_branches};
+    return util::fnv1a_64(flags, sizeof(flags), hash);
+}
+
+bool ImageCache::store(uint64_t key, const program_image_t &image) const {
+    image_file_header header = {};
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    header.version = IMAGE_VERSION;
+    header.header_size = sizeof(image_file_header);
+    header.key = key;
+
+    header.text_top = image.text_top;
+    header.k_text_top = image.k_text_top;
+    header.data_top = image.data_top;
+    header.k_data_top = image.k_data_top;
+    header.gp_midpoint = image.gp_midpoint;
+    header.next_text_pc = image.next_text_pc;
+    header.next_k_text_pc = image.next_k_text_pc;
+    header.next_data_pc = image.next_data_pc;
+    header.next_k_data_pc = image.next_k_data_pc;
+    header.next_gp_item_addr = image.next_gp_item_addr;
+
+    header.text_slots = image.text_seg.size();
+    header.text_words = used_slots(image.text_seg);
+    header.k_text_slots = image.k_text_seg.size();
+    header.k_text_words = used_slots(image.k_text_seg);
+    header.data_slots = image.data_seg.size();
+    header.data_words = used_words(image.data_seg);
+    header.k_data_slots = image.k_data_seg.size();
+    header.k_data_words = used_words(image.k_data_seg);
+
+    std::vector<char> payload;
+    std::vector<image_line> lines;
+    string_pool strings;
+
+    append_text(payload, image.text_seg, header.text_words, 0, lines, strings);
+    append_text(payload, image.k_text_seg, header.k_text_words, LINE_IN_KERNEL, lines, strings);
+    append(payload, image.data_seg.data(), header.data_words);
+    append(payload, image.k_data_seg.data(), header.k_data_words);
+
+    std::vector<image_symbol> symbols;
+    image.symbol_table->for_each_label([&](const label &l) {
+        uint32_t flags = (l.global_flag ? SYM_GLOBAL : 0) | (l.gp_flag ? SYM_GP : 0) |
+                         (l.const_flag ? SYM_CONST : 0);
+        symbols.push_back({strings.add(l.name.data()), l.addr, flags});  // Interned names end in NUL
+    });
+    append(payload, symbols.data(), symbols.size());
+    append(payload, lines.data(), lines.size());
+
+    /* Pad so the file stays a whole number of words. */
+    strings.bytes.resize((strings.bytes.size() + 3) & ~size_t(3), '\0');
+    append(payload, strings.bytes.data(), strings.bytes.size());
+
+    header.num_symbols = symbols.size();
+    header.num_lines = lines.size();
+    header.strings_size = strings.bytes.size();
+    header.payload_crc = util::crc32(payload.data(), payload.size());
+
+    /* Write to a private name and rename, so concurrent readers see all or nothing. */
+    std::string path = path_for(key);
+    std::string tmp = path + "." + std::to_string(getpid()) + ".tmp";
+    FILE *file = fopen(tmp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const program_image_t> ImageCache::load(uint64_t key) const {
+    int fd = open(path_for(key).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(image_file_header)) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t size = st.st_size;
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    /* The image borrows source lines from the mapping, so it owns the mapping. */
+    std::shared_ptr<const void> mapping(addr, [size](const void *p) {
+        munmap(const_cast<void *>(p), size);
+    });
+
+    const char *base = static_cast<const char *>(addr);
+    const image_file_header &header = *reinterpret_cast<const image_file_header *>(base);
+    if (memcmp(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0 ||
+        header.version != IMAGE_VERSION || header.header_size != sizeof(image_file_header) ||
+        header.key != key ||
+        header.payload_crc != util::crc32(base + sizeof(header), size - sizeof(header))) {
+        return nullptr;
+    }
+
+    auto image = std::make_shared<program_image_t>();
+    section_reader in(base + sizeof(header), base + size);
+
+    if (!load_text(in, image->text_seg, header.text_slots, header.text_words) ||
+        !load_text(in, image->k_text_seg, header.k_text_slots, header.k_text_words) ||
+        !load_data(in, image->data_seg, header.data_slots, header.data_words) ||
+        !load_data(in, image->k_data_seg, header.k_data_slots, header.k_data_words)) {
+        return nullptr;
+    }
+
+    const image_symbol *symbols = in.take<image_symbol>(header.num_symbols);
+    const image_line *lines = in.take<image_line>(header.num_lines);
+    const char *strings = in.take<char>(header.strings_size);
+    if (!in.ok || (header.strings_size != 0 && strings[header.strings_size - 1] != '\0')) {
+        return nullptr;
+    }
+
+    auto table = std::make_shared<SymbolTable>();
+    for (uint32_t i = 0; i < header.num_symbols; ++i) {
+        if (symbols[i].name >= header.strings_size) {
+            return nullptr;
+        }
+        label *l = table->lookup_label(strings + symbols[i].name);
+        l->addr = symbols[i].addr;
+        l->global_flag = symbols[i].flags & SYM_GLOBAL;
+        l->gp_flag = symbols[i].flags & SYM_GP;
+        l->const_flag = symbols[i].flags & SYM_CONST;
+    }
+
+    for (uint32_t i = 0; i < header.num_lines; ++i) {
+        text_segment_t &seg = (lines[i].slot & LINE_IN_KERNEL) ? image->k_text_seg : image->text_seg;
+        uint32_t slot = lines[i].slot & ~LINE_IN_KERNEL;
+        if (slot >= seg.size() || seg[slot] == nullptr || lines[i].text >= header.strings_size) {
+            return nullptr;
+        }
+        seg[slot]->source_line = const_cast<char *>(strings + lines[i].text);
+    }
+
+    image->text_top = header.text_top;
+    image->k_text_top = header.k_text_top;
+    image->data_top = header.data_top;
+    image->k_data_top = header.k_data_top;
+    image->gp_midpoint = header.gp_midpoint;
+    image->next_text_pc = header.next_text_pc;
+    image->next_k_text_pc = header.next_k_text_pc;
+    image->next_data_pc = header.next_data_pc;
+    image->next_k_data_pc = header.next_k_data_pc;
+    image->next_gp_item_addr = header.next_gp_item_addr;
+    image->symbol_table = std::move(table);
+    image->backing = std::move(mapping);
+    return image;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "program_image.h"
+
+/**
+ * On-disk cache of assembled programs.
+ *
+ * Tournament and grading runs assemble the same handful of .s files over and over. An entry is
+ * keyed by the hash of the source files plus the CPUConfig flags that change what the assembler
+ * produces, and holds a program_image_t in a flat binary object format (see image_cache.cpp).
+ * A hit maps the file and decodes the encoded words directly, skipping the parser and label
+ * resolution entirely:
+ *
+ *     std::optional<uint64_t> key = ImageCache::key(sources, config);
+ *     auto image = key ? cache.load(*key) : nullptr;
+ *     if (image == nullptr) {
+ *         ...assemble sources into cpu...
+ *         image = cpu.share_program_image();
+ *         if (key) {
+ *             cache.store(*key, *image);
+ *         }
+ *     }
+ *     other_cpu.load_program_image(image);
+ *
+ * Only fully linked images are cached, so the object format carries no pending relocations.
+ */
+class ImageCache {
+   public:
+    explicit ImageCache(std::string directory);
+
+    /**
+     * Hash the contents of SOURCES (in order) and the assembly-relevant flags of CONFIG.
+     * Returns nothing if a source cannot be read.
+     */
+    static std::optional<uint64_t> key(const std::vector<std::string> &sources, const CPUConfig &config);
+
+    /* Return the cached image for KEY, or nullptr on a miss or a corrupt entry. */
+    std::shared_ptr<const program_image_t> load(uint64_t key) const;
+
+    /* Write IMAGE under KEY. Readers never see a partially written entry. */
+    bool store(uint64_t key, const program_image_t &image) const;
+
+   private:
+    std::string path_for(uint64_t key) const;
+
+    std::string directory;
+};
+
+#endif
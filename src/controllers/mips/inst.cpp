@@ -35,7 +35,7 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <algorithm>
+#include <array>
 #include <memory>
 
 #include "data.h"
@@ -52,80 +52,162 @@
 /* Local functions: */
 
 static void format_imm_expr(str_stream *ss, imm_expr *expr, int base_reg);
-static void sort_a_opcode_table();
-static void sort_i_opcode_table();
-static void sort_name_table();
 
-/* Maintain a table mapping from opcode to instruction name and
-   instruction type.
+/* Opcode tables.
 
-   Table must be sorted before first use since its entries are
-   alphabetical on name, not ordered by opcode. */
+   op.h lists every operation as OP(NAME, I_OPCODE, TYPE, A_OPCODE), alphabetically by name.
+   SPIM sorted three copies of it at startup and binary searched them on every encode and
+   decode. Here the lists are turned into dense arrays at compile time instead: one indexed by
+   internal opcode (I_OPCODE, e.g. Y_ADD_OP) for encoding and printing, and one indexed by the
+   fields of a binary instruction that select the operation, for decoding. */
 
-/* Sort all instruction table before first use. */
+namespace {
 
-void initialize_inst_tables() {
-    sort_name_table();
-    sort_i_opcode_table();
-    sort_a_opcode_table();
-}
+struct op_entry {
+    const char *name;
+    int i_opcode;
+    int type;
+    int32_t a_opcode; /* -1 for pseudo-ops and directives */
+};
 
-/* Map from opcode -> name/type. */
-static std::array<name_val_val, NUM_OPERATIONS> name_tbl = {
+constexpr op_entry OPS[] = {
 #undef OP
-#define OP(NAME, OPCODE, TYPE, R_OPCODE) {NAME, OPCODE, TYPE},
+#define OP(NAME, I_OPCODE, TYPE, A_OPCODE) {NAME, (int)I_OPCODE, TYPE, (int32_t)A_OPCODE},
 #include "op.h"
 };
 
-/* Sort the opcode table on their key (the opcode value). */
-
-static void sort_name_table() {  // DONE
-    if (!std::is_sorted(name_tbl.begin(), name_tbl.end())) {
-        std::sort(name_tbl.begin(), name_tbl.end());
+constexpr int min_i_opcode() {
+    int m = OPS[0].i_opcode;
+    for (const op_entry &op : OPS) {
+        m = op.i_opcode < m ? op.i_opcode : m;
     }
+    return m;
 }
 
-/* Map between a SPIM instruction and the binary representation of the
-   instruction. */
-
-/* Maintain a table mapping from internal opcode (i_opcode) to actual
-   opcode (a_opcode).  Table must be sorted before first use since its
-   entries are alphabetical on name, not ordered by opcode. */
+constexpr int max_i_opcode() {
+    int m = OPS[0].i_opcode;
+    for (const op_entry &op : OPS) {
+        m = op.i_opcode > m ? op.i_opcode : m;
+    }
+    return m;
+}
 
-/* Map from internal opcode -> real opcode */
+constexpr int MIN_I_OPCODE = min_i_opcode();
+constexpr size_t NUM_I_OPCODES = max_i_opcode() - MIN_I_OPCODE + 1;
 
-static std::array<name_val_val, NUM_OPERATIONS> i_opcode_tbl = {
-#undef OP
-#define OP(NAME, I_OPCODE, TYPE, A_OPCODE) {NAME, I_OPCODE, (int)A_OPCODE},
-#include "op.h"
+/* Internal opcode -> name, type and real opcode. A null name marks an unused opcode. */
+struct i_op_info {
+    const char *name;
+    int type;
+    int32_t a_opcode;
 };
 
-/* Sort the opcode table on their key (the interal opcode value). */
+constexpr std::array<i_op_info, NUM_I_OPCODES> make_i_opcode_table() {
+    std::array<i_op_info, NUM_I_OPCODES> table = {};
+    for (const op_entry &op : OPS) {
+        table[op.i_opcode - MIN_I_OPCODE] = {op.name, op.type, op.a_opcode};
+    }
+    return table;
+}
+
+constexpr std::array<i_op_info, NUM_I_OPCODES> i_opcode_tbl = make_i_opcode_table();
 
-static void sort_i_opcode_table() {
-    if (!std::is_sorted(i_opcode_tbl.begin(), i_opcode_tbl.end())) {
-        std::sort(i_opcode_tbl.begin(), i_opcode_tbl.end());
+const i_op_info *i_opcode_info(int i_opcode) {
+    unsigned idx = (unsigned)(i_opcode - MIN_I_OPCODE);
+    if (idx >= NUM_I_OPCODES || i_opcode_tbl[idx].name == nullptr) {
+        return nullptr;
     }
+    return &i_opcode_tbl[idx];
 }
 
-/* Maintain a table mapping from actual opcode to interal opcode.
-   Table must be sorted before first use since its entries are
-   alphabetical on name, not ordered by opcode. */
+/* Keep only the bits of VAL that identify its operation (the "actual opcode"). */
+constexpr int32_t a_opcode_of(int32_t val) {
+    int32_t a_opcode = val & 0xfc000000;
+
+    /* Field classes: (opcode is continued in other part of instruction): */
+    if (a_opcode == 0 || a_opcode == 0x70000000) { /* SPECIAL or SPECIAL2 */
+        a_opcode |= (val & 0x3f);
+    } else if (a_opcode == 0x04000000) { /* REGIMM */
+        a_opcode |= (val & 0x001f0000);
+    } else if (a_opcode == 0x40000000) { /* COP0 */
+        a_opcode |= (val & 0x03e00000) | (val & 0x1f);
+    } else if (a_opcode == 0x44000000) { /* COP1 */
+        a_opcode |= (val & 0x03e00000);
+        if ((val & 0xff000000) == 0x45000000) {
+            a_opcode |= (val & 0x00010000); /* BC1f/t */
+        } else {
+            a_opcode |= (val & 0x3f);
+        }
+    } else if (a_opcode == 0x48000000 /* COPz */
+               || a_opcode == 0x4c000000) {
+        a_opcode |= (val & 0x03e00000);
+    }
+    return a_opcode;
+}
 
-/* Map from internal opcode -> real opcode */
+/* Dense index of an actual opcode: the primary opcode, or for the classes above a sub-table
+   indexed by the extra fields they use. */
+constexpr uint32_t DECODE_SPECIAL = 64;                 /* funct */
+constexpr uint32_t DECODE_SPECIAL2 = DECODE_SPECIAL + 64; /* funct */
+constexpr uint32_t DECODE_REGIMM = DECODE_SPECIAL2 + 64;  /* rt */
+constexpr uint32_t DECODE_COP0 = DECODE_REGIMM + 32;      /* rs, low 5 bits of funct */
+constexpr uint32_t DECODE_COP1 = DECODE_COP0 + 32 * 32;   /* rs, funct or BC1 t/f bit */
+constexpr uint32_t DECODE_COPZ = DECODE_COP1 + 32 * 64;   /* COP2/COP1X, rs */
+constexpr uint32_t DECODE_SLOTS = DECODE_COPZ + 2 * 32;
+
+constexpr uint32_t decode_slot(int32_t a_opcode) {
+    uint32_t a = (uint32_t)a_opcode;
+    uint32_t primary = a >> 26;
+    uint32_t rs = (a >> 21) & 0x1f;
+
+    switch (primary) {
+        case 0x00:
+            return DECODE_SPECIAL + (a & 0x3f);
+        case 0x1c:
+            return DECODE_SPECIAL2 + (a & 0x3f);
+        case 0x01:
+            return DECODE_REGIMM + ((a >> 16) & 0x1f);
+        case 0x10:
+            return DECODE_COP0 + rs * 32 + (a & 0x1f);
+        case 0x11:
+            return DECODE_COP1 + rs * 64 + ((a >> 24) == 0x45 ? (a >> 16) & 1 : a & 0x3f);
+        case 0x12:
+        case 0x13:
+            return DECODE_COPZ + (primary - 0x12) * 32 + rs;
+        default:
+            return primary;
+    }
+}
 
-static std::array<name_val_val, NUM_OPERATIONS> a_opcode_tbl = {
-#undef OP
-#define OP(NAME, I_OPCODE, TYPE, A_OPCODE) {NAME, (int)A_OPCODE, (int)I_OPCODE},
-#include "op.h"
+/* Decode slot -> internal opcode (0 if none). When op.h gives two operations the same
+   encoding (e.g. lwxc1 and madd.s, both 0x4c000000), the first one listed wins. The actual opcode is kept so that a
+   lookup only succeeds on an exact match, as the sorted-table search did. */
+struct a_op_info {
+    int32_t a_opcode;
+    int i_opcode;
 };
 
-/* Sort the opcode table on their key (the interal opcode value). */
-
-static void sort_a_opcode_table() {
-    if (!std::is_sorted(a_opcode_tbl.begin(), a_opcode_tbl.end())) {
-        std::sort(a_opcode_tbl.begin(), a_opcode_tbl.end());
+constexpr std::array<a_op_info, DECODE_SLOTS> make_a_opcode_table() {
+    std::array<a_op_info, DECODE_SLOTS> table = {};
+    for (const op_entry &op : OPS) {
+        if (op.a_opcode == -1 || op.a_opcode != a_opcode_of(op.a_opcode)) {
+            continue; /* Not a machine instruction, or not reachable by decoding */
+        }
+        a_op_info &slot = table[decode_slot(op.a_opcode)];
+        if (slot.i_opcode == 0) {
+            slot = {op.a_opcode, op.i_opcode};
+        }
     }
+    return table;
+}
+
+constexpr std::array<a_op_info, DECODE_SLOTS> a_opcode_tbl = make_a_opcode_table();
+
+}  // namespace
+
+const char *opcode_name(int opcode) {
+    const i_op_info *entry = i_opcode_info(opcode);
+    return entry == nullptr ? nullptr : entry->name;
 }
 
 // Helper function for reusing format strings
@@ -143,7 +225,7 @@ std::string string_format(const std::string &format, Args... args) {
 }
 
 void instruction::format_an_inst(std::stringstream &ss, instruction *inst, mem_addr addr) {
-    name_val_val *entry;
+    const i_op_info *entry;
     int line_start =
         ss.tellp();  // XXX: Check if actual length of stream is needed, but I doubt it.
 
@@ -161,14 +243,14 @@ void instruction::format_an_inst(std::stringstream &ss, instruction *inst, mem_a
         return;
     }
 
-    entry = map_int_to_name_val_val(name_tbl, inst->OPCODE());
+    entry = i_opcode_info(inst->OPCODE());
     if (entry == nullptr) {
         ss << string_format("<unknown instruction %d>\n", inst->OPCODE());
         return;
     }
 
     ss << string_format("0x%08x  %s", (uint32)inst->ENCODING(), entry->name);
-    switch (entry->value2) {
+    switch (entry->type) {
         case BC_TYPE_INST:
             ss << string_format("%d %d", inst->CC(), inst->IDISP());
             break;
@@ -308,8 +390,8 @@ void instruction::format_an_inst(std::stringstream &ss, instruction *inst, mem_a
 
 /* Make and return a new immediate expression */
 
-imm_expr *imm_expr::make_imm_expr(int offs, char *sym, bool is_pc_relative) {
-    imm_expr *expr = new imm_expr();
+imm_expr *imm_expr::make_imm_expr(asm_arena_t &arena, int offs, char *sym, bool is_pc_relative) {
+    imm_expr *expr = arena.make<imm_expr>();
 
     expr->offset = offs;
     expr->bits = 0;
@@ -326,7 +408,7 @@ imm_expr *imm_expr::make_imm_expr(int offs, char *sym, bool is_pc_relative) {
 
 void imm_expr::format_imm_expr(std::stringstream &ss, imm_expr *expr, int base_reg) {
     if (expr->symbol != nullptr) {
-        ss << string_format("%s", expr->symbol->name);
+        ss << string_format("%s", expr->symbol->name.data());
     }
 
     if (expr->pc_relative) {
@@ -353,23 +435,19 @@ constexpr int32_t REGS(uint16_t R, uint32_t O) { return (R & 0x1f) << O; }
 int32_t instruction::inst_encode(bool correct_branches) const {
     const instruction *inst = this;
     int32_t a_opcode = 0;
-    name_val_val *entry;
+    const i_op_info *entry;
 
     if (inst == nullptr) {
         return (0);
     }
 
-    entry = map_int_to_name_val_val(i_opcode_tbl, sizeof(i_opcode_tbl) / sizeof(name_val_val),
-                                    inst->OPCODE());
+    entry = i_opcode_info(inst->OPCODE());
     if (entry == nullptr) {
         return 0;
     }
 
-    a_opcode = entry->value2;
-    entry =
-        map_int_to_name_val_val(name_tbl, sizeof(name_tbl) / sizeof(name_val_val), inst->OPCODE());
-
-    switch (entry->value2) {
+    a_opcode = entry->a_opcode;
+    switch (entry->type) {
         case BC_TYPE_INST:
             return (a_opcode | REGS(inst->CC() << 2, 16) |
                     ((inst->IOFFSET() - (int16_t)correct_branches) & 0xffff));
@@ -459,8 +537,8 @@ int32_t instruction::inst_encode(bool correct_branches) const {
 /* Return a register-type instruction with the given OPCODE, RD, RS, and RT
    fields. */
 
-instruction *instruction::make_r_type_inst(int opcode, int rd, int rs, int rt) {
-    instruction *inst = new instruction();
+instruction *instruction::make_r_type_inst(asm_arena_t &arena, int opcode, int rd, int rs, int rt) {
+    instruction *inst = arena.make<instruction>();
 
     inst->SET_OPCODE(opcode);
     inst->SET_RS(rs);
@@ -470,150 +548,186 @@ instruction *instruction::make_r_type_inst(int opcode, int rd, int rs, int rt) {
     return inst;
 }
 
-instruction *instruction::inst_decode(int32_t val) {
-    int32_t a_opcode = val & 0xfc000000;
-    name_val_val *entry;
-    int32 i_opcode;
+static void fill_r_inst(instruction *inst, int32 val, int opcode, int rs, int rt, int rd,
+                        int shamt) {
+    inst->SET_OPCODE(opcode);
+    inst->SET_RS(rs);
+    inst->SET_RT(rt);
+    inst->SET_RD(rd);
+    inst->SET_SHAMT(shamt);
+    inst->SET_ENCODING(val);
+    inst->SET_EXPR(nullptr);
+}
 
-    /* Field classes: (opcode is continued in other part of instruction): */
-    if (a_opcode == 0 || a_opcode == 0x70000000) { /* SPECIAL or SPECIAL2 */
-        a_opcode |= (val & 0x3f);
-    } else if (a_opcode == 0x04000000) { /* REGIMM */
-        a_opcode |= (val & 0x001f0000);
-    } else if (a_opcode == 0x40000000) { /* COP0 */
-        a_opcode |= (val & 0x03e00000) | (val & 0x1f);
-    } else if (a_opcode == 0x44000000) { /* COP1 */
+static void fill_i_inst(instruction *inst, int32 val, int opcode, int rs, int rt, int offset) {
+    inst->SET_OPCODE(opcode);
+    inst->SET_RS(rs);
+    inst->SET_RT(rt);
+    inst->SET_IOFFSET(offset);
+    inst->SET_ENCODING(val);
+    inst->SET_EXPR(nullptr);
+}
 
-        a_opcode |= (val & 0x03e00000);
-        if ((val & 0xff000000) == 0x45000000) {
-            a_opcode |= (val & 0x00010000); /* BC1f/t */
-        } else {
-            a_opcode |= (val & 0x3f);
-        }
-    } else if (a_opcode == 0x48000000 /* COPz */
-               || a_opcode == 0x4c000000) {
-        a_opcode |= (val & 0x03e00000);
-    }
+static void fill_j_inst(instruction *inst, int32 val, int opcode, int target) {
+    inst->SET_OPCODE(opcode);
+    inst->SET_TARGET(target);
+    inst->SET_ENCODING(val);
+    inst->SET_EXPR(nullptr);
+}
 
-    entry = map_int_to_name_val_val(a_opcode_tbl, sizeof(a_opcode_tbl) / sizeof(name_val_val),
-                                    a_opcode);
-    if (entry == nullptr) {
-        return (mk_r_inst(val, 0, 0, 0, 0, 0)); /* Invalid inst */
+/* Fill in INST from its binary encoding VAL. */
+
+static void decode_into(instruction *inst, int32_t val) {
+    int32_t a_opcode = a_opcode_of(val);
+    const a_op_info &entry = a_opcode_tbl[decode_slot(a_opcode)];
+    if (entry.i_opcode == 0 || entry.a_opcode != a_opcode) {
+        fill_r_inst(inst, val, 0, 0, 0, 0, 0); /* Invalid inst */
+        return;
     }
 
-    i_opcode = entry->value2;
+    int32 i_opcode = entry.i_opcode;
 
-    switch (map_int_to_name_val_val(name_tbl, sizeof(name_tbl) / sizeof(name_val_val), i_opcode)
-                ->value2) {
+    switch (i_opcode_info(i_opcode)->type) {
         case BC_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff);
+            return;
 
         case B1_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), 0, val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), 0, val & 0xffff);
+            return;
 
         case I1s_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), 0, val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), 0, val & 0xffff);
+            return;
 
         case I1t_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff);
+            return;
 
         case I2_TYPE_INST:
         case B2_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff);
+            return;
 
         case I2a_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), val & 0xffff);
+            return;
 
         case R1s_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), 0, 0, 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), 0, 0, 0);
+            return;
 
         case R1d_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, 0, 0, BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, 0, 0, BIN_RD(val), 0);
+            return;
 
         case R2td_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, 0, BIN_RT(val), BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, 0, BIN_RT(val), BIN_RD(val), 0);
+            return;
 
         case R2st_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), 0, 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), 0, 0);
+            return;
 
         case R2ds_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), 0, BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), 0, BIN_RD(val), 0);
+            return;
 
         case R2sh_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, 0, BIN_RT(val), BIN_RD(val), BIN_SA(val)));
+            fill_r_inst(inst, val, i_opcode, 0, BIN_RT(val), BIN_RD(val), BIN_SA(val));
+            return;
 
         case R3_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0);
+            return;
 
         case R3sh_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0);
+            return;
 
         case FP_I2a_TYPE_INST:
-            return (mk_i_inst(val, i_opcode, BIN_BASE(val), BIN_FT(val), val & 0xffff));
+            fill_i_inst(inst, val, i_opcode, BIN_BASE(val), BIN_FT(val), val & 0xffff);
+            return;
 
         case FP_R2ds_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_FS(val), 0, BIN_FD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_FS(val), 0, BIN_FD(val), 0);
+            return;
 
         case FP_R2ts_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, 0, BIN_RT(val), BIN_FS(val), 0));
+            fill_r_inst(inst, val, i_opcode, 0, BIN_RT(val), BIN_FS(val), 0);
+            return;
 
         case FP_CMP_TYPE_INST: {
-            instruction *inst = mk_r_inst(val, i_opcode, BIN_FS(val), BIN_FT(val), BIN_FD(val), 0);
+            fill_r_inst(inst, val, i_opcode, BIN_FS(val), BIN_FT(val), BIN_FD(val), 0);
             inst->SET_COND(val & 0xf);
-            return (inst);
+            return;
         }
 
         case FP_R3_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_FS(val), BIN_FT(val), BIN_FD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_FS(val), BIN_FT(val), BIN_FD(val), 0);
+            return;
 
         case MOVC_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_RS(val), BIN_RT(val), BIN_RD(val), 0);
+            return;
 
         case FP_MOVC_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, BIN_FS(val), BIN_RT(val), BIN_FD(val), 0));
+            fill_r_inst(inst, val, i_opcode, BIN_FS(val), BIN_RT(val), BIN_FD(val), 0);
+            return;
 
         case J_TYPE_INST:
-            return (mk_j_inst(val, i_opcode, val & 0x2ffffff));
+            fill_j_inst(inst, val, i_opcode, val & 0x2ffffff);
+            return;
 
         case NOARG_TYPE_INST:
-            return (mk_r_inst(val, i_opcode, 0, 0, 0, 0));
+            fill_r_inst(inst, val, i_opcode, 0, 0, 0, 0);
+            return;
 
         default:
-            return (mk_r_inst(val, 0, 0, 0, 0, 0)); /* Invalid inst */
+            fill_r_inst(inst, val, 0, 0, 0, 0, 0);
+            return; /* Invalid inst */
     }
 }
 
-instruction *instruction::mk_r_inst(int32 val, int opcode, int rs, int rt, int rd, int shamt) {
-    instruction *inst = new instruction();
-
-    inst->SET_OPCODE(opcode);
-    inst->SET_RS(rs);
-    inst->SET_RT(rt);
-    inst->SET_RD(rd);
-    inst->SET_SHAMT(shamt);
-    inst->SET_ENCODING(val);
-    inst->SET_EXPR(nullptr);
+instruction *instruction::inst_decode(asm_arena_t &arena, int32_t val) {
+    instruction *inst = arena.make<instruction>();
+    decode_into(inst, val);
     return inst;
 }
 
-instruction *instruction::mk_i_inst(int32 val, int opcode, int rs, int rt, int offset) {
-    instruction *inst = new instruction();
+void instruction::inst_redecode(instruction *inst, int32_t val) {
+    *inst = instruction();
+    decode_into(inst, val);
+}
 
-    inst->SET_OPCODE(opcode);
-    inst->SET_RS(rs);
-    inst->SET_RT(rt);
-    inst->SET_IOFFSET(offset);
-    inst->SET_ENCODING(val);
-    inst->SET_EXPR(nullptr);
+void instruction::inst_decode_block(asm_arena_t &arena, const int32_t *words, size_t n,
+                                    instruction **out) {
+    /* One allocation for the whole run; the instructions are contiguous, which also helps the
+       interpreter walk them. */
+    instruction *insts =
+        static_cast<instruction *>(arena.allocate(n * sizeof(instruction), alignof(instruction)));
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = new (&insts[i]) instruction();
+        decode_into(out[i], words[i]);
+    }
+}
+
+instruction *instruction::mk_r_inst(asm_arena_t &arena, int32 val, int opcode, int rs, int rt, int rd,
+                                    int shamt) {
+    instruction *inst = arena.make<instruction>();
+    fill_r_inst(inst, val, opcode, rs, rt, rd, shamt);
     return inst;
 }
 
-instruction *instruction::mk_j_inst(int32 val, int opcode, int target) {
-    instruction *inst = new instruction();
+instruction *instruction::mk_i_inst(asm_arena_t &arena, int32 val, int opcode, int rs, int rt,
+                                    int offset) {
+    instruction *inst = arena.make<instruction>();
+    fill_i_inst(inst, val, opcode, rs, rt, offset);
+    return inst;
+}
 
-    inst->SET_OPCODE(opcode);
-    inst->SET_TARGET(target);
-    inst->SET_ENCODING(val);
-    inst->SET_EXPR(nullptr);
+instruction *instruction::mk_j_inst(asm_arena_t &arena, int32 val, int opcode, int target) {
+    instruction *inst = arena.make<instruction>();
+    fill_j_inst(inst, val, opcode, target);
     return inst;
 }
@@ -38,6 +38,7 @@
 #include <sstream>
 
 #include "TODO/spim-utils.h"
+#include "arena.h"
 #include "cpu.h"
 #include "reg.h"
 #include "spim.h"
@@ -59,7 +60,10 @@ constexpr uint32_t UIMM_MIN = (unsigned)0;
 constexpr uint32_t UIMM_MAX = ((unsigned)((1 << 16) - 1));
 
 /* Represenation of the expression that produce a value for an instruction's
-   immediate field.  Immediates have the form: label +/- offset. */
+   immediate field.  Immediates have the form: label +/- offset.
+
+   Expressions, like the instructions that use them, are allocated from the arena of the
+   text segment being assembled and are never freed individually. */
 
 struct imm_expr {
     int offset;       /* Offset from symbol */
@@ -71,16 +75,16 @@ struct imm_expr {
 
     /* An immediate expression has the form: SYMBOL +/- IOFFSET, where either
    part may be omitted. */
-    static imm_expr *make_imm_expr(int offs, char *sym, bool is_pc_relative);
+    static imm_expr *make_imm_expr(asm_arena_t &arena, int offs, char *sym, bool is_pc_relative);
 
     /* Return an instruction expression for a constant VALUE. */
-    static imm_expr *const_imm_expr(int32_t value) {
-        return (make_imm_expr(value, nullptr, false));
+    static imm_expr *const_imm_expr(asm_arena_t &arena, int32_t value) {
+        return (make_imm_expr(arena, value, nullptr, false));
     }
 
     /* Return a shallow copy of the EXPRESSION. */
-    static imm_expr *copy_imm_expr(imm_expr *old_expr) {
-        imm_expr *expr = new imm_expr();
+    static imm_expr *copy_imm_expr(asm_arena_t &arena, const imm_expr *old_expr) {
+        imm_expr *expr = arena.make<imm_expr>();
 
         *expr = *old_expr;
         /*memcpy ((void*)expr, (void*)old_expr, sizeof (imm_expr));*/
@@ -90,8 +94,8 @@ struct imm_expr {
     /* Return a shallow copy of the EXPRESSION with the offset field
    incremented by the given amount. */
 
-    static imm_expr *incr_expr_offset(imm_expr *expr, int32 value) {
-        imm_expr *new_expr = copy_imm_expr(expr);
+    static imm_expr *incr_expr_offset(asm_arena_t &arena, const imm_expr *expr, int32 value) {
+        imm_expr *new_expr = copy_imm_expr(arena, expr);
 
         new_expr->offset += value;
         return (new_expr);
@@ -100,8 +104,8 @@ struct imm_expr {
     /* Return a shallow copy of an EXPRESSION that only uses the upper
    sixteen bits of the expression's value. */
 
-    static imm_expr *upper_bits_of_expr(imm_expr *old_expr) {
-        imm_expr *expr = copy_imm_expr(old_expr);
+    static imm_expr *upper_bits_of_expr(asm_arena_t &arena, const imm_expr *old_expr) {
+        imm_expr *expr = copy_imm_expr(arena, old_expr);
 
         expr->bits = 1;
         return (expr);
@@ -110,8 +114,8 @@ struct imm_expr {
     /* Return a shallow copy of the EXPRESSION that only uses the lower
        sixteen bits of the expression's value. */
 
-    static imm_expr *lower_bits_of_expr(imm_expr *old_expr) {
-        imm_expr *expr = copy_imm_expr(old_expr);
+    static imm_expr *lower_bits_of_expr(asm_arena_t &arena, const imm_expr *old_expr) {
+        imm_expr *expr = copy_imm_expr(arena, old_expr);
 
         expr->bits = -1;
         return (expr);
@@ -128,7 +132,7 @@ struct imm_expr {
         } else if (SYMBOL_IS_DEFINED(expr->symbol)) {
             value = expr->offset + expr->symbol->addr;
         } else {
-            error("Evaluated undefined symbol: %s\n", expr->symbol->name);
+            error("Evaluated undefined symbol: %s\n", expr->symbol->name.data());
             value = 0;
         }
         if (expr->bits > 0) {
@@ -145,18 +149,6 @@ struct imm_expr {
     bool is_zero_imm() { return (this->offset == 0 && this->symbol == nullptr); }
 
     static void format_imm_expr(std::stringstream &ss, imm_expr *expr, int base_reg);
-
-    void produce_immediate(int rt, int value_known,
-                           int32 value) {  // XXX: FIXME
-        if (value_known && (value & 0xffff) == 0) {
-            i_type_inst_free(Y_LUI_OP, rt, 0, upper_bits_of_expr(this));
-        } else if (value_known && (value & 0xffff0000) == 0) {
-            i_type_inst_free(Y_ORI_OP, rt, 0, lower_bits_of_expr(this));
-        } else {
-            i_type_inst_free(Y_LUI_OP, 1, 0, upper_bits_of_expr(this));
-            i_type_inst_free(Y_ORI_OP, rt, 1, lower_bits_of_expr(this));
-        }
-    }
 };
 
 /* Representation of the expression that produce an address for an
@@ -201,7 +193,8 @@ struct instruction {
     imm_expr *expr;
     char *source_line;  // no ownership
 
-    // Rule of 5
+    // EXPR is not owned: it lives in the same arena as the instruction, so instructions are
+    // trivially copyable and are released with the arena rather than one at a time.
     inline instruction() {
         opcode = 0;
         r_t.target = 0;
@@ -210,57 +203,21 @@ struct instruction {
         source_line = nullptr;
     }
 
-    inline ~instruction() {
-        if (this->EXPR() != nullptr) {
-            delete this->EXPR();
-        }
-    }
-
-    inline instruction(const instruction &other)
-        : opcode(other.opcode),
-          r_t(other.r_t),
-          encoding(other.encoding),
-          source_line(other.source_line) {
-        if (other.expr == nullptr) {
-            this->expr == nullptr;
-        } else {
-            this->expr = new imm_expr(*(other.expr));
-        }
-    }
-
-    inline instruction(instruction &&other) noexcept
-        : opcode(std::exchange(other.opcode, 0)),
-          r_t(std::exchange(other.r_t, 0)),
-          encoding(std::exchange(other.encoding, 0)),
-          expr(std::exchange(other.expr, nullptr)),
-          source_line(std::exchange(other.source_line, nullptr)) {}
-
-    instruction &operator=(const instruction &other) {
-        if (&other == this) {
-            return *this;
-        }
-        return *this = instruction(other);
-    }
-
-    instruction &operator=(
-        instruction &&other) noexcept {  // XXX: Make sure that this does not leak memory
-        if (&other != this) {
-            return *this;
-        }
-        std::swap(opcode, other.opcode);
-        std::swap(r_t, other.r_t);
-        std::swap(encoding, other.encoding);
-        std::swap(expr, other.expr);
-        std::swap(source_line, other.source_line);
-        return *this;
-    }
-
-    /* Factory Methods */
-    static instruction *make_r_type_inst(int opcode, int rd, int rs, int rt);
-    static instruction *inst_decode(int32_t val);
-    static instruction *mk_r_inst(int32 val, int opcode, int rs, int rt, int rd, int shamt);
-    static instruction *mk_i_inst(int32 val, int opcode, int rs, int rt, int offset);
-    static instruction *mk_j_inst(int32 val, int opcode, int target);
+    /* Factory Methods (all allocate from ARENA) */
+    static instruction *make_r_type_inst(asm_arena_t &arena, int opcode, int rd, int rs, int rt);
+    static instruction *inst_decode(asm_arena_t &arena, int32_t val);
+    /* Overwrite INST with the decoding of VAL, as inst_decode would build it, without
+       allocating. */
+    static void inst_redecode(instruction *inst, int32_t val);
+    /* Decode N consecutive words (e.g. a raw text image) into one contiguous run in ARENA,
+       storing a pointer to each instruction in OUT. */
+    static void inst_decode_block(asm_arena_t &arena, const int32_t *words, size_t n,
+                                  instruction **out);
+    static instruction *mk_r_inst(asm_arena_t &arena, int32 val, int opcode, int rs, int rt, int rd,
+                                  int shamt);
+    static instruction *mk_i_inst(asm_arena_t &arena, int32 val, int opcode, int rs, int rt,
+                                  int offset);
+    static instruction *mk_j_inst(asm_arena_t &arena, int32 val, int opcode, int target);
 
     /**
      * Compares equality of instructions. Source line does not influence this
@@ -274,17 +231,17 @@ struct instruction {
 
     static void format_an_inst(std::stringstream &ss, instruction *inst, mem_addr addr);
 
-    /* Make and return a deep copy of INST. */
+    /* Make and return a deep copy of INST in ARENA. */
 
-    instruction *copy_inst(instruction *inst) {
-        instruction *new_inst = new instruction();
+    static instruction *copy_inst(asm_arena_t &arena, const instruction *inst) {
+        instruction *new_inst = arena.make<instruction>(*inst);
 
         // Eric's Note: This originally did not actually make a deep copy unlike what
-        // the documentation may lead you to believe. I have modified instruction so that it does.
-        // The original C code is below
-        *new_inst = *inst;
+        // the documentation may lead you to believe. The original C code is below
         /*memcpy ((void*)new_inst, (void*)inst , sizeof (instruction));*/
-        new_inst->SET_EXPR(imm_expr::copy_imm_expr(inst->EXPR()));
+        if (inst->expr != nullptr) {
+            new_inst->SET_EXPR(imm_expr::copy_imm_expr(arena, inst->expr));
+        }
 
         return (new_inst);
     }
@@ -514,7 +471,7 @@ constexpr bool opcode_is_load_store(int opcode) {  // DONE
     }
 }
 
-void i_type_inst_free(int opcode, int rt, int rs, imm_expr *expr);
-void initialize_inst_tables();
+/* Name of SPIM OPCODE (e.g. "addu" for Y_ADDU_OP), or nullptr if it is not an opcode. */
+const char *opcode_name(int opcode);
 
 #endif
@@ -31,8 +31,6 @@
 */
 #include "mem.h"
 
-#include <sstream>
-
 #include "inst.h"
 #include "reg.h"
 #include "spim-utils.h"
@@ -43,7 +41,6 @@ mem_image_t::mem_image_t() {
     int32_t data_limit, stack_limit, k_data_limit;
     /* The text segment. */
     this->text_seg = {};
-    this->text_prof = {};
     this->text_modified = false; /* => text segment was written */
     this->text_top = 0;
 
@@ -68,7 +65,6 @@ mem_image_t::mem_image_t() {
 
     /* The kernel text segment. */
     k_text_seg = {};
-    k_text_prof = {};
     k_text_top = 0;
 
     /* The kernel data segment. */
@@ -88,77 +84,30 @@ mem_image_t::mem_image_t() {
     int trans_buffer_full_timer = 0;
 }
 
-void mem_image_t::mem_dump_profile(const std::string &prof_file_name) const {
-    const mem_image_t &mem_image = *this;
-
-    // Init string stream
-
-    std::stringstream ss;
-    FILE *file = nullptr;
-
+bool mem_image_t::mem_dump_profile(const std::string &prof_file_name, bool delayed_branches,
+                                   const std::string &text_file_name) const {
     // No output file specified, so abort
     if (prof_file_name == "") {
-        return;
-    }
-
-    // Return if con't open file
-    file = fopen(prof_file_name.c_str(), "w");
-    if (file == nullptr) {
-        printf("failed to open profile file: %s\n",
-               prof_file_name);  // XXX: Convert to logging statement
-        return;
-    }
-
-    // Print out text segment
-    int text_size = (mem_image.text_top - TEXT_BOT) / BYTES_PER_WORD;
-    if (mem_image.text_seg.size() != text_size) {
-        printf("Text Size: %d, does not match with number of words: %d", text_size,
-               mem_image.text_seg.size());
+        return false;
     }
 
-    for (int i = 0; i < text_size; ++i) {
-        instruction *inst = mem_image.text_seg[i];
-        if (inst == nullptr) {
-            continue;
-        }
-        unsigned prof_count = mem_image.text_prof[i];
-        mem_addr addr = TEXT_BOT + (i << 2);
-        fprintf(file, "%9d ", prof_count - 1);
-
-        instruction::format_an_inst(ss, inst, addr);
-
-        // print_inst_internal (&buf[10], sizeof(buf)-12, inst, addr);
-        fprintf(file, "%s", ss.str());
-        ss.clear();
-        fflush(file);
+    profile_data_t data = this->block_prof.data(delayed_branches);
+    if (!block_profile_t::write(prof_file_name, data)) {
+        printf("failed to write profile file: %s\n",
+               prof_file_name.c_str());  // XXX: Convert to logging statement
+        return false;
     }
 
-    // Print out kernel text segment
-    fprintf(file, "\n\nkernel text segment\n\n");
-
-    int k_text_size = (mem_image.k_text_top - K_TEXT_BOT) / 4;
-
-    if (mem_image.k_text_seg.size() != k_text_size) {
-        printf("Text Size: %d, does not match with number of words: %d", k_text_size,
-               mem_image.k_text_seg.size());
-    }
-    for (int i = 0; i < k_text_size; ++i) {
-        instruction *inst = mem_image.k_text_seg[i];
-        if (inst == nullptr) {
-            continue;
+    if (text_file_name != "") {
+        FILE *file = fopen(text_file_name.c_str(), "w");
+        if (file == nullptr) {
+            printf("failed to open profile file: %s\n", text_file_name.c_str());
+            return false;
         }
-        unsigned prof_count = mem_image.k_text_prof[i];
-        mem_addr addr = K_TEXT_BOT + (i << 2);
-        fprintf(file, "%9d ", prof_count - 1);
-
-        instruction::format_an_inst(ss, inst, addr);
-
-        // print_inst_internal (&buf[10], sizeof(buf)-12, inst, addr);
-        fprintf(file, "%s", ss.str().c_str());
-        ss.clear();
+        block_profile_t::render_text(file, data);
+        fclose(file);
     }
-
-    fclose(file);
+    return true;
 }
 
 /* Expand the data segment by adding N bytes. */
@@ -292,17 +241,7 @@ void mem_image_t::make_memory(int text_size, int data_size, int data_limit, int
     }
     data_size = ROUND_UP(data_size, BYTES_PER_WORD); /* Keep word aligned */
 
-    if (mem_image.text_seg.empty()) {
-        // XXX: Change to reserve and use push_back
-        mem_image.text_seg.resize(BYTES_TO_INST(text_size) / BYTES_PER_WORD);
-        mem_image.text_prof.resize(text_size / sizeof(unsigned));
-    } else {
-        free_instructions(mem_image.text_seg, (mem_image.text_top - TEXT_BOT) / BYTES_PER_WORD);
-        mem_image.text_seg.resize(BYTES_TO_INST(text_size) / BYTES_PER_WORD);
-        mem_image.text_prof.resize(text_size / sizeof(unsigned));
-    }
-    std::fill(mem_image.text_seg.begin(), mem_image.text_seg.end(), nullptr);
-    std::fill(mem_image.text_prof.begin(), mem_image.text_prof.end(), 0);
+    mem_image.text_seg.reset(BYTES_TO_INST(text_size) / BYTES_PER_WORD);
     mem_image.text_top = TEXT_BOT + text_size;
 
     data_size = ROUND_UP(data_size, BYTES_PER_WORD); /* Keep word aligned */
@@ -340,17 +279,8 @@ void mem_image_t::make_memory(int text_size, int data_size, int data_limit, int
     }
     std::fill(mem_image.special_seg.begin(), mem_image.special_seg.end(), 0);
 
-    if (mem_image.k_text_seg.empty()) {
-        mem_image.k_text_seg.resize(BYTES_TO_INST(k_text_size) / BYTES_PER_WORD);
-        mem_image.k_text_prof.resize(k_text_size / sizeof(unsigned));
-    } else {
-        free_instructions(mem_image.k_text_seg,
-                          (mem_image.k_text_top - K_TEXT_BOT) / BYTES_PER_WORD);
-        mem_image.k_text_seg.resize(BYTES_TO_INST(k_text_size) / BYTES_PER_WORD);
-        mem_image.k_text_prof.resize(k_text_size / sizeof(unsigned));
-    }
-    std::fill(mem_image.k_text_seg.begin(), mem_image.k_text_seg.end(), nullptr);
-    std::fill(mem_image.k_text_prof.begin(), mem_image.k_text_prof.end(), 0);
+    mem_image.k_text_seg.reset(BYTES_TO_INST(k_text_size) / BYTES_PER_WORD);
+    mem_image.block_prof.reset(TEXT_BOT, mem_image.text_seg.size(), K_TEXT_BOT, mem_image.k_text_seg.size());
     mem_image.k_text_top = K_TEXT_BOT + k_text_size;
 
     k_data_size = ROUND_UP(k_data_size, BYTES_PER_WORD); /* Keep word aligned */
@@ -369,22 +299,40 @@ void mem_image_t::make_memory(int text_size, int data_size, int data_limit, int
     mem_image.data_modified = true;
 }
 
-/* Free the storage used by the old instructions in memory. */
+void mem_image_t::reset_segment_views() {
+    this->data_seg_b = (BYTE_TYPE *)this->data_seg.data();
+    this->data_seg_h = (short *)this->data_seg.data();
+    this->stack_seg_b = (BYTE_TYPE *)this->stack_seg.data();
+    this->stack_seg_h = (short *)this->stack_seg.data();
+    this->special_seg_b = (BYTE_TYPE *)this->special_seg.data();
+    this->special_seg_h = (short *)this->special_seg.data();
+    this->k_data_seg_b = (BYTE_TYPE *)this->k_data_seg.data();
+    this->k_data_seg_h = (short *)this->k_data_seg.data();
+}
 
-void mem_image_t::free_instructions(std::vector<instruction *> &inst, int n) {
-    if (n > inst.size()) {
-        printf("Too many instructions freed!");  // XXX: Logger
-    }
+/* Access memory */
+
+const void *mem_image_t::data_reference(mem_addr addr, size_t size) const {
+    const mem_image_t &mem_image = *this;
 
-    for (int i = 0; i < n; ++i) {
-        if (inst[i] != nullptr) {
-            free_inst(inst[i]);
+    /* Compare offsets rather than end addresses, which could wrap around. */
+    auto within = [&](mem_addr bot, mem_addr top, const void *seg) -> const void * {
+        if (addr >= bot && addr <= top && size <= top - addr) {
+            return (const char *)seg + (addr - bot);
         }
+        return nullptr;
+    };
+
+    const void *found = within(DATA_BOT, mem_image.data_top, mem_image.data_seg.data());
+    if (found == nullptr) {
+        found = within(mem_image.stack_bot, STACK_TOP, mem_image.stack_seg.data());
+    }
+    if (found == nullptr) {
+        found = within(K_DATA_BOT, mem_image.k_data_top, mem_image.k_data_seg.data());
     }
+    return found;
 }
 
-/* Access memory */
-
 void *mem_image_t::mem_reference(mem_addr addr) const {
     const mem_image_t &mem_image = *this;
 
@@ -39,9 +39,11 @@
 
 #include <string>
 
+#include "block_profile.h"
 #include "cpu.h"
 #include "inst.h"
 #include "reg.h"
+#include "text_seg.h"
 
 /* A note on directions:  "Bottom" of memory is the direction of
    decreasing addresses.  "Top" is the direction of increasing addresses.*/
@@ -82,9 +84,8 @@ struct mem_image_t {
     // int32_t text_size, data_size, stack_size, k_text_size, k_data_size;
     int32_t data_limit, stack_limit, k_data_limit;
 
-    /* The text segment. */
-    std::vector<instruction *> text_seg;
-    std::vector<unsigned> text_prof;
+    /* The text segment. May be shared with other CPUs running the same program. */
+    text_segment_t text_seg;
     bool text_modified; /* => text segment was written */
     mem_addr text_top;
 
@@ -108,8 +109,7 @@ struct mem_image_t {
     BYTE_TYPE *special_seg_b;
 
     /* The kernel text segment. */
-    std::vector<instruction *> k_text_seg;
-    std::vector<unsigned> k_text_prof;
+    text_segment_t k_text_seg;
     mem_addr k_text_top;
 
     /* The kernel data segment. */
@@ -118,6 +118,9 @@ struct mem_image_t {
     BYTE_TYPE *k_data_seg_b;
     mem_addr k_data_top;
 
+    /* Block and edge counts of both text segments; updated in ProfileMode::EXACT (samples in SAMPLED). */
+    block_profile_t block_prof;
+
     // MMIO Data
 
     int recv_control = 0; /* No input */
@@ -137,7 +140,11 @@ struct mem_image_t {
     mem_image_t();
 
     // Methods
-    void mem_dump_profile(const std::string &prof_file_name) const;
+
+    /* Write the block profile in block_profile_t's binary format, and rendered as text to
+       TEXT_FILE_NAME unless it is empty. False if nothing was written. */
+    bool mem_dump_profile(const std::string &prof_file_name, bool delayed_branches,
+                          const std::string &text_file_name = "") const;
 
     void make_memory(int text_size, int data_size, int data_limit, int stack_size, int stack_limit,
                      int k_text_size, int k_data_size, int k_data_limit);
@@ -157,9 +164,12 @@ struct mem_image_t {
     /* Access memory */
     void *mem_reference(mem_addr addr) const;
 
-   private:
-    /* Free the storage used by the old instructions in memory. */
-    void free_instructions(std::vector<instruction *> &, int n);
+    /* The SIZE bytes at ADDR if they all lie in the data, stack or kernel data segment, else
+       nullptr. Unlike mem_reference, never reports an error. */
+    const void *data_reference(mem_addr addr, size_t size) const;
+
+    /* Point the half-word and byte views back at this image's own segments (after a copy). */
+    void reset_segment_views();
 };
 
 // extern mem_image_t mem_images[2];
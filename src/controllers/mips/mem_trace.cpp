@@ -0,0 +1,222 @@
+#include "mem_trace.h"
+
+#include <string.h>
+
+#include <chrono>
+
+namespace {
+
+constexpr char TRACE_MAGIC[4] = {'S', 'P', 'M', 'T'};
+constexpr uint32_t TRACE_VERSION = 2; /* Version 1 had no gap records */
+constexpr size_t HEADER_SIZE = 24;     /* magic, version (u32), records, dropped (u64) */
+
+constexpr size_t BATCH = 1024;
+
+constexpr uint8_t FLAG_SIZE_MASK = 0x3;
+constexpr uint8_t FLAG_STORE = 0x4;
+constexpr uint8_t FLAG_GAP = 0x8;
+
+void put64(unsigned char *out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+uint64_t get64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = v << 8 | p[i];
+    }
+    return v;
+}
+
+void write_header(unsigned char *out, uint64_t records, uint64_t dropped) {
+    memcpy(out, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<unsigned char>(TRACE_VERSION >> (8 * i));
+    }
+    put64(out + 8, records);
+    put64(out + 16, dropped);
+}
+
+void put_varint(std::vector<unsigned char> &out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+/* False if P runs into END before the varint does. */
+bool get_varint(const unsigned char *&p, const unsigned char *end, uint64_t &v) {
+    v = 0;
+    for (int shift = 0; p != end && shift < 64; shift += 7) {
+        unsigned char byte = *p++;
+        v |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t zigzag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+
+int32_t unzigzag(uint32_t v) { return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1); }
+
+uint8_t size_log2(uint8_t size) { return size == 4 ? 2 : size == 2 ? 1 : 0; }
+
+}  // namespace
+
+std::unique_ptr<mem_trace_t> mem_trace_t::open(const std::string &path, size_t ring_capacity) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return nullptr;
+    }
+    unsigned char header[HEADER_SIZE];
+    write_header(header, 0, 0);
+    if (fwrite(header, 1, HEADER_SIZE, file) != HEADER_SIZE) {
+        fclose(file);
+        return nullptr;
+    }
+    return std::unique_ptr<mem_trace_t>(new mem_trace_t(file, ring_capacity));
+}
+
+mem_trace_t::mem_trace_t(FILE *file, size_t ring_capacity) : file(file), ring(ring_capacity) {
+    this->writer = std::thread(&mem_trace_t::write_loop, this);
+}
+
+mem_trace_t::~mem_trace_t() { this->close(); }
+
+void mem_trace_t::write_loop() {
+    mem_access_t batch[BATCH];
+    std::vector<unsigned char> bytes;
+    bytes.reserve(BATCH * 16);
+
+    for (;;) {
+        /* Read before popping, so that once set, the pop below has seen every record. */
+        bool last = this->stopping.load(std::memory_order_acquire);
+        size_t count = this->ring.pop(batch, BATCH);
+        if (count == 0) {
+            if (last) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        bytes.clear();
+        for (size_t i = 0; i < count; ++i) {
+            encode(batch[i], bytes);
+        }
+        if (!this->failed && fwrite(bytes.data(), 1, bytes.size(), this->file) != bytes.size()) {
+            this->failed = true;
+        }
+        this->written += count;
+    }
+}
+
+void mem_trace_t::encode(const mem_access_t &a, std::vector<unsigned char> &bytes) {
+    if (a.gap != 0) {
+        bytes.push_back(FLAG_GAP);
+        put_varint(bytes, a.cycle - this->previous.cycle);
+        put_varint(bytes, a.gap);
+        this->previous.cycle = a.cycle;
+        return;
+    }
+    bytes.push_back(static_cast<unsigned char>(size_log2(a.size) | (a.store ? FLAG_STORE : 0)));
+    put_varint(bytes, a.cycle - this->previous.cycle);
+    put_varint(bytes, zigzag(static_cast<int32_t>(a.pc - this->previous.pc)));
+    put_varint(bytes, zigzag(static_cast<int32_t>(a.addr - this->previous.addr)));
+    put_varint(bytes, zigzag(a.value));
+    this->previous = a;
+}
+
+bool mem_trace_t::close() {
+    if (this->file == nullptr) {
+        return !this->failed;
+    }
+    this->stopping.store(true, std::memory_order_release);
+    this->writer.join();
+
+    /* A gap at the very end never made it into the ring; the writer is done, so add it here. */
+    if (this->gap.gap != 0) {
+        std::vector<unsigned char> bytes;
+        encode(this->gap, bytes);
+        if (!this->failed && fwrite(bytes.data(), 1, bytes.size(), this->file) != bytes.size()) {
+            this->failed = true;
+        }
+        ++this->written;
+        this->gap = {};
+    }
+
+    unsigned char header[HEADER_SIZE];
+    write_header(header, this->written, this->dropped);
+    if (fseek(this->file, 0, SEEK_SET) != 0 || fwrite(header, 1, HEADER_SIZE, this->file) != HEADER_SIZE) {
+        this->failed = true;
+    }
+    if (fclose(this->file) != 0) {
+        this->failed = true;
+    }
+    this->file = nullptr;
+    return !this->failed;
+}
+
+bool mem_trace_t::read(const std::string &path, std::vector<mem_access_t> &accesses, uint64_t &dropped) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[64 * 1024];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) != 0;) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    fclose(file);
+
+    if (bytes.size() < HEADER_SIZE || memcmp(bytes.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        return false;
+    }
+    uint32_t version = bytes[4] | bytes[5] << 8 | bytes[6] << 16 | (uint32_t)bytes[7] << 24;
+    if (version == 0 || version > TRACE_VERSION) {
+        return false;
+    }
+    uint64_t records = get64(&bytes[8]);
+    dropped = get64(&bytes[16]);
+
+    accesses.clear();
+    mem_access_t previous = {};
+    const unsigned char *p = bytes.data() + HEADER_SIZE;
+    const unsigned char *end = bytes.data() + bytes.size();
+    for (uint64_t i = 0; i < records; ++i) {
+        uint64_t cycle, pc, addr, value;
+        if (p == end) {
+            return false;
+        }
+        uint8_t flags = *p++;
+        if (flags & FLAG_GAP) {
+            mem_access_t gap = {};
+            if (!get_varint(p, end, cycle) || !get_varint(p, end, gap.gap) || gap.gap == 0) {
+                return false;
+            }
+            gap.cycle = previous.cycle + cycle;
+            accesses.push_back(gap);
+            previous.cycle = gap.cycle;
+            continue;
+        }
+        if (!get_varint(p, end, cycle) || !get_varint(p, end, pc) || !get_varint(p, end, addr) ||
+            !get_varint(p, end, value)) {
+            return false;
+        }
+        mem_access_t a;
+        a.cycle = previous.cycle + cycle;
+        a.pc = previous.pc + unzigzag(static_cast<uint32_t>(pc));
+        a.addr = previous.addr + unzigzag(static_cast<uint32_t>(addr));
+        a.value = unzigzag(static_cast<uint32_t>(value));
+        a.size = static_cast<uint8_t>(1 << (flags & FLAG_SIZE_MASK));
+        a.store = (flags & FLAG_STORE) != 0;
+        accesses.push_back(a);
+        previous = a;
+    }
+    return p == end;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#ifndef MEM_TRACE_H
+#define MEM_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spim.h"
+#include "util/spsc_ring.h"
+
+/* One data load or store, or a gap where accesses were dropped. */
+struct mem_access_t {
+    uint64_t cycle; /* Instructions executed since the trace started */
+    mem_addr pc;
+    mem_addr addr;
+    int32_t value;  /* Value loaded (as returned to the instruction) or stored */
+    uint8_t size;   /* 1, 2 or 4 bytes */
+    bool store;
+    uint64_t gap = 0; /* If not 0, a gap: this many accesses from CYCLE on are missing, and the
+                         other fields are 0 */
+};
+
+/**
+ * Trace of every data load and store a CPU makes, for finding out who wrote what where (a
+ * smashed stack, a wild store into the special segment).
+ *
+ * The interpreter thread only copies each access into a lock-free ring; a writer thread owned by
+ * the trace drains the ring and does all encoding and file I/O, so the interpreter never waits on
+ * the disk. If the writer falls behind and the ring fills, accesses are dropped rather than
+ * stalling the guest, and a gap record takes their place in the trace.
+ *
+ * File format, little-endian: "SPMT", u32 version, u64 records written, u64 accesses dropped,
+ * then one record per access: a flags byte (bits 0-1 log2 of the size, bit 2 set for a store),
+ * then LEB128 varints of the cycle delta, and the zigzagged deltas of PC and address and the
+ * zigzagged value. A loop touching nearby addresses costs 4-6 bytes per access. A gap record is
+ * the flags byte 0x8 followed by varints of the cycle delta and the number of accesses dropped.
+ */
+class mem_trace_t {
+   public:
+    /* Create PATH and start the writer thread; nullptr if the file cannot be created. The ring
+       holds at least RING_CAPACITY accesses. */
+    static std::unique_ptr<mem_trace_t> open(const std::string &path, size_t ring_capacity = 1 << 16);
+
+    /* Stops the trace if close() was not called. */
+    ~mem_trace_t();
+
+    mem_trace_t(const mem_trace_t &) = delete;
+    mem_trace_t &operator=(const mem_trace_t &) = delete;
+
+    /* Advanced by the CPU before every instruction. */
+    uint64_t clock = 0;
+
+    void record(mem_addr pc, mem_addr addr, uint8_t size, int32_t value, bool store) {
+        /* The gap goes in first, so that it sits where the accesses went missing. */
+        if ((this->gap.gap == 0 || this->push_gap()) &&
+            this->ring.try_push({this->clock, pc, addr, value, size, store})) {
+            return;
+        }
+        if (this->gap.gap == 0) {
+            this->gap.cycle = this->clock;
+        }
+        ++this->gap.gap;
+        ++this->dropped;
+    }
+
+    /* Write out what is left in the ring, finish the header and close the file. False if any
+       write failed. */
+    bool close();
+
+    /* Decode the trace in PATH, gaps included; false if it is missing or malformed. DROPPED is
+       the total of the gaps. */
+    static bool read(const std::string &path, std::vector<mem_access_t> &accesses, uint64_t &dropped);
+
+   private:
+    mem_trace_t(FILE *file, size_t ring_capacity);
+
+    /* Push the pending gap; false if the ring is still full. */
+    bool push_gap() {
+        if (!this->ring.try_push(this->gap)) {
+            return false;
+        }
+        this->gap = {};
+        return true;
+    }
+
+    void write_loop();
+
+    /* Append the encoding of A (relative to PREVIOUS) to BYTES. */
+    void encode(const mem_access_t &a, std::vector<unsigned char> &bytes);
+
+    FILE *file;
+    util::SpscRing<mem_access_t> ring;
+
+    /* Only touched by the interpreter thread */
+    uint64_t dropped = 0;
+    mem_access_t gap = {}; /* Accesses dropped since the last one that made it into the ring */
+
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+
+    /* Writer thread state */
+    uint64_t written = 0;
+    bool failed = false;
+    mem_access_t previous = {};
+};
+
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef PROGRAM_IMAGE_H
+#define PROGRAM_IMAGE_H
+
+#include <memory>
+#include <vector>
+
+#include "mem.h"
+#include "spim.h"
+#include "sym-tbl.h"
+#include "text_seg.h"
+
+/**
+ * The read-only result of assembling a program: decoded instructions (which carry their
+ * encodings), the symbol table they refer to, and the initial contents of the data segments.
+ *
+ * Built once by CPU::share_program_image and handed out as a shared_ptr<const>, so that every
+ * CPU running the same bot (tournament brackets, grading runs) shares one copy of the text and
+ * symbols and only copies its own data, stack and registers in CPU::load_program_image.
+ *
+ * An image is fully linked: the exception handler and the bot are assembled together, since
+ * the handler's startup code refers to the bot's `main`.
+ */
+struct program_image_t {
+    text_segment_t text_seg;
+    mem_addr text_top;
+    text_segment_t k_text_seg;
+    mem_addr k_text_top;
+
+    /* Initial data; copied into each CPU because programs write to it. */
+    std::vector<mem_word> data_seg;
+    mem_addr data_top;
+    mem_addr gp_midpoint;
+    std::vector<mem_word> k_data_seg;
+    mem_addr k_data_top;
+
+    /* Assembler state needed to place later items and to find the entry point. */
+    mem_addr next_text_pc;
+    mem_addr next_k_text_pc;
+    mem_addr next_data_pc;
+    mem_addr next_k_data_pc;
+    mem_addr next_gp_item_addr;
+
+    /* Instructions' immediate expressions point into this table, so it lives as long as they do. */
+    std::shared_ptr<const SymbolTable> symbol_table;
+
+    /* Storage the instructions borrow from (e.g. source lines of a mapped cache file), if any. */
+    std::shared_ptr<const void> backing;
+};
+
+#endif
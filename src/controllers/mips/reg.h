@@ -236,6 +236,12 @@ struct reg_image_t {
     mem_addr next_gp_item_addr; /* Address of next item accessed off $gp */
     bool auto_alignment;
 
+    /* Loads still on their way to a register when delayed loads are simulated (see
+       CPU::run_spim). Destinations are byte offsets into this image, -1 if none, so that a copy
+       of the image (a snapshot) carries its pending loads with it. */
+    ptrdiff_t delayed_load_dest1, delayed_load_dest2;
+    reg_word delayed_load_value1, delayed_load_value2;
+
     reg_image_t() {
         this->FPR.fill(0.0);
         this->FGR = (float *)FPR.data();
@@ -267,8 +273,15 @@ struct reg_image_t {
 
         this->RFE_cycle = 0;
         this->auto_alignment = true;
+
+        this->delayed_load_dest1 = this->delayed_load_dest2 = -1;
+        this->delayed_load_value1 = this->delayed_load_value2 = 0;
     }
 
+    /* Byte offset of register DEST (in R or FPR) within this image, and back. */
+    ptrdiff_t offset_of(const reg_word *dest) const { return (const char *)dest - (const char *)this; }
+    reg_word *at_offset(ptrdiff_t offset) { return (reg_word *)((char *)this + offset); }
+
     inline reg_word &CP0_BadVAddr() { return this->CPR[0][CP0_BadVAddr_Reg]; }
 
     inline reg_word &CP0_Count() { return this->CPR[0][CP0_Count_Reg]; }
@@ -60,7 +60,7 @@ using int32 = int32_t;
 using uint32 = uint32_t;
 using intptr_union = intptr_t;
 
-bool streq(const char *s1, const char *s2) { return !strcmp(s1, s2); }
+inline bool streq(const char *s1, const char *s2) { return !strcmp(s1, s2); }
 
 /* Round V to next greatest B boundary */
 #define ROUND_UP(V, B) (((int)V + (B - 1)) & ~(B - 1))
@@ -165,11 +165,11 @@ constexpr uint32_t STACK_LIMIT = (256 * K); /* 1/4 MB */
 
 /* Name of the function to invoke at start up */
 
-constexpr char *DEFAULT_RUN_LOCATION = "__start";
+constexpr const char *DEFAULT_RUN_LOCATION = "__start";
 
 /* Name of the symbol marking the end of the exception handler */
 
-constexpr char *END_OF_TRAP_HANDLER_SYMBOL = "__eoth";
+constexpr const char *END_OF_TRAP_HANDLER_SYMBOL = "__eoth";
 
 /* Default number of instructions to execute. */
 
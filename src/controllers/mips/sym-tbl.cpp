@@ -34,8 +34,12 @@
 
 #include "sym-tbl.h"
 
+#include <string.h>
+
 #include <sstream>
 
+#include "../../util/hash.h"
+
 #include "data.h"
 #include "inst.h"
 #include "mem.h"
@@ -47,37 +51,109 @@
 #include "string-stream.h"
 
 void SymbolTable::initialize_symbol_table(bool free_labels) {
-    this->complete_table.clear();
-    this->local_labels.clear();
+    *this = SymbolTable();
+}
+
+static uint64_t hash_name(std::string_view name) {
+    uint64_t hash = util::fnv1a_64(name);
+    return hash ^ (hash >> 32); /* Fold the well-mixed high bits into the ones we mask */
+}
+
+size_t SymbolTable::probe(std::string_view name, uint64_t hash) const {
+    size_t mask = this->index.size() - 1;
+    size_t i = hash & mask;
+
+    /* Tombstones are skipped rather than reused, so a lookup and a later insert agree. */
+    while (this->index[i] != 0) {
+        uint32_t entry = this->index[i];
+        if (entry != TOMBSTONE && this->hashes[i] == hash && this->labels[entry - 1].name == name) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void SymbolTable::grow_index() {
+    size_t live = 0;
+    for (uint32_t entry : this->index) {
+        live += entry != 0 && entry != TOMBSTONE;
+    }
+
+    /* When flushed labels make up most of the load, dropping them frees enough room; otherwise a
+       program that flushes each file's locals would double the index once per few files. */
+    size_t size = MIN_INDEX_SIZE;
+    if (!this->index.empty()) {
+        size = live * 2 < this->index_used ? this->index.size() : this->index.size() * 2;
+    }
+    std::vector<uint32_t> old_index(size, 0);
+    std::vector<uint64_t> old_hashes(size, 0);
+    old_index.swap(this->index);
+    old_hashes.swap(this->hashes);
+
+    /* Rehashing drops the tombstones. */
+    this->index_used = 0;
+    for (size_t i = 0; i < old_index.size(); ++i) {
+        if (old_index[i] != 0 && old_index[i] != TOMBSTONE) {
+            size_t slot = old_hashes[i] & (size - 1);
+            while (this->index[slot] != 0) {
+                slot = (slot + 1) & (size - 1);
+            }
+            this->index[slot] = old_index[i];
+            this->hashes[slot] = old_hashes[i];
+            this->index_used += 1;
+        }
+    }
 }
 
 /* Lookup label with NAME.  Either return its symbol table entry or NULL
    if it is not in the table. */
 
-label *SymbolTable::label_is_defined(const std::string &name) {
-    auto it = this->complete_table.find(name);
-    return it == this->complete_table.end() ? nullptr : &it->second;
+label *SymbolTable::label_is_defined(std::string_view name) {
+    return const_cast<label *>(static_cast<const SymbolTable *>(this)->label_is_defined(name));
+}
+
+const label *SymbolTable::label_is_defined(std::string_view name) const {
+    if (this->index.empty()) {
+        return nullptr;
+    }
+    uint32_t entry = this->index[probe(name, hash_name(name))];
+    return entry == 0 ? nullptr : &this->labels[entry - 1];
 }
 
 /* Return a label with a given NAME.  If an label with that name has
    previously been looked-up, the same node is returned this time.  */
 
-label *SymbolTable::lookup_label(const std::string &name) {
-    auto &&result = this->complete_table.find(name);
+label *SymbolTable::lookup_label(std::string_view name) {
+    /* Keep the index at most 3/4 full, counting tombstones. */
+    if ((this->index_used + 1) * 4 > this->index.size() * 3) {
+        grow_index();
+    }
 
-    if (result != this->complete_table.end()) {
-        return &(result->second);
+    uint64_t hash = hash_name(name);
+    size_t slot = probe(name, hash);
+    if (this->index[slot] != 0) {
+        return &this->labels[this->index[slot] - 1];
     }
 
-    /* Not found, create one, create one */
-    auto &&label = this->complete_table[name];
-    label.name = name;
-    return &label;
+    /* Not found, create one */
+    char *interned = static_cast<char *>(this->names.allocate(name.size() + 1, 1));
+    memcpy(interned, name.data(), name.size());
+    interned[name.size()] = '\0';
+
+    this->labels.emplace_back();
+    label &l = this->labels.back();
+    l.name = std::string_view(interned, name.size());
+
+    this->index[slot] = this->labels.size();
+    this->hashes[slot] = hash;
+    this->index_used += 1;
+    return &l;
 }
 
 /* Make the label named NAME global.  Return its symbol. */
 
-label *SymbolTable::make_label_global(const std::string &name) {
+label *SymbolTable::make_label_global(std::string_view name) {
     label *l = lookup_label(name);
     l->global_flag = true;
     return l;
@@ -88,14 +164,15 @@ label *SymbolTable::make_label_global(const std::string &name) {
 void SymbolTable::record_inst_uses_symbol(instruction *inst, label *sym) {
     label_use u;
 
-    if (data_dir) { /* Want to free up original instruction */
-        u.inst = copy_inst(inst);
+    /* INST lives in the text arena even when it is only encoded into data, so no copy is
+       needed to keep it until the label is resolved. */
+    u.inst = inst;
+    if (data_dir) {
         u.addr = current_data_pc();
     } else {
-        u.inst = inst;
         u.addr = current_text_pc();
     }
-    sym->uses.push_front(u);
+    sym->uses.push_back(u);
 }
 
 /* Record that a memory LOCATION uses the as-yet undefined SYMBOL. */
@@ -104,24 +181,25 @@ void SymbolTable::record_data_uses_symbol(mem_addr location, label *sym) {
     label_use u;
     u.inst = nullptr;
     u.addr = location;
-    sym->uses.push_front(u);
+    sym->uses.push_back(u);
 }
 
 /* Remove all local (non-global) label from the table. */
 
 void SymbolTable::flush_local_labels(bool issue_undef_warnings) {
-    label *l;
-
-    while (!this->local_labels.empty()) {
-        label &l = this->local_labels.front();
-        this->local_labels.pop_front();
+    for (label *l : this->local_labels) {
+        if (l->flushed) {
+            continue; /* Recorded twice */
+        }
 
-        if (issue_undef_warnings && l.addr == 0 && !l.const_flag) {
-            error("Warning: local symbol %s was not defined\n", l.name);
+        if (issue_undef_warnings && l->addr == 0 && !l->const_flag) {
+            error("Warning: local symbol %s was not defined\n", l->name.data());
         }
 
-        // Delete label (owned by hashmap)
-        this->complete_table.erase(l.name);
+        /* Unlink from the index; the label itself stays put for instructions that use it. */
+        this->index[probe(l->name, hash_name(l->name))] = TOMBSTONE;
+        l->flushed = true;
+        std::vector<label_use>().swap(l->uses);
     }
 
     this->local_labels.clear();
@@ -129,8 +207,8 @@ void SymbolTable::flush_local_labels(bool issue_undef_warnings) {
 
 /* Return the address of SYMBOL or 0 if it is undefined. */
 
-mem_addr SymbolTable::find_symbol_address(const std::string &symbol) {
-    label *l = lookup_label(symbol);
+mem_addr SymbolTable::find_symbol_address(std::string_view symbol) const {
+    const label *l = label_is_defined(symbol);
 
     if (l == nullptr || l->addr == 0) {
         return 0;
@@ -142,37 +220,33 @@ mem_addr SymbolTable::find_symbol_address(const std::string &symbol) {
 /* Print all symbols in the table. */
 
 void SymbolTable::print_symbols(port message_out) const {
-    for (const auto &it : this->complete_table) {
-        const label &l = it.second;
-
-        write_output(message_out, "%s%s at 0x%08x\n", l.global_flag ? "g\t" : "\t", l.name, l.addr);
-    }
+    for_each_label([&](const label &l) {
+        write_output(message_out, "%s%s at 0x%08x\n", l.global_flag ? "g\t" : "\t", l.name.data(),
+                     l.addr);
+    });
 }
 
 /* Print all undefined symbols in the table. */
 
 void SymbolTable::print_undefined_symbols(port message_out) const {
-    for (const auto &it : this->complete_table) {
-        const label &l = it.second;
-
+    for_each_label([&](const label &l) {
         if (l.addr == 0) {
-            write_output(message_out, "%s\n", l.name);
+            write_output(message_out, "%s\n", l.name.data());
         }
-    }
+    });
 }
 
 /* Return a string containing the names of all undefined symbols in the
    table, seperated by a newline character.  Return NULL if no symbols
    are undefined. */
 
-std::string SymbolTable::undefined_symbol_string() {
+std::string SymbolTable::undefined_symbol_string() const {
     std::stringstream stream;
 
-    for (const auto &it : this->complete_table) {
-        const label &l = it.second;
+    for_each_label([&](const label &l) {
         if (l.addr == 0) {
             stream << l.name << '\n';
         }
-    }
+    });
     return stream.str();
 }
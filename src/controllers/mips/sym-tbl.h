@@ -31,11 +31,14 @@
    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-#include <forward_list>
-#include <functional>
-#include <unordered_map>
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "arena.h"
 #include "inst.h"
 
 struct label_use {
@@ -51,45 +54,50 @@ struct label_use {
 /* Symbol table information on a label. */
 
 struct label {
-    // char *name;
-    std::string name;     /* Name of label */
-    mem_addr addr;        /* Address of label or 0 if not yet defined */
-    bool global_flag : 1; /* Non-zero => declared global */
-    bool gp_flag : 1;     /* Non-zero => referenced off gp */
-    bool const_flag : 1;  /* Non-zero => constant value (in addr) */
-    // label *next_local;                 /* Link in list of local labels */
-    std::forward_list<label_use> uses; /* List of instructions that reference */
+    std::string_view name; /* Name of label, interned (and NUL-terminated) by the table */
+    mem_addr addr;         /* Address of label or 0 if not yet defined */
+    bool global_flag : 1;  /* Non-zero => declared global */
+    bool gp_flag : 1;      /* Non-zero => referenced off gp */
+    bool const_flag : 1;   /* Non-zero => constant value (in addr) */
+    bool flushed : 1;      /* Non-zero => local label removed at end of file */
+    std::vector<label_use> uses; /* Instructions and data that reference the label */
 
     inline label() {
-        name = "";
         addr = 0;
         global_flag = false;
         gp_flag = false;
         const_flag = false;
+        flushed = false;
     }
 }; /* label that has not yet been defined */
 
 /**
- * WARNING:
- * The following code relies extremely heavily on the fact that:
+ * Labels by name.
  *
- * > If rehashing occurs due to the insertion, all iterators are invalidated.
- * > Otherwise iterators are not affected. References are not invalidated.
- * >
- * > Source C++ Standard
- * > URL: http://eel.is/c++draft/unord.req#9
+ * Names are interned into an arena and labels live in a deque, so neither ever moves: the
+ * label pointers that instructions' immediate expressions hold stay valid for the life of the
+ * table, including across a move (CPU::share_program_image relies on that). Lookups go through
+ * a small open-addressing index of label numbers that grows as labels are added, so an empty
+ * table costs almost nothing to build.
  *
- * We use this to keep track of references in the local table and maintain forward pointers
- * for the linked list. There is probably going to be a significant effort in updating this
- * code to modern C++.
+ * Flushing local labels only unlinks them from the index; their storage is kept, since
+ * instructions assembled earlier may still point to them.
  */
 class SymbolTable {
+    std::deque<label> labels;
+
+    /* Backing store for label names. */
+    asm_arena_t names;
+
     /**
-     * Map from name of a label to a label structure.
-     *
-     * Try to see if we can convert this to a smart pointer with actual ownership
+     * Linear-probing index: 0 is an empty slot, TOMBSTONE a flushed one, anything else is a
+     * label number + 1. HASHES caches each slot's full hash so probes rarely compare names.
      */
-    std::unordered_map<std::string, label> complete_table;
+    static constexpr uint32_t TOMBSTONE = UINT32_MAX;
+    static constexpr size_t MIN_INDEX_SIZE = 64;
+    std::vector<uint32_t> index;
+    std::vector<uint64_t> hashes;
+    size_t index_used = 0; /* Live entries and tombstones */
 
     /**
      * Keep track of the memory location that a label represents.  If we
@@ -100,19 +108,22 @@ class SymbolTable {
      * At the end of a file, we flush the hash table of all non-global
      * labels so they can't be seen in other files.
      */
+    std::vector<label *> local_labels;
 
-    // label *local_labels;  // Try to make this a C++ linked list, but this might require a major
-    //                       // refactoring
-
-    std::forward_list<std::reference_wrapper<label>> local_labels;
+    /* Slot in INDEX holding NAME, or the empty slot where it would go. */
+    size_t probe(std::string_view name, uint64_t hash) const;
+    /* Rehash INDEX without its tombstones, doubling it unless they were most of its load. */
+    void grow_index();
 
    public:
-    inline SymbolTable() { complete_table.reserve(8191); }
+    SymbolTable() = default;
+    SymbolTable(SymbolTable &&) = default;
+    SymbolTable &operator=(SymbolTable &&) = default;
 
     /**
      * Return the address of SYMBOL or 0 if it is undefined.
      */
-    mem_addr find_symbol_address(const std::string &symbol);
+    mem_addr find_symbol_address(std::string_view symbol) const;
 
     /**
      * Remove all local (non-global) label from the table.
@@ -128,19 +139,50 @@ class SymbolTable {
      * Lookup label with NAME.  Either return its symbol table entry or NULL
      * if it is not in the table.
      */
-    label *label_is_defined(const std::string &name);
+    label *label_is_defined(std::string_view name);
+    const label *label_is_defined(std::string_view name) const;
 
     /**
      * Return a label with a given NAME.  If an label with that name has
      * previously been looked-up, the same node is returned this time.
      */
-    label *lookup_label(const std::string &name);
+    label *lookup_label(std::string_view name);
 
     /**
      * Make the label named NAME global.
      * Return its symbol.
      */
-    label *make_label_global(const std::string &name);
+    label *make_label_global(std::string_view name);
+
+    /**
+     * Remember that L is local to the current file, so that flush_local_labels removes it.
+     */
+    void record_local_label(label *l) { this->local_labels.push_back(l); }
+
+    /**
+     * Call F on every label still in the table.
+     */
+    template <typename F>
+    void for_each_label(F &&f) const {
+        for (const label &l : this->labels) {
+            if (!l.flushed) {
+                f(l);
+            }
+        }
+    }
+
+    /**
+     * Call F on every label with an address, including local labels that were flushed at the
+     * end of their file (they still name code, e.g. in profiles). Constants are skipped.
+     */
+    template <typename F>
+    void for_each_defined_label(F &&f) const {
+        for (const label &l : this->labels) {
+            if (l.addr != 0 && !l.const_flag) {
+                f(l);
+            }
+        }
+    }
 
     /**
      * Print all symbols in the table.
@@ -167,7 +209,7 @@ class SymbolTable {
      * table, seperated by a newline character.  Return NULL if no symbols
      * are undefined.
      */
-    std::string undefined_symbol_string();
+    std::string undefined_symbol_string() const;
 
     friend class CPU;
 };
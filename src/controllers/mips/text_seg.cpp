@@ -0,0 +1,26 @@
+#include "text_seg.h"
+
+void text_segment_t::reset(size_t n) {
+    /* Dropping our reference frees the old arena unless another CPU still shares it. */
+    this->storage = std::make_shared<storage_t>();
+    this->storage->insts.assign(n, nullptr);
+    this->owned.store(true, std::memory_order_relaxed);
+}
+
+void text_segment_t::detach() {
+    if (!is_shared()) {
+        return;
+    }
+
+    auto copy = std::make_shared<storage_t>();
+    copy->insts.assign(this->storage->insts.size(), nullptr);
+
+    for (size_t i = 0; i < this->storage->insts.size(); ++i) {
+        const instruction *inst = this->storage->insts[i];
+        if (inst != nullptr) {
+            copy->insts[i] = instruction::copy_inst(copy->arena, inst);
+        }
+    }
+    this->storage = std::move(copy);
+    this->owned.store(true, std::memory_order_relaxed);
+}
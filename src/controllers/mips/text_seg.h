@@ -0,0 +1,108 @@
+#pragma once
+
+#ifndef TEXT_SEG_H
+#define TEXT_SEG_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "arena.h"
+#include "inst.h"
+
+/**
+ * A text segment whose instruction array can be shared between several CPUs.
+ *
+ * Copies are cheap: they share the same array of decoded instructions and only bump a
+ * reference count. Copying marks both the copy and its source as shared; the first write
+ * through a shared segment (self-modifying code, breakpoints, assembling more code) clones the
+ * array and the instructions it points to, so readers never observe another CPU's writes.
+ * Ownership is an explicit flag rather than the reference count, which other threads' copies
+ * can change at any time.
+ *
+ * The instructions, and the expressions they point to, live in an arena that belongs to the
+ * array; it is released in one go when the last segment referencing it is reset or destroyed.
+ */
+class text_segment_t {
+   public:
+    text_segment_t() = default;
+
+    /* A copy is never owned, and copying a segment gives up the source's ownership too. Several
+       CPUs may copy one image's segment at once, hence the atomic flag. */
+    text_segment_t(const text_segment_t &other) : storage(other.storage), owned(false) { other.disown(); }
+    text_segment_t &operator=(const text_segment_t &other) {
+        if (this != &other) {
+            this->storage = other.storage;
+            this->owned.store(false, std::memory_order_relaxed);
+            other.disown();
+        }
+        return *this;
+    }
+    text_segment_t(text_segment_t &&other) noexcept
+        : storage(std::move(other.storage)), owned(other.owned.load(std::memory_order_relaxed)) {}
+    text_segment_t &operator=(text_segment_t &&other) noexcept {
+        this->storage = std::move(other.storage);
+        this->owned.store(other.owned.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /* Replace the contents with N empty (nullptr) slots and a fresh arena owned only by this
+       segment. */
+    void reset(size_t n);
+
+    size_t size() const { return storage ? storage->insts.size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    /* Read-only access; never detaches. */
+    instruction *operator[](size_t i) const { return storage->insts[i]; }
+    instruction *const *data() const { return storage ? storage->insts.data() : nullptr; }
+
+    /**
+     * The arena that instructions stored in this segment should be allocated from. Detaches
+     * first, so that what is allocated lives exactly as long as the array it is stored in.
+     */
+    asm_arena_t &arena() {
+        detach();
+        return storage->arena;
+    }
+
+    /**
+     * Store INST in slot I. INST must come from arena(); the previous occupant is not freed, the
+     * arena reclaims it on reset. Once arena() has been called, the instructions in the slots
+     * belong to this segment alone and may be modified in place.
+     */
+    void set(size_t i, instruction *inst) {
+        detach();
+        storage->insts[i] = inst;
+    }
+
+    /* Bytes allocated from the arena so far. */
+    size_t arena_bytes() const { return storage ? storage->arena.bytes_used() : 0; }
+
+    /* True unless this segment is known to be the only one referencing its instructions. */
+    bool is_shared() const { return storage && !owned.load(std::memory_order_relaxed); }
+
+   private:
+    struct storage_t {
+        std::vector<instruction *> insts;
+        asm_arena_t arena;
+    };
+
+    /* Give this segment its own copy of the instructions if they are shared. */
+    void detach();
+
+    void disown() const {
+        if (owned.load(std::memory_order_relaxed)) {
+            owned.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::shared_ptr<storage_t> storage;
+
+    /* This segment is the only one referencing STORAGE and may write through it. */
+    mutable std::atomic<bool> owned{true};
+};
+
+#endif
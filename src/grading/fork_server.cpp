@@ -0,0 +1,172 @@
+#include "fork_server.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <exception>
+#include <utility>
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+ForkServer::ForkServer(Grader grader, int jobs, unsigned timeout_seconds)
+    : grader(std::move(grader)), jobs(jobs < 1 ? 1 : jobs), timeout_seconds(timeout_seconds) {}
+
+ForkServer::Child ForkServer::spawn(const std::string &submission) {
+    /* Anything still buffered would otherwise be written once by every child. */
+    fflush(nullptr);
+
+    Child child = {fork(), submission, now_seconds()};
+    if (child.pid != 0) {
+        return child;
+    }
+
+    /* Child: the default SIGALRM action terminates us, which the parent reports as a timeout. */
+    signal(SIGALRM, SIG_DFL);
+    if (this->timeout_seconds != 0) {
+        alarm(this->timeout_seconds);
+    }
+
+    /* An exception must not unwind into serve(), or the child would go on reading submissions. */
+    int status = 1;
+    try {
+        status = this->grader(submission);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s: %s\n", submission.c_str(), e.what());
+    } catch (...) {
+        fprintf(stderr, "%s: unknown exception\n", submission.c_str());
+    }
+    fflush(nullptr);
+
+    /* Skip static destructors and atexit handlers that belong to the parent's state. */
+    _exit(status);
+}
+
+GradingResult ForkServer::reap(std::vector<Child> &running) {
+    /* Only wait for our own children: waitpid(-1) could reap one the caller forked itself. A
+       single child can be waited for directly. Otherwise check them all with SIGCHLD blocked and,
+       if none has exited, sleep until the next SIGCHLD; it stays pending if it arrives between
+       the check and the wait. */
+    sigset_t sigchld, saved_mask;
+    sigemptyset(&sigchld);
+    sigaddset(&sigchld, SIGCHLD);
+    pthread_sigmask(SIG_BLOCK, &sigchld, &saved_mask);
+
+    for (;;) {
+        for (auto it = running.begin(); it != running.end(); ++it) {
+            int status = 0;
+            pid_t pid = waitpid(it->pid, &status, running.size() == 1 ? 0 : WNOHANG);
+            if (pid == 0 || (pid == -1 && errno == EINTR)) {
+                continue;
+            }
+
+            GradingResult result;
+            result.submission = it->submission;
+            result.wall_seconds = now_seconds() - it->start;
+            if (pid == -1) {
+                /* Someone else reaped it (ECHILD), so its status is lost. */
+                result.status_lost = true;
+            } else if (WIFEXITED(status)) {
+                result.exit_status = WEXITSTATUS(status);
+            } else if (WIFSIGNALED(status)) {
+                result.term_signal = WTERMSIG(status);
+                result.timed_out = result.term_signal == SIGALRM;
+            }
+            running.erase(it);
+            pthread_sigmask(SIG_SETMASK, &saved_mask, nullptr);
+            return result;
+        }
+        if (running.size() > 1) {
+            /* In a threaded caller another thread may take the signal, so never sleep for long. */
+            const struct timespec limit = {0, 100000000};
+            sigtimedwait(&sigchld, nullptr, &limit);
+        }
+    }
+}
+
+GradingResult ForkServer::grade(const std::string &submission) {
+    std::vector<Child> running;
+
+    Child child = spawn(submission);
+    if (child.pid == -1) {
+        GradingResult result;
+        result.submission = submission;
+        result.fork_failed = true;
+        return result;
+    }
+
+    running.push_back(child);
+    return reap(running);
+}
+
+int ForkServer::serve(FILE *in, FILE *out) {
+    std::vector<Child> running;
+    int failures = 0;
+
+    auto finish_one = [&]() {
+        GradingResult result = reap(running);
+        if (result.exit_status != 0) {
+            ++failures;
+        }
+        print_result(out, result);
+    };
+
+    char *line = nullptr;
+    size_t capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &capacity, in)) != -1) {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+        if (length == 0) {
+            continue;
+        }
+
+        if ((int)running.size() >= this->jobs) {
+            finish_one();
+        }
+
+        Child child = spawn(line);
+        if (child.pid == -1) {
+            GradingResult result;
+            result.submission = line;
+            result.fork_failed = true;
+            ++failures;
+            print_result(out, result);
+            continue;
+        }
+        running.push_back(child);
+    }
+    free(line);
+
+    while (!running.empty()) {
+        finish_one();
+    }
+    return failures;
+}
+
+void ForkServer::print_result(FILE *out, const GradingResult &result) {
+    if (result.timed_out) {
+        fprintf(out, "%s\ttimeout\t%.3f\n", result.submission.c_str(), result.wall_seconds);
+    } else if (result.term_signal != 0) {
+        fprintf(out, "%s\tsignal %s\t%.3f\n", result.submission.c_str(),
+                strsignal(result.term_signal), result.wall_seconds);
+    } else if (result.fork_failed) {
+        fprintf(out, "%s\tfork failed\n", result.submission.c_str());
+    } else if (result.status_lost) {
+        fprintf(out, "%s\tstatus lost\t%.3f\n", result.submission.c_str(), result.wall_seconds);
+    } else {
+        fprintf(out, "%s\texit %d\t%.3f\n", result.submission.c_str(), result.exit_status,
+                result.wall_seconds);
+    }
+    fflush(out);
+}
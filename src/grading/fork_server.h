@@ -0,0 +1,85 @@
+/**
+ * Fork server for grading many submissions.
+ *
+ * The parent process pays for everything that does not depend on the submission once (whatever
+ * the caller sets up before calling serve(): Qt, logging, parser tables) and then forks a child
+ * for every submission. The child inherits that state copy-on-write, so it only has to assemble and run
+ * the student code. A crashing, looping or misbehaving submission still only takes down its
+ * own process.
+ */
+
+#pragma once
+
+#ifndef GRADING_FORK_SERVER_H_
+#define GRADING_FORK_SERVER_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Outcome of grading one submission, as observed by the parent.
+ */
+struct GradingResult {
+    std::string submission;
+    int exit_status = -1;  // Exit code of the child when it exited normally
+    int term_signal = 0;   // Signal that killed the child, 0 if it exited
+    bool timed_out = false;
+    bool fork_failed = false;
+    bool status_lost = false;  // Another waitpid in the process reaped the child first
+    double wall_seconds = 0;
+};
+
+class ForkServer {
+   public:
+    /**
+     * Runs in the child with the submission path and returns the child's exit status. Anything
+     * it leaves behind (memory, open files) dies with the child. If it throws, the child exits
+     * with status 1.
+     */
+    using Grader = std::function<int(const std::string &submission)>;
+
+    /**
+     * GRADER runs each submission; at most JOBS children run at once. A child that runs for more
+     * than TIMEOUT_SECONDS (0 disables the limit) is killed.
+     */
+    explicit ForkServer(Grader grader, int jobs = 1, unsigned timeout_seconds = 0);
+
+    /**
+     * Grade a single submission and wait for it.
+     */
+    GradingResult grade(const std::string &submission);
+
+    /**
+     * Read submission paths from IN, one per line, and write one result line per submission to
+     * OUT in completion order. Returns the number of submissions whose child did not exit with
+     * status 0.
+     */
+    int serve(FILE *in, FILE *out);
+
+   private:
+    struct Child {
+        pid_t pid;
+        std::string submission;
+        double start;
+    };
+
+    /* Fork a child for SUBMISSION; returns the child or a pid of -1 if fork failed. */
+    Child spawn(const std::string &submission);
+
+    /* Block until one of RUNNING exits, remove it and return its result. RUNNING must not be
+       empty. Other children of the process are left alone, but SIGCHLDs that arrive while
+       waiting for more than one child are consumed rather than delivered to a handler. */
+    GradingResult reap(std::vector<Child> &running);
+
+    static void print_result(FILE *out, const GradingResult &result);
+
+    Grader grader;
+    int jobs;
+    unsigned timeout_seconds;
+};
+
+#endif
@@ -2,10 +2,13 @@
 #ifndef SPIMBOT_PARSER_DIRECTIVE_AST_H
 #define SPIMBOT_PARSER_DIRECTIVE_AST_H
 
+#include <optional>
+#include <string_view>
 #include <variant>
 
 #include "../expression/ast.h"
 #include "../parser_helpers.h"
+#include "../string_literal.h"
 #include "symbols.h"
 
 namespace client {
@@ -13,7 +16,7 @@ namespace ast {
 
 namespace x3 = boost::spirit::x3;
 
-/* AST Nodes */
+/* AST Nodes. Names and string literals are views into the source text. */
 struct AliasDir : x3::position_tagged {
     int reg1;
     int reg2;
@@ -28,9 +31,9 @@ struct AlignDir : x3::position_tagged {
     client::ast::expression alignment;
 };
 
-struct AsciiDir : x3::position_tagged, std::vector<std::string> {};
+struct AsciiDir : x3::position_tagged, std::vector<StringLiteral> {};
 
-struct AsciizDir : x3::position_tagged, std::vector<std::string> {};
+struct AsciizDir : x3::position_tagged, std::vector<StringLiteral> {};
 
 struct Asm0Dir : x3::position_tagged {};
 
@@ -47,7 +50,7 @@ struct ByteDir : x3::position_tagged {
 };
 
 struct CommDir : x3::position_tagged {
-    std::string ident;
+    std::string_view ident;
     client::ast::expression expr;
 };
 
@@ -71,7 +74,7 @@ struct DoubleRepeatDir : x3::position_tagged {
  * Should be matched with an ENT name for debugging purposes
  */
 struct EndDir : x3::position_tagged {
-    std::optional<std::string> proc_name;
+    std::optional<std::string_view> proc_name;
 };
 
 /**
@@ -90,7 +93,7 @@ struct EndrDir : x3::position_tagged {};
  * The beginning of a proc name
  */
 struct EntDir : x3::position_tagged {
-    std::string proc_name;
+    std::string_view proc_name;
     std::optional<uint32_t> lex_level;
 };
 
@@ -98,7 +101,7 @@ struct ExternDir : x3::position_tagged {
     /**
      * Symbol defined in other file
      */
-    std::string name;
+    std::string_view name;
 
     /**
      * Expected size of the external object
@@ -112,7 +115,7 @@ struct ErrDir : x3::position_tagged {};
 
 struct FileDir : x3::position_tagged {
     int32_t file_no;
-    std::string filename;
+    StringLiteral filename;
 };
 
 struct FloatDir : x3::position_tagged {
@@ -141,7 +144,7 @@ struct FrameDir : x3::position_tagged {
 };
 
 struct GlobalDir : x3::position_tagged {
-    std::string id;
+    std::string_view id;
 };
 
 struct HalfDir : x3::position_tagged {
@@ -153,11 +156,11 @@ struct HalfRepeatDir : x3::position_tagged {
 };
 
 struct LabelDir : x3::position_tagged {
-    std::string label_name;
+    std::string_view label_name;
 };
 
 struct LcommDir : x3::position_tagged {
-    std::string name;
+    std::string_view name;
     client::ast::expression expr;
 };
 
@@ -192,7 +195,7 @@ struct NoaliasDir : x3::position_tagged {
 };
 
 struct OptionDir : x3::position_tagged {
-    std::string option;
+    std::string_view option;
 };
 
 struct RepeatDir : x3::position_tagged {
@@ -215,7 +218,7 @@ struct SDataDir : x3::position_tagged {
 
 struct SetDir : x3::position_tagged {
     // Only at and noat supported
-    std::string option;
+    std::string_view option;
 };
 
 struct SpaceDir : x3::position_tagged {
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_DIRECTIVE_NAMES_H
+#define SPIMBOT_PARSER_DIRECTIVE_NAMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../primitives/perfect_hash.h"
+
+namespace mips_parser {
+
+enum class DirectiveKind : uint8_t {
+    ALIAS,
+    ALIGN,
+    ASCII,
+    ASCIIZ,
+    ASM0,
+    BGNB,
+    BYTE,
+    COMM,
+    DATA,
+    KDATA,
+    DOUBLE,
+    END,
+    ENDB,
+    ENDR,
+    ENT,
+    ERR,
+    EXTERN,
+    FILE,
+    FLOAT,
+    FMASK,
+    FRAME,
+    GLOBAL,
+    HALF,
+    LABEL,
+    LCOMM,
+    LIVEREG,
+    LOC,
+    MASK,
+    NOALIAS,
+    OPTIONS,
+    RDATA,
+    REPEAT,
+    SDATA,
+    SET,
+    SPACE,
+    STRUCT,
+    TEXT,
+    KTEXT,
+    VERSTAMP,
+    VREG,
+    WORD,
+};
+
+struct DirectiveName {
+    std::string_view name;
+    DirectiveKind kind;
+};
+
+/* In DirectiveKind order, so directive_name() can index it. */
+inline constexpr DirectiveName DIRECTIVE_LIST[] = {
+    {".alias", DirectiveKind::ALIAS},
+    {".align", DirectiveKind::ALIGN},
+    {".ascii", DirectiveKind::ASCII},
+    {".asciiz", DirectiveKind::ASCIIZ},
+    {".asm0", DirectiveKind::ASM0},
+    {".bgnb", DirectiveKind::BGNB},
+    {".byte", DirectiveKind::BYTE},
+    {".comm", DirectiveKind::COMM},
+    {".data", DirectiveKind::DATA},
+    {".kdata", DirectiveKind::KDATA},
+    {".double", DirectiveKind::DOUBLE},
+    {".end", DirectiveKind::END},
+    {".endb", DirectiveKind::ENDB},
+    {".endr", DirectiveKind::ENDR},
+    {".ent", DirectiveKind::ENT},
+    {".err", DirectiveKind::ERR},
+    {".extern", DirectiveKind::EXTERN},
+    {".file", DirectiveKind::FILE},
+    {".float", DirectiveKind::FLOAT},
+    {".fmask", DirectiveKind::FMASK},
+    {".frame", DirectiveKind::FRAME},
+    {".globl", DirectiveKind::GLOBAL},
+    {".half", DirectiveKind::HALF},
+    {".lab", DirectiveKind::LABEL},
+    {".lcomm", DirectiveKind::LCOMM},
+    {".livereg", DirectiveKind::LIVEREG},
+    {".loc", DirectiveKind::LOC},
+    {".mask", DirectiveKind::MASK},
+    {".noalias", DirectiveKind::NOALIAS},
+    {".option", DirectiveKind::OPTIONS},
+    {".rdata", DirectiveKind::RDATA},
+    {".repeat", DirectiveKind::REPEAT},
+    {".sdata", DirectiveKind::SDATA},
+    {".set", DirectiveKind::SET},
+    {".space", DirectiveKind::SPACE},
+    {".struct", DirectiveKind::STRUCT},
+    {".text", DirectiveKind::TEXT},
+    {".ktext", DirectiveKind::KTEXT},
+    {".verstamp", DirectiveKind::VERSTAMP},
+    {".vreg", DirectiveKind::VREG},
+    {".word", DirectiveKind::WORD},
+};
+
+constexpr bool directive_list_in_order() {
+    for (size_t i = 0; i < sizeof(DIRECTIVE_LIST) / sizeof(DIRECTIVE_LIST[0]); i++) {
+        if (static_cast<size_t>(DIRECTIVE_LIST[i].kind) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(directive_list_in_order(), "DIRECTIVE_LIST must follow DirectiveKind");
+
+constexpr std::string_view directive_name(DirectiveKind kind) { return DIRECTIVE_LIST[static_cast<size_t>(kind)].name; }
+
+/* Directive name -> DirectiveName, e.g. directives.find(".word"). A constexpr perfect hash. */
+inline constexpr auto directives =
+    make_keyword_table(DIRECTIVE_LIST, [](const DirectiveName &dir) { return dir.name; });
+
+}  // namespace mips_parser
+
+#endif
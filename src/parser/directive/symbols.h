@@ -5,52 +5,52 @@
 #include <string>
 
 #include "../parser_helpers.h"
+#include "directive_names.h"
 
 namespace mips_parser {
-using namespace std::literals;
 
 /* Directives */
-const auto ALIAS_DIR = ".alias"s;
-const auto ALIGN_DIR = ".align"s;
-const auto ASCII_DIR = ".ascii"s;
-const auto ASCIIZ_DIR = ".asciiz"s;
-const auto ASM0_DIR = ".asm0"s;
-const auto BGNB_DIR = ".bgnb"s;
-const auto BYTE_DIR = ".byte"s;
-const auto COMM_DIR = ".comm"s;
-const auto DATA_DIR = ".data"s;
-const auto KDATA_DIR = ".kdata"s;
-const auto DOUBLE_DIR = ".double"s;
-const auto END_DIR = ".end"s;
-const auto ENDB_DIR = ".endb"s;
-const auto ENDR_DIR = ".endr"s;
-const auto ENT_DIR = ".ent"s;
-const auto ERR_DIR = ".err"s;
-const auto EXTERN_DIR = ".extern"s;
-const auto FILE_DIR = ".file"s;
-const auto FLOAT_DIR = ".float"s;
-const auto FMASK_DIR = ".fmask"s;
-const auto FRAME_DIR = ".frame"s;
-const auto GLOBAL_DIR = ".globl"s;
-const auto HALF_DIR = ".half"s;
-const auto LABEL_DIR = ".lab"s;
-const auto LCOMM_DIR = ".lcomm"s;
-const auto LIVEREG_DIR = ".livereg"s;
-const auto LOC_DIR = ".loc"s;
-const auto MASK_DIR = ".mask"s;
-const auto NOALIAS_DIR = ".noalias"s;
-const auto OPTIONS_DIR = ".option"s;
-const auto RDATA_DIR = ".rdata"s;
-const auto REPEAT_DIR = ".repeat"s;
-const auto SDATA_DIR = ".sdata"s;
-const auto SET_DIR = ".set"s;
-const auto SPACE_DIR = ".space"s;
-const auto STRUCT_DIR = ".struct"s;
-const auto TEXT_DIR = ".text"s;
-const auto KTEXT_DIR = ".ktext"s;
-const auto VERSTAMP_DIR = ".verstamp"s;
-const auto VREG_DIR = ".vreg"s;
-const auto WORD_DIR = ".word"s;
+const auto ALIAS_DIR = std::string(directive_name(DirectiveKind::ALIAS));
+const auto ALIGN_DIR = std::string(directive_name(DirectiveKind::ALIGN));
+const auto ASCII_DIR = std::string(directive_name(DirectiveKind::ASCII));
+const auto ASCIIZ_DIR = std::string(directive_name(DirectiveKind::ASCIIZ));
+const auto ASM0_DIR = std::string(directive_name(DirectiveKind::ASM0));
+const auto BGNB_DIR = std::string(directive_name(DirectiveKind::BGNB));
+const auto BYTE_DIR = std::string(directive_name(DirectiveKind::BYTE));
+const auto COMM_DIR = std::string(directive_name(DirectiveKind::COMM));
+const auto DATA_DIR = std::string(directive_name(DirectiveKind::DATA));
+const auto KDATA_DIR = std::string(directive_name(DirectiveKind::KDATA));
+const auto DOUBLE_DIR = std::string(directive_name(DirectiveKind::DOUBLE));
+const auto END_DIR = std::string(directive_name(DirectiveKind::END));
+const auto ENDB_DIR = std::string(directive_name(DirectiveKind::ENDB));
+const auto ENDR_DIR = std::string(directive_name(DirectiveKind::ENDR));
+const auto ENT_DIR = std::string(directive_name(DirectiveKind::ENT));
+const auto ERR_DIR = std::string(directive_name(DirectiveKind::ERR));
+const auto EXTERN_DIR = std::string(directive_name(DirectiveKind::EXTERN));
+const auto FILE_DIR = std::string(directive_name(DirectiveKind::FILE));
+const auto FLOAT_DIR = std::string(directive_name(DirectiveKind::FLOAT));
+const auto FMASK_DIR = std::string(directive_name(DirectiveKind::FMASK));
+const auto FRAME_DIR = std::string(directive_name(DirectiveKind::FRAME));
+const auto GLOBAL_DIR = std::string(directive_name(DirectiveKind::GLOBAL));
+const auto HALF_DIR = std::string(directive_name(DirectiveKind::HALF));
+const auto LABEL_DIR = std::string(directive_name(DirectiveKind::LABEL));
+const auto LCOMM_DIR = std::string(directive_name(DirectiveKind::LCOMM));
+const auto LIVEREG_DIR = std::string(directive_name(DirectiveKind::LIVEREG));
+const auto LOC_DIR = std::string(directive_name(DirectiveKind::LOC));
+const auto MASK_DIR = std::string(directive_name(DirectiveKind::MASK));
+const auto NOALIAS_DIR = std::string(directive_name(DirectiveKind::NOALIAS));
+const auto OPTIONS_DIR = std::string(directive_name(DirectiveKind::OPTIONS));
+const auto RDATA_DIR = std::string(directive_name(DirectiveKind::RDATA));
+const auto REPEAT_DIR = std::string(directive_name(DirectiveKind::REPEAT));
+const auto SDATA_DIR = std::string(directive_name(DirectiveKind::SDATA));
+const auto SET_DIR = std::string(directive_name(DirectiveKind::SET));
+const auto SPACE_DIR = std::string(directive_name(DirectiveKind::SPACE));
+const auto STRUCT_DIR = std::string(directive_name(DirectiveKind::STRUCT));
+const auto TEXT_DIR = std::string(directive_name(DirectiveKind::TEXT));
+const auto KTEXT_DIR = std::string(directive_name(DirectiveKind::KTEXT));
+const auto VERSTAMP_DIR = std::string(directive_name(DirectiveKind::VERSTAMP));
+const auto VREG_DIR = std::string(directive_name(DirectiveKind::VREG));
+const auto WORD_DIR = std::string(directive_name(DirectiveKind::WORD));
 
 
 /* Keywords */
@@ -101,11 +101,9 @@ const auto WORD_DIR_KW = make_keyword(WORD_DIR);
  */
 struct DirectiveTbl : x3::symbols<int> {
     DirectiveTbl() {
-        *this += ALIAS_DIR, ALIGN_DIR, ASCII_DIR, ASCIIZ_DIR, ASM0_DIR, BGNB_DIR, BYTE_DIR, COMM_DIR, DATA_DIR,
-            DOUBLE_DIR, END_DIR, ENDB_DIR, ENDR_DIR, ENT_DIR, ERR_DIR, EXTERN_DIR, FILE_DIR, FLOAT_DIR, FMASK_DIR,
-            FRAME_DIR, GLOBAL_DIR, HALF_DIR, KDATA_DIR, KTEXT_DIR, LABEL_DIR, LCOMM_DIR, LIVEREG_DIR, LOC_DIR, MASK_DIR,
-            NOALIAS_DIR, OPTIONS_DIR, RDATA_DIR, REPEAT_DIR, SDATA_DIR, SET_DIR, SPACE_DIR, STRUCT_DIR, TEXT_DIR,
-            VERSTAMP_DIR, VREG_DIR, WORD_DIR;
+        for (const auto& dir : DIRECTIVE_LIST) {
+            add(std::string(dir.name));
+        }
 
         // XXX: Add macro support T.T
     }
@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <list>
+#include <string_view>
 #include <vector>
 
 #include "../parser_helpers.h"
@@ -16,7 +17,7 @@ struct unary;
 struct expression;
 
 struct label : x3::position_tagged {
-    std::string name = "";
+    std::string_view name;  // Into the source text
 };
 
 struct operand : x3::variant<unsigned int, label, x3::forward_ast<unary>, x3::forward_ast<expression> > {
@@ -148,7 +149,7 @@ struct printer {
 
 class unexpected_operator {};
 
-template <uint32_t (*Pred)(const std::string&)>
+template <uint32_t (*Pred)(std::string_view)>
 struct evaluator {
    private:
     // const auto
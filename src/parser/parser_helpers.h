@@ -14,6 +14,11 @@
 #include <boost/variant/apply_visitor.hpp>
 #include <boost/variant/recursive_variant.hpp>
 
+#include <memory>
+#include <string_view>
+
+#include "string_literal.h"
+
 namespace mips_parser {
 
 namespace x3 = boost::spirit::x3;
@@ -44,18 +49,54 @@ struct blank_after_gen {
 
 const auto blank_after = blank_after_gen{};
 
+/**
+ * view[p] matches p and exposes the matched text as a string_view into the input instead of
+ * copying it into a std::string. The input must be contiguous (a pointer or string iterator).
+ */
+template <typename Subject>
+struct view_directive : x3::unary_parser<Subject, view_directive<Subject>> {
+    using base_type = x3::unary_parser<Subject, view_directive<Subject>>;
+    using attribute_type = std::string_view;
+    static bool const handles_container = false;
+
+    constexpr view_directive(Subject const& subject) : base_type(subject) {}
+
+    template <typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext const& rcontext,
+               Attribute& attr) const {
+        x3::skip_over(first, last, context);
+        Iterator i = first;
+        if (!this->subject.parse(i, last, context, rcontext, x3::unused)) {
+            return false;
+        }
+        std::string_view text;
+        if (i != first) {
+            text = std::string_view(std::addressof(*first), std::distance(first, i));
+        }
+        x3::traits::move_to(text, attr);
+        first = i;
+        return true;
+    }
+};
+
+struct view_gen {
+    template <typename Subject>
+    constexpr view_directive<typename x3::extension::as_parser<Subject>::value_type> operator[](
+        Subject const& subject) const {
+        return {x3::as_parser(subject)};
+    }
+};
+
+const auto view = view_gen{};
+
 template <typename T>
 static auto as = [](auto p) { return x3::rule<struct tag, T>{"as"} = p; };
 
 /**
- * Quoted String parser. Note that we do not handle \0.
+ * Quoted String parser. The escapes are left as written; StringLiteral::decode() expands them.
  */
-const x3::rule<class quote_string_rule, std::string> QUOTE_STRING = "quote string rule";
-const auto QUOTE_STRING_def =
-    x3::lexeme['"' > *("\\n" >> x3::attr('\n') | "\\b" >> x3::attr('\b') | "\\f" >> x3::attr('\f') |
-                       "\\t" >> x3::attr('\t') | "\\v" >> x3::attr('\v') | "\\r" >> x3::attr('\r') |
-                       "\\n" >> x3::attr('\n') | "\\" >> x3::char_("\"\\") | "\\" >> x3::int_parser<char, 8, 1, 3>() |
-                       "\\x" >> x3::int_parser<char, 16, 2, 2>() | ~x3::char_('"')) > '"'];
+const x3::rule<class quote_string_rule, client::ast::StringLiteral> QUOTE_STRING = "quote string rule";
+const auto QUOTE_STRING_def = view[x3::lexeme['"' > *("\\" >> x3::char_ | ~x3::char_('"')) > '"']];
 BOOST_SPIRIT_DEFINE(QUOTE_STRING)
 }  // namespace mips_parser
 
@@ -0,0 +1,96 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_PRIMITIVES_KEYWORD_PARSER_H
+#define SPIMBOT_PARSER_PRIMITIVES_KEYWORD_PARSER_H
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+#include "../parser_helpers.h"
+
+namespace mips_parser {
+
+/**
+ * X3 primitive that recognizes one keyword through a perfect-hash lookup instead of a symbol trie.
+ *
+ * The parser reads the run of identifier characters and dots at the input, then offers LOOKUP the
+ * longest prefix of it that ends at a non-identifier character, i.e. the whole run or the part
+ * before one of its dots. This is what `lexeme[symbols >> !ident_]` accepts for keywords such as
+ * `add.d`, without walking a trie node per character. LOOKUP maps the word to the attribute, or to
+ * a negative number if the word is not a keyword.
+ */
+template <class Lookup>
+struct keyword_parser : x3::parser<keyword_parser<Lookup>> {
+    using attribute_type = int;
+    static bool const has_attribute = true;
+
+    /* Longer words are never keywords. */
+    static constexpr size_t MAX_LENGTH = 16;
+
+    constexpr explicit keyword_parser(Lookup lookup) : lookup(lookup) {}
+
+    template <typename Iterator, typename Context, typename RContext, typename Attribute>
+    bool parse(Iterator& first, Iterator const& last, Context const& context, RContext const&,
+               Attribute& attr) const {
+        x3::skip_over(first, last, context);
+
+        /* Buffer the word so non-contiguous iterators (e.g. istream) work too. */
+        char word[MAX_LENGTH];
+        size_t length = 0;
+        Iterator ends[MAX_LENGTH + 1];  // ends[i]: iterator just past the first i characters
+        size_t dots[MAX_LENGTH];
+        size_t dot_count = 0;
+
+        Iterator it = first;
+        ends[0] = it;
+        for (; it != last && is_word_char(*it); ++it) {
+            if (length == MAX_LENGTH) {
+                length = MAX_LENGTH + 1;  // Too long as a whole; only prefixes before dots remain
+                break;
+            }
+            if (*it == '.') {
+                dots[dot_count++] = length;
+            }
+            word[length++] = *it;
+            ends[length] = std::next(it);
+        }
+
+        if (length <= MAX_LENGTH && length > 0 && this->try_word(word, length, ends[length], first, attr)) {
+            return true;
+        }
+        for (size_t i = dot_count; i-- > 0;) {
+            if (dots[i] > 0 && this->try_word(word, dots[i], ends[dots[i]], first, attr)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+   private:
+    static bool is_word_char(char c) {
+        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '$' || c == '_' ||
+               c == '.';
+    }
+
+    template <typename Iterator, typename Attribute>
+    bool try_word(const char* word, size_t length, Iterator end, Iterator& first, Attribute& attr) const {
+        int value = this->lookup(std::string_view(word, length));
+        if (value < 0) {
+            return false;
+        }
+        x3::traits::move_to(value, attr);
+        first = end;
+        return true;
+    }
+
+    Lookup lookup;
+};
+
+template <class Lookup>
+constexpr keyword_parser<Lookup> make_keyword_parser(Lookup lookup) {
+    return keyword_parser<Lookup>(lookup);
+}
+
+}  // namespace mips_parser
+
+#endif
@@ -4,12 +4,13 @@
 
 #include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
-#include "../directive/symbols.h"
+#include "../directive/directive_names.h"
 #include "../parser_helpers.h"
-#include "instruction.h"
-#include "register.h"
+#include "keyword_parser.h"
+#include "opcodes.h"
+#include "register_names.h"
 
 namespace mips_parser {
 namespace x3 = boost::spirit::x3;
@@ -17,39 +18,34 @@ namespace x3 = boost::spirit::x3;
 /* Categories of keywords */
 
 /**
- * All keywords for non-bare machine
+ * General purpose and floating point registers, with the register number as the attribute.
  */
-const auto DEFAULT_KEYWORDS = [=]() {
-    symbols<int> sym;
-    const auto insert_sym = [&](auto&& symbol, auto&& data) { sym.add(symbol, data); };
+const auto REG = make_keyword_parser([](std::string_view word) {
+    const RegisterName* reg = registers.find(word);
+    return reg != nullptr && !reg->floating_point ? reg->number : -1;
+});
+const auto FP_REG = make_keyword_parser([](std::string_view word) {
+    const RegisterName* reg = registers.find(word);
+    return reg != nullptr && reg->floating_point ? reg->number : -1;
+});
 
-    directive_.for_each(insert_sym);
-    instruction_.for_each(insert_sym);
-    register_.for_each(insert_sym);
-    fp_register_.for_each(insert_sym);
-
-    return sym;
-}();
+/**
+ * All keywords for non-bare machine: directives, instructions and registers.
+ */
+const auto RESERVED = make_keyword_parser([](std::string_view word) {
+    return directives.contains(word) || opcodes.contains(word) || registers.contains(word) ? 0 : -1;
+});
 
 /**
  * All keywords for bare machine
  */
-const auto BARE_MACHINE_KEYWORDS = [=]() {
-    symbols<int> sym;
-    sym = DEFAULT_KEYWORDS;
-    // XXX: Remove psuedo ops
-    return sym;
-}();
-
-const auto FP_REG = to_keyword(fp_register_);
-const auto REG = to_keyword(register_);
-
-const auto RESERVED = lexeme[DEFAULT_KEYWORDS >> !ident_];
-const auto BARE_MACHINE_RESERVED = lexeme[DEFAULT_KEYWORDS >> !ident_];
+// XXX: Remove psuedo ops
+const auto BARE_MACHINE_RESERVED = RESERVED;
 
-const auto IDENT = as<std::string>(lexeme[(first_ident_ >> *ident_) - (RESERVED | x3::eol | x3::eoi)]);
+/* Identifiers are views into the input; see view[]. */
+const auto IDENT = as<std::string_view>(view[lexeme[(first_ident_ >> *ident_) - (RESERVED | x3::eol | x3::eoi)]]);
 const auto BARE_MACHINE_IDENT =
-    as<std::string>(lexeme[(first_ident_ >> *ident_) - (BARE_MACHINE_RESERVED | x3::eol | x3::eoi)]);
+    as<std::string_view>(view[lexeme[(first_ident_ >> *ident_) - (BARE_MACHINE_RESERVED | x3::eol | x3::eoi)]]);
 
 // const auto IDENT = lexeme[+ident_ - RESERVED];
 // const auto BARE_MACHINE_IDENT = lexeme[+ident_ - BARE_MACHINE_RESERVED];
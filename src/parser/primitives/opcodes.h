@@ -0,0 +1,473 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_OPCODES_H
+#define SPIMBOT_PARSER_OPCODES_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "perfect_hash.h"
+
+namespace mips_parser {
+
+enum InstructionType {
+    PSEUDO_OP = 1,
+
+    BC_TYPE_INST = 10,
+    B1_TYPE_INST = 11,
+    I1s_TYPE_INST = 12,
+    I1t_TYPE_INST = 13,
+    I2_TYPE_INST = 14,
+    B2_TYPE_INST = 15,
+    I2a_TYPE_INST = 16,
+
+    R1s_TYPE_INST = 20,
+    R1d_TYPE_INST = 21,
+    R2st_TYPE_INST = 22,
+    R2ds_TYPE_INST = 23,
+    R2td_TYPE_INST = 24,
+    R2sh_TYPE_INST = 25,
+    R3_TYPE_INST = 26,
+    R3sh_TYPE_INST = 27,
+
+    FP_I2a_TYPE_INST = 30,
+    FP_R2ds_TYPE_INST = 31,
+    FP_R2ts_TYPE_INST = 32,
+    FP_CMP_TYPE_INST = 33,
+    FP_R3_TYPE_INST = 34,
+    FP_R4_TYPE_INST = 35,
+    FP_MOVC_TYPE_INST = 36,
+    MOVC_TYPE_INST = 37,
+
+    J_TYPE_INST = 40,
+    NOARG_TYPE_INST = 42,
+};
+
+struct Operation {
+    std::string_view name;
+    InstructionType type;
+    uint32_t opcode;
+};
+
+inline constexpr Operation OPCODE_LIST[] = {
+    {"abs", PSEUDO_OP, (unsigned)-1},
+    {"abs.d", FP_R2ds_TYPE_INST, 0x46200005},
+    {"abs.ps", FP_R2ds_TYPE_INST, 0x46600005}, /* MIPS32 Rev 2 */
+    {"abs.s", FP_R2ds_TYPE_INST, 0x46000005},
+
+    {"add", R3_TYPE_INST, 0x00000020},
+    {"add.d", FP_R3_TYPE_INST, 0x46200000},
+    {"add.ps", FP_R3_TYPE_INST, 0x46600000}, /* MIPS32 Rev 2 */
+    {"add.s", FP_R3_TYPE_INST, 0x46000000},
+    {"addi", I2_TYPE_INST, 0x20000000},
+    {"addiu", I2_TYPE_INST, 0x24000000},
+    {"addu", R3_TYPE_INST, 0x00000021},
+
+    {"alnv.ps", FP_R4_TYPE_INST, 0x4c00001e}, /* MIPS32 Rev 2 */
+
+    {"and", R3_TYPE_INST, 0x00000024},
+    {"andi", I2_TYPE_INST, 0x30000000},
+
+    {"b", PSEUDO_OP, (unsigned)-1},
+    {"bal", PSEUDO_OP, (unsigned)-1},
+
+    {"bc1f", BC_TYPE_INST, 0x45000000},
+    {"bc1fl", BC_TYPE_INST, 0x45020000}, /* MIPS32 */
+    {"bc1t", BC_TYPE_INST, 0x45010000},
+    {"bc1tl", BC_TYPE_INST, 0x45030000}, /* MIPS32 */
+
+    {"bc2f", BC_TYPE_INST, 0x49000000},
+    {"bc2fl", BC_TYPE_INST, 0x49020000}, /* MIPS32 */
+    {"bc2t", BC_TYPE_INST, 0x49010000},
+    {"bc2tl", BC_TYPE_INST, 0x49030000}, /* MIPS32 */
+
+    {"beq", B2_TYPE_INST, 0x10000000},
+    {"beql", B2_TYPE_INST, 0x50000000}, /* MIPS32 */
+    {"beqz", PSEUDO_OP, (unsigned)-1},
+    {"bge", PSEUDO_OP, (unsigned)-1},
+    {"bgeu", PSEUDO_OP, (unsigned)-1},
+    {"bgez", B1_TYPE_INST, 0x04010000},
+    {"bgezal", B1_TYPE_INST, 0x04110000},
+    {"bgezall", B1_TYPE_INST, 0x04130000}, /* MIPS32 */
+    {"bgezl", B1_TYPE_INST, 0x04030000},   /* MIPS32 */
+    {"bgt", PSEUDO_OP, (unsigned)-1},
+    {"bgtu", PSEUDO_OP, (unsigned)-1},
+    {"bgtz", B1_TYPE_INST, 0x1c000000},
+    {"bgtzl", B1_TYPE_INST, 0x5c000000}, /* MIPS32 */
+    {"ble", PSEUDO_OP, (unsigned)-1},
+    {"bleu", PSEUDO_OP, (unsigned)-1},
+    {"blez", B1_TYPE_INST, 0x18000000},
+    {"blezl", B1_TYPE_INST, 0x58000000}, /* MIPS32 */
+    {"blt", PSEUDO_OP, (unsigned)-1},
+    {"bltu", PSEUDO_OP, (unsigned)-1},
+    {"bltz", B1_TYPE_INST, 0x04000000},
+    {"bltzal", B1_TYPE_INST, 0x04100000},
+    {"bltzall", B1_TYPE_INST, 0x04120000}, /* MIPS32 */
+    {"bltzl", B1_TYPE_INST, 0x04020000},   /* MIPS32 */
+    {"bne", B2_TYPE_INST, 0x14000000},
+    {"bnel", B2_TYPE_INST, 0x54000000}, /* MIPS32 */
+    {"bnez", PSEUDO_OP, (unsigned)-1},
+
+    {"break", NOARG_TYPE_INST, 0x0000000d},
+
+    {"c.eq.d", FP_CMP_TYPE_INST, 0x46200032},
+    {"c.eq.ps", FP_CMP_TYPE_INST, 0x46600032}, /* MIPS32 Rev 2 */
+    {"c.eq.s", FP_CMP_TYPE_INST, 0x46000032},
+    {"c.f.d", FP_CMP_TYPE_INST, 0x46200030},
+    {"c.f.ps", FP_CMP_TYPE_INST, 0x46600030}, /* MIPS32 Rev 2 */
+    {"c.f.s", FP_CMP_TYPE_INST, 0x46000030},
+    {"c.le.d", FP_CMP_TYPE_INST, 0x4620003e},
+    {"c.le.ps", FP_CMP_TYPE_INST, 0x4660003e}, /* MIPS32 Rev 2 */
+    {"c.le.s", FP_CMP_TYPE_INST, 0x4600003e},
+    {"c.lt.d", FP_CMP_TYPE_INST, 0x4620003c},
+    {"c.lt.ps", FP_CMP_TYPE_INST, 0x4660003c}, /* MIPS32 Rev 2 */
+    {"c.lt.s", FP_CMP_TYPE_INST, 0x4600003c},
+    {"c.nge.d", FP_CMP_TYPE_INST, 0x4620003d},
+    {"c.nge.ps", FP_CMP_TYPE_INST, 0x4660003d}, /* MIPS32 Rev 2 */
+    {"c.nge.s", FP_CMP_TYPE_INST, 0x4600003d},
+    {"c.ngl.d", FP_CMP_TYPE_INST, 0x4620003b},
+    {"c.ngl.ps", FP_CMP_TYPE_INST, 0x4660003b}, /* MIPS32 Rev 2 */
+    {"c.ngl.s", FP_CMP_TYPE_INST, 0x4600003b},
+    {"c.ngle.d", FP_CMP_TYPE_INST, 0x46200039},
+    {"c.ngle.ps", FP_CMP_TYPE_INST, 0x46600039}, /* MIPS32 Rev 2 */
+    {"c.ngle.s", FP_CMP_TYPE_INST, 0x46000039},
+    {"c.ngt.d", FP_CMP_TYPE_INST, 0x4620003f},
+    {"c.ngt.ps", FP_CMP_TYPE_INST, 0x4660003f}, /* MIPS32 Rev 2 */
+    {"c.ngt.s", FP_CMP_TYPE_INST, 0x4600003f},
+    {"c.ole.d", FP_CMP_TYPE_INST, 0x46200036},
+    {"c.ole.ps", FP_CMP_TYPE_INST, 0x46600036}, /* MIPS32 Rev 2 */
+    {"c.ole.s", FP_CMP_TYPE_INST, 0x46000036},
+    {"c.olt.d", FP_CMP_TYPE_INST, 0x46200034},
+    {"c.olt.ps", FP_CMP_TYPE_INST, 0x46600034}, /* MIPS32 Rev 2 */
+    {"c.olt.s", FP_CMP_TYPE_INST, 0x46000034},
+    {"c.seq.d", FP_CMP_TYPE_INST, 0x4620003a},
+    {"c.seq.ps", FP_CMP_TYPE_INST, 0x4660003a}, /* MIPS32 Rev 2 */
+    {"c.seq.s", FP_CMP_TYPE_INST, 0x4600003a},
+    {"c.sf.d", FP_CMP_TYPE_INST, 0x46200038},
+    {"c.sf.ps", FP_CMP_TYPE_INST, 0x46600038}, /* MIPS32 Rev 2 */
+    {"c.sf.s", FP_CMP_TYPE_INST, 0x46000038},
+    {"c.ueq.d", FP_CMP_TYPE_INST, 0x46200033},
+    {"c.ueq.ps", FP_CMP_TYPE_INST, 0x46600033}, /* MIPS32 Rev 2 */
+    {"c.ueq.s", FP_CMP_TYPE_INST, 0x46000033},
+    {"c.ule.d", FP_CMP_TYPE_INST, 0x46200037},
+    {"c.ule.ps", FP_CMP_TYPE_INST, 0x46600037}, /* MIPS32 Rev 2 */
+    {"c.ule.s", FP_CMP_TYPE_INST, 0x46000037},
+    {"c.ult.d", FP_CMP_TYPE_INST, 0x46200035},
+    {"c.ult.ps", FP_CMP_TYPE_INST, 0x46600035}, /* MIPS32 Rev 2 */
+    {"c.ult.s", FP_CMP_TYPE_INST, 0x46000035},
+    {"c.un.d", FP_CMP_TYPE_INST, 0x46200031},
+    {"c.un.ps", FP_CMP_TYPE_INST, 0x46600031}, /* MIPS32 Rev 2 */
+    {"c.un.s", FP_CMP_TYPE_INST, 0x46000031},
+
+    {"cache", I2_TYPE_INST, 0xbc000000}, /* MIPS32 */
+
+    {"ceil.l.d", FP_R2ds_TYPE_INST, 0x4620000a}, /* MIPS32 Rev 2 */
+    {"ceil.l.s", FP_R2ds_TYPE_INST, 0x4600000a}, /* MIPS32 Rev 2 */
+    {"ceil.w.d", FP_R2ds_TYPE_INST, 0x4620000e}, /* MIPS32 */
+    {"ceil.w.s", FP_R2ds_TYPE_INST, 0x4600000e}, /* MIPS32 */
+
+    {"cfc0", FP_R2ts_TYPE_INST, 0x40400000},
+    {"cfc1", FP_R2ts_TYPE_INST, 0x44400000},
+    {"cfc2", FP_R2ts_TYPE_INST, 0x48400000},
+
+    {"clo", R3_TYPE_INST, 0x70000021},
+    {"clz", R3_TYPE_INST, 0x70000020},
+
+    {"cop2", J_TYPE_INST, 0x4a000000},
+
+    {"ctc0", FP_R2ts_TYPE_INST, 0x40c00000},
+    {"ctc1", FP_R2ts_TYPE_INST, 0x44c00000},
+    {"ctc2", FP_R2ts_TYPE_INST, 0x48c00000},
+
+    {"cvt.d.l", FP_R2ds_TYPE_INST, 0x46b00021}, /* MIPS32 Rev 2 */
+    {"cvt.d.s", FP_R2ds_TYPE_INST, 0x46000021},
+    {"cvt.d.w", FP_R2ds_TYPE_INST, 0x46200021},
+    {"cvt.l.d", FP_R2ds_TYPE_INST, 0x46200025},  /* MIPS32 Rev 2 */
+    {"cvt.l.s", FP_R2ds_TYPE_INST, 0x46000025},  /* MIPS32 Rev 2 */
+    {"cvt.ps.s", FP_R2ds_TYPE_INST, 0x46000026}, /* MIPS32 Rev 2 */
+    {"cvt.s.d", FP_R2ds_TYPE_INST, 0x46200020},
+    {"cvt.s.l", FP_R2ds_TYPE_INST, 0x46b00020},  /* MIPS32 Rev 2 */
+    {"cvt.s.pl", FP_R2ds_TYPE_INST, 0x46c00024}, /* MIPS32 Rev 2 */
+    {"cvt.s.pu", FP_R2ds_TYPE_INST, 0x46c00020}, /* MIPS32 Rev 2 */
+    {"cvt.s.w", FP_R2ds_TYPE_INST, 0x46800020},
+    {"cvt.w.d", FP_R2ds_TYPE_INST, 0x46200024},
+    {"cvt.w.s", FP_R2ds_TYPE_INST, 0x46000024},
+
+    {"deret", NOARG_TYPE_INST, 0x4200001f}, /* MIPS32 Rev 2 */
+    {"di", I1t_TYPE_INST, 0x41606000},      /* MIPS32 Rev 2 */
+
+    {"div", R2st_TYPE_INST, 0x0000001a},
+    {"div.d", FP_R3_TYPE_INST, 0x46200003},
+    {"div.s", FP_R3_TYPE_INST, 0x46000003},
+    {"divu", R2st_TYPE_INST, 0x0000001b},
+
+    {"ehb", NOARG_TYPE_INST, 0x000000c0},   /* MIPS32 Rev 2 */
+    {"ei", I1t_TYPE_INST, 0x41606020},      /* MIPS32 Rev 2 */
+    {"eret", NOARG_TYPE_INST, 0x42000018},  /* MIPS32 */
+    {"ext", FP_R2ds_TYPE_INST, 0x7c000000}, /* MIPS32 Rev 2 */
+
+    {"floor.l.d", FP_R2ds_TYPE_INST, 0x4620000b}, /* MIPS32 Rev 2 */
+    {"floor.l.s", FP_R2ds_TYPE_INST, 0x4600000b}, /* MIPS32 Rev 2 */
+    {"floor.w.d", FP_R2ds_TYPE_INST, 0x4620000f}, /* MIPS32 */
+    {"floor.w.s", FP_R2ds_TYPE_INST, 0x4600000f}, /* MIPS32 */
+
+    {"ins", FP_R2ds_TYPE_INST, 0x7c000004}, /* MIPS32 Rev 2 */
+
+    {"j", J_TYPE_INST, 0x08000000},
+    {"jal", J_TYPE_INST, 0x0c000000},
+    {"jalr", R2ds_TYPE_INST, 0x00000009},
+    {"jalr.hb", R2ds_TYPE_INST, 0x00000409}, /* MIPS32 Rev 2 */
+
+    {"jr", R1s_TYPE_INST, 0x00000008},
+    {"jr.hb", R1s_TYPE_INST, 0x00000408}, /* MIPS32 Rev 2 */
+
+    {"l.d", PSEUDO_OP, (unsigned)-1},
+    {"l.s", PSEUDO_OP, (unsigned)-1},
+
+    {"la", PSEUDO_OP, (unsigned)-1},
+    {"lb", I2a_TYPE_INST, 0x80000000},
+    {"lbu", I2a_TYPE_INST, 0x90000000},
+    {"ld", PSEUDO_OP, (unsigned)-1},
+    {"ldc1", FP_I2a_TYPE_INST, 0xd4000000}, /* MIPS32 */
+    {"ldc2", I2a_TYPE_INST, 0xd8000000},    /* MIPS32 */
+    {"ldxc1", FP_R3_TYPE_INST, 0x4c000001}, /* MIPS32 Rev 2 */
+    {"lh", I2a_TYPE_INST, 0x84000000},
+    {"lhu", I2a_TYPE_INST, 0x94000000},
+
+    {"li", PSEUDO_OP, (unsigned)-1},
+    {"li.d", PSEUDO_OP, (unsigned)-1},
+    {"li.s", PSEUDO_OP, (unsigned)-1},
+
+    {"ll", I2a_TYPE_INST, 0xc0000000}, /* MIPS32 */
+
+    {"lui", I1t_TYPE_INST, 0x3c000000},
+    {"luxc1", FP_R3_TYPE_INST, 0x4c000005}, /* MIPS32 Rev 2 */
+
+    {"lw", I2a_TYPE_INST, 0x8c000000},
+    {"lwc1", FP_I2a_TYPE_INST, 0xc4000000},
+    {"lwc2", I2a_TYPE_INST, 0xc8000000},
+    {"lwl", I2a_TYPE_INST, 0x88000000},
+    {"lwr", I2a_TYPE_INST, 0x98000000},
+    {"lwxc1", FP_R3_TYPE_INST, 0x4c000000}, /* MIPS32 Rev 2 */
+
+    {"madd", R2st_TYPE_INST, 0x70000000},     /* MIPS32 */
+    {"madd.d", FP_R4_TYPE_INST, 0x4c000001},  /* MIPS32 Rev 2 */
+    {"madd.ps", FP_R4_TYPE_INST, 0x4c000006}, /* MIPS32 Rev 2 */
+    {"madd.s", FP_R4_TYPE_INST, 0x4c000000},  /* MIPS32 Rev 2 */
+    {"maddu", R2st_TYPE_INST, 0x70000001},    /* MIPS32 */
+
+    {"mfc0", R2td_TYPE_INST, 0x40000000},
+    {"mfc1", FP_R2ts_TYPE_INST, 0x44000000},
+    {"mfc1.d", PSEUDO_OP, (unsigned)-1},
+    {"mfc2", R2td_TYPE_INST, 0x48000000},
+    {"mfhc1", FP_R2ts_TYPE_INST, 0x44600000}, /* MIPS32 Rev 2 */
+    {"mfhc2", R2td_TYPE_INST, 0x48600000},    /* MIPS32 Rev 2 */
+    {"mfhi", R1d_TYPE_INST, 0x00000010},
+    {"mflo", R1d_TYPE_INST, 0x00000012},
+
+    {"mov.d", FP_R2ds_TYPE_INST, 0x46200006},
+    {"mov.ps", FP_R2ds_TYPE_INST, 0x46c00006}, /* MIPS32 Rev 2 */
+    {"mov.s", FP_R2ds_TYPE_INST, 0x46000006},
+    {"move", PSEUDO_OP, (unsigned)-1},
+
+    {"movf", MOVC_TYPE_INST, 0x00000001},       /* MIPS32 */
+    {"movf.d", FP_MOVC_TYPE_INST, 0x46200011},  /* MIPS32 */
+    {"movf.ps", FP_MOVC_TYPE_INST, 0x46c00011}, /* MIPS32 Rev 2 */
+    {"movf.s", FP_MOVC_TYPE_INST, 0x46000011},  /* MIPS32 */
+
+    {"movn", R3_TYPE_INST, 0x0000000b},         /* MIPS32 */
+    {"movn.d", FP_MOVC_TYPE_INST, 0x46200013},  /* MIPS32 */
+    {"movn.ps", FP_MOVC_TYPE_INST, 0x46c00013}, /* MIPS32 Rev 2 */
+    {"movn.s", FP_MOVC_TYPE_INST, 0x46000013},  /* MIPS32 */
+
+    {"movt", MOVC_TYPE_INST, 0x00010001},       /* MIPS32 */
+    {"movt.d", FP_MOVC_TYPE_INST, 0x46210011},  /* MIPS32 */
+    {"movt.ps", FP_MOVC_TYPE_INST, 0x46c10011}, /* MIPS32 Rev 2 */
+    {"movt.s", FP_MOVC_TYPE_INST, 0x46010011},  /* MIPS32 */
+
+    {"movz", R3_TYPE_INST, 0x0000000a},         /* MIPS32 */
+    {"movz.d", FP_MOVC_TYPE_INST, 0x46200012},  /* MIPS32 */
+    {"movz.ps", FP_MOVC_TYPE_INST, 0x46c00012}, /* MIPS32 Rev 2 */
+    {"movz.s", FP_MOVC_TYPE_INST, 0x46000012},  /* MIPS32 */
+
+    {"msub", R2st_TYPE_INST, 0x70000004},     /* MIPS32 */
+    {"msub.d", FP_R4_TYPE_INST, 0x4c000021},  /* MIPS32 Rev 2 */
+    {"msub.ps", FP_R4_TYPE_INST, 0x4c000026}, /* MIPS32 Rev 2 */
+    {"msub.s", FP_R4_TYPE_INST, 0x4c000020},  /* MIPS32 Rev 2 */
+    {"msubu", R2st_TYPE_INST, 0x70000005},    /* MIPS32 */
+
+    {"mtc0", R2td_TYPE_INST, 0x40800000},
+    {"mtc1", FP_R2ts_TYPE_INST, 0x44800000},
+    {"mtc1.d", PSEUDO_OP, (unsigned)-1},
+    {"mtc2", R2td_TYPE_INST, 0x48800000},
+    {"mthc1", FP_R2ts_TYPE_INST, 0x44e00000}, /* MIPS32 Rev 2 */
+    {"mthc2", R2td_TYPE_INST, 0x48e00000},    /* MIPS32 Rev 2 */
+
+    {"mthi", R1s_TYPE_INST, 0x00000011},
+    {"mtlo", R1s_TYPE_INST, 0x00000013},
+
+    {"mul", R3_TYPE_INST, 0x70000002}, /* MIPS32 */
+    {"mul.d", FP_R3_TYPE_INST, 0x46200002},
+    {"mul.ps", FP_R3_TYPE_INST, 0x46c00002}, /* MIPS32 Rev 2 */
+    {"mul.s", FP_R3_TYPE_INST, 0x46000002},
+    {"mulo", PSEUDO_OP, (unsigned)-1},
+    {"mulou", PSEUDO_OP, (unsigned)-1},
+    {"mult", R2st_TYPE_INST, 0x00000018},
+    {"multu", R2st_TYPE_INST, 0x00000019},
+
+    {"neg", PSEUDO_OP, (unsigned)-1},
+    {"neg.d", FP_R2ds_TYPE_INST, 0x46200007},
+    {"neg.ps", FP_R2ds_TYPE_INST, 0x46c00007}, /* MIPS32 Rev 2 */
+    {"neg.s", FP_R2ds_TYPE_INST, 0x46000007},
+    {"negu", PSEUDO_OP, (unsigned)-1},
+
+    {"nmadd.d", FP_R4_TYPE_INST, 0x4c000031},  /* MIPS32 Rev 2 */
+    {"nmadd.ps", FP_R4_TYPE_INST, 0x4c000036}, /* MIPS32 Rev 2 */
+    {"nmadd.s", FP_R4_TYPE_INST, 0x4c000030},  /* MIPS32 Rev 2 */
+    {"nmsub.d", FP_R4_TYPE_INST, 0x4c000039},  /* MIPS32 Rev 2 */
+    {"nmsub.ps", FP_R4_TYPE_INST, 0x4c00003e}, /* MIPS32 Rev 2 */
+    {"nmsub.s", FP_R4_TYPE_INST, 0x4c000038},  /* MIPS32 Rev 2 */
+
+    {"nop", PSEUDO_OP, (unsigned)-1},
+    {"nor", R3_TYPE_INST, 0x00000027},
+    {"not", PSEUDO_OP, (unsigned)-1},
+    {"or", R3_TYPE_INST, 0x00000025},
+    {"ori", I2_TYPE_INST, 0x34000000},
+
+    {"pll.ps", FP_R3_TYPE_INST, 0x46c0002c}, /* MIPS32 Rev 2 */
+    {"plu.ps", FP_R3_TYPE_INST, 0x46c0002d}, /* MIPS32 Rev 2 */
+
+    {"pref", I2_TYPE_INST, 0xcc000000},      /* MIPS32 */
+    {"prefx", R2st_TYPE_INST, 0x4600000f},   /* MIPS32 Rev 2 */
+    {"pul.ps", FP_R3_TYPE_INST, 0x46c0002e}, /* MIPS32 Rev 2 */
+    {"puu.ps", FP_R3_TYPE_INST, 0x46c0002f}, /* MIPS32 Rev 2 */
+
+    {"rdhwr", R3_TYPE_INST, 0x7c00003b},    /* MIPS32 Rev 2 */
+    {"rdpgpr", R2td_TYPE_INST, 0x41400000}, /* MIPS32 Rev 2 */
+
+    {"recip.d", FP_R2ds_TYPE_INST, 0x46200015}, /* MIPS32 Rev 2 */
+    {"recip.s", FP_R2ds_TYPE_INST, 0x46000015}, /* MIPS32 Rev 2 */
+
+    {"rem", PSEUDO_OP, (unsigned)-1},
+    {"remu", PSEUDO_OP, (unsigned)-1},
+
+    {"rfe", NOARG_TYPE_INST, 0x42000010},
+
+    {"rol", PSEUDO_OP, (unsigned)-1},
+    {"ror", PSEUDO_OP, (unsigned)-1},
+    {"rotr", R2sh_TYPE_INST, 0x00200002},  /* MIPS32 Rev 2 */
+    {"rotrv", R2sh_TYPE_INST, 0x00200003}, /* MIPS32 Rev 2 */
+
+    {"round.l.d", FP_R2ds_TYPE_INST, 0x46200008}, /* MIPS32 Rev 2 */
+    {"round.l.s", FP_R2ds_TYPE_INST, 0x46000008}, /* MIPS32 Rev 2 */
+    {"round.w.d", FP_R2ds_TYPE_INST, 0x4620000c}, /* MIPS32 */
+    {"round.w.s", FP_R2ds_TYPE_INST, 0x4600000c}, /* MIPS32 */
+
+    {"rsqrt.d", FP_R2ds_TYPE_INST, 0x46200016}, /* MIPS32 Rev 2 */
+    {"rsqrt.s", FP_R2ds_TYPE_INST, 0x46000016}, /* MIPS32 Rev 2 */
+
+    {"s.d", PSEUDO_OP, (unsigned)-1},
+    {"s.s", PSEUDO_OP, (unsigned)-1},
+
+    {"sb", I2a_TYPE_INST, 0xa0000000},
+    {"sc", I2a_TYPE_INST, 0xe0000000}, /* MIPS32 */
+    {"sd", PSEUDO_OP, (unsigned)-1},
+    {"sdbbp", NOARG_TYPE_INST, 0x7000003f}, /* MIPS32 Rev 2*/
+    {"sdc1", FP_I2a_TYPE_INST, 0xf4000000}, /* MIPS32 */
+    {"sdc2", I2a_TYPE_INST, 0xf8000000},    /* MIPS32 */
+    {"sdxc1", FP_R3_TYPE_INST, 0x46000009}, /* MIPS32 Rev 2 */
+
+    {"seb", R2td_TYPE_INST, 0x7c000420}, /* MIPS32 Rev 2 */
+    {"seh", R2td_TYPE_INST, 0x7c000620}, /* MIPS32 Rev 2 */
+    {"seq", PSEUDO_OP, (unsigned)-1},
+    {"sge", PSEUDO_OP, (unsigned)-1},
+    {"sgeu", PSEUDO_OP, (unsigned)-1},
+    {"sgt", PSEUDO_OP, (unsigned)-1},
+    {"sgtu", PSEUDO_OP, (unsigned)-1},
+
+    {"sh", I2a_TYPE_INST, 0xa4000000},
+    {"sle", PSEUDO_OP, (unsigned)-1},
+    {"sleu", PSEUDO_OP, (unsigned)-1},
+    {"sll", R2sh_TYPE_INST, 0x00000000},
+    {"sllv", R3sh_TYPE_INST, 0x00000004},
+
+    {"slt", R3_TYPE_INST, 0x0000002a},
+    {"slti", I2_TYPE_INST, 0x28000000},
+    {"sltiu", I2_TYPE_INST, 0x2c000000},
+    {"sltu", R3_TYPE_INST, 0x0000002b},
+    {"sne", PSEUDO_OP, (unsigned)-1},
+
+    {"sqrt.d", FP_R2ds_TYPE_INST, 0x46200004}, /* MIPS32 */
+    {"sqrt.s", FP_R2ds_TYPE_INST, 0x46000004}, /* MIPS32 */
+
+    {"sra", R2sh_TYPE_INST, 0x00000003},
+    {"srav", R3sh_TYPE_INST, 0x00000007},
+    {"srl", R2sh_TYPE_INST, 0x00000002},
+    {"srlv", R3sh_TYPE_INST, 0x00000006},
+
+    {"ssnop", R2sh_TYPE_INST, 0x00000040}, /* MIPS32 */
+
+    {"sub", R3_TYPE_INST, 0x00000022},
+    {"sub.d", FP_R3_TYPE_INST, 0x46200001},
+    {"sub.ps", FP_R3_TYPE_INST, 0x46600001}, /* MIPS32 Rev 2 */
+    {"sub.s", FP_R3_TYPE_INST, 0x46000001},
+    {"subu", R3_TYPE_INST, 0x00000023},
+
+    {"suxc1", FP_R3_TYPE_INST, 0x4600000d}, /* MIPS32 Rev 2 */
+
+    {"sw", I2a_TYPE_INST, 0xac000000},
+    {"swc1", FP_I2a_TYPE_INST, 0xe4000000},
+    {"swc2", I2a_TYPE_INST, 0xe8000000},
+    {"swl", I2a_TYPE_INST, 0xa8000000},
+    {"swr", I2a_TYPE_INST, 0xb8000000},
+    {"swxc1", FP_R3_TYPE_INST, 0x46000008}, /* MIPS32 Rev 2 */
+
+    {"sync", NOARG_TYPE_INST, 0x0000000f}, /* MIPS32 */
+    {"synci", I2_TYPE_INST, 0x04140000},   /* MIPS32 Rev 2 */
+    {"syscall", NOARG_TYPE_INST, 0x0000000c},
+
+    {"teq", R2st_TYPE_INST, 0x00000034},  /* MIPS32 */
+    {"teqi", I1s_TYPE_INST, 0x040c0000},  /* MIPS32 */
+    {"tge", R2st_TYPE_INST, 0x00000030},  /* MIPS32 */
+    {"tgei", I1s_TYPE_INST, 0x04080000},  /* MIPS32 */
+    {"tgeiu", I1s_TYPE_INST, 0x04090000}, /* MIPS32 */
+    {"tgeu", R2st_TYPE_INST, 0x00000031}, /* MIPS32 */
+
+    {"tlbp", NOARG_TYPE_INST, 0x42000008},
+    {"tlbr", NOARG_TYPE_INST, 0x42000001},
+    {"tlbwi", NOARG_TYPE_INST, 0x42000002},
+    {"tlbwr", NOARG_TYPE_INST, 0x42000006},
+
+    {"tlt", R2st_TYPE_INST, 0x00000032},  /* MIPS32 */
+    {"tlti", I1s_TYPE_INST, 0x040a0000},  /* MIPS32 */
+    {"tltiu", I1s_TYPE_INST, 0x040b0000}, /* MIPS32 */
+    {"tltu", R2st_TYPE_INST, 0x00000033}, /* MIPS32 */
+    {"tne", R2st_TYPE_INST, 0x00000036},  /* MIPS32 */
+    {"tnei", I1s_TYPE_INST, 0x040e0000},  /* MIPS32 */
+
+    {"trunc.l.d", FP_R2ds_TYPE_INST, 0x46200009}, /* MIPS32 Rev 2 */
+    {"trunc.l.s", FP_R2ds_TYPE_INST, 0x46000009}, /* MIPS32 Rev 2 */
+    {"trunc.w.d", FP_R2ds_TYPE_INST, 0x4620000d}, /* MIPS32 */
+    {"trunc.w.s", FP_R2ds_TYPE_INST, 0x4600000d}, /* MIPS32 */
+
+    {"ulh", PSEUDO_OP, (unsigned)-1},
+    {"ulhu", PSEUDO_OP, (unsigned)-1},
+    {"ulw", PSEUDO_OP, (unsigned)-1},
+    {"ush", PSEUDO_OP, (unsigned)-1},
+    {"usw", PSEUDO_OP, (unsigned)-1},
+
+    {"wrpgpr", R2td_TYPE_INST, 0x41c00000}, /* MIPS32 Rev 2 */
+    {"wsbh", R2td_TYPE_INST, 0x7c0000a0},   /* MIPS32 Rev 2 */
+
+    {"xor", R3_TYPE_INST, 0x00000026},
+    {"xori", I2_TYPE_INST, 0x38000000},
+};
+
+/**
+ * Mnemonic -> Operation, e.g. opcodes.find("addiu"). A constexpr perfect hash, so lookups take a
+ * string_view and never allocate.
+ */
+inline constexpr auto opcodes = make_keyword_table(OPCODE_LIST, [](const Operation &op) { return op.name; });
+
+}  // namespace mips_parser
+
+#endif
@@ -0,0 +1,170 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_PERFECT_HASH_H
+#define SPIMBOT_PARSER_PERFECT_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../../util/hash.h"
+
+namespace mips_parser {
+
+namespace detail {
+
+constexpr size_t ceil_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/* splitmix64 finalizer. */
+constexpr uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/* A fresh hash of HASH for each SEED. */
+constexpr uint64_t displace(uint64_t hash, uint32_t seed) {
+    return mix(hash + (uint64_t(seed) + 1) * 0x9e3779b97f4a7c15ull);
+}
+
+}  // namespace detail
+
+/**
+ * Perfect hash over N fixed keys, built at compile time ("hash and displace").
+ *
+ * Keys are split into buckets by one hash; each bucket, largest first, gets the smallest seed that
+ * sends all of its keys to free slots. A lookup is then one pass over the key (FNV-1a), one
+ * slot computation and one string compare, with no allocation and no probing.
+ */
+template <size_t N>
+class PerfectHash {
+   public:
+    static constexpr size_t SLOTS = detail::ceil_pow2(N + N / 4 + 1);
+    static constexpr size_t BUCKETS = detail::ceil_pow2(N / 4 + 1);
+    static constexpr uint16_t EMPTY = 0xffff;
+    static_assert(N < EMPTY, "too many keys");
+
+    constexpr explicit PerfectHash(const std::array<std::string_view, N> &keys) : keys(keys) {
+        std::array<uint64_t, N> hashes{};
+        std::array<size_t, BUCKETS> sizes{};
+        size_t largest = 0;
+        for (size_t i = 0; i < N; i++) {
+            hashes[i] = hash(keys[i]);
+            size_t size = ++sizes[bucket(hashes[i])];
+            largest = size > largest ? size : largest;
+        }
+        for (auto &slot : this->slot_index) {
+            slot = EMPTY;
+        }
+
+        for (size_t size = largest; size > 0; size--) {
+            for (size_t b = 0; b < BUCKETS; b++) {
+                if (sizes[b] != size) {
+                    continue;
+                }
+
+                std::array<size_t, N> members{};
+                size_t count = 0;
+                for (size_t i = 0; i < N; i++) {
+                    if (bucket(hashes[i]) == b) {
+                        members[count++] = i;
+                    }
+                }
+
+                for (uint32_t seed = 0;; seed++) {
+                    if (seed == 1u << 20) {
+                        throw "PerfectHash: duplicate keys";
+                    }
+                    if (place(hashes, members, count, seed)) {
+                        this->seeds[b] = seed;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Index of KEY in the key array, or -1. */
+    constexpr int find(std::string_view key) const {
+        uint64_t h = hash(key);
+        uint16_t index = this->slot_index[slot(h, this->seeds[bucket(h)])];
+        return index != EMPTY && this->keys[index] == key ? index : -1;
+    }
+
+   private:
+    /* FNV-1a alone leaves the high bits of short, similar keys ("$t0", "$t1", ...) clustered. */
+    static constexpr uint64_t hash(std::string_view key) { return detail::mix(util::fnv1a_64(key)); }
+    static constexpr size_t bucket(uint64_t h) { return (h >> 32) & (BUCKETS - 1); }
+    static constexpr size_t slot(uint64_t h, uint32_t seed) { return detail::displace(h, seed) & (SLOTS - 1); }
+
+    /* Claim slots for the COUNT keys in MEMBERS under SEED, if they are all free and distinct. */
+    constexpr bool place(const std::array<uint64_t, N> &hashes, const std::array<size_t, N> &members, size_t count,
+                         uint32_t seed) {
+        for (size_t j = 0; j < count; j++) {
+            size_t s = slot(hashes[members[j]], seed);
+            if (this->slot_index[s] != EMPTY) {
+                return false;
+            }
+            for (size_t k = 0; k < j; k++) {
+                if (slot(hashes[members[k]], seed) == s) {
+                    return false;
+                }
+            }
+        }
+        for (size_t j = 0; j < count; j++) {
+            this->slot_index[slot(hashes[members[j]], seed)] = static_cast<uint16_t>(members[j]);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> keys{};
+    std::array<uint16_t, SLOTS> slot_index{};
+    std::array<uint32_t, BUCKETS> seeds{};
+};
+
+/**
+ * A fixed table of entries looked up by name through a PerfectHash.
+ */
+template <class T, size_t N>
+class KeywordTable {
+   public:
+    constexpr KeywordTable(const std::array<T, N> &entries, const std::array<std::string_view, N> &keys)
+        : entries(entries), index(keys) {}
+
+    constexpr const T *find(std::string_view key) const {
+        int i = this->index.find(key);
+        return i < 0 ? nullptr : &this->entries[i];
+    }
+
+    constexpr bool contains(std::string_view key) const { return this->index.find(key) >= 0; }
+
+    constexpr auto begin() const { return this->entries.begin(); }
+    constexpr auto end() const { return this->entries.end(); }
+    static constexpr size_t size() { return N; }
+
+   private:
+    std::array<T, N> entries;
+    PerfectHash<N> index;
+};
+
+/* Build a KeywordTable over ENTRIES, keyed by KEY(entry). */
+template <class T, size_t N, class Key>
+constexpr KeywordTable<T, N> make_keyword_table(const T (&entries)[N], Key key) {
+    std::array<T, N> copy{};
+    std::array<std::string_view, N> keys{};
+    for (size_t i = 0; i < N; i++) {
+        copy[i] = entries[i];
+        keys[i] = key(entries[i]);
+    }
+    return KeywordTable<T, N>(copy, keys);
+}
+
+}  // namespace mips_parser
+
+#endif
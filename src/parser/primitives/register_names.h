@@ -0,0 +1,55 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_REGISTER_NAMES_H
+#define SPIMBOT_PARSER_REGISTER_NAMES_H
+
+#include <string_view>
+
+#include "perfect_hash.h"
+
+namespace mips_parser {
+
+struct RegisterName {
+    std::string_view name;
+    int number;
+    bool floating_point;
+};
+
+/*
+ * Every register name the assembler accepts. Note that general purpose and floating point
+ * register numbers overlap, and that $fp is the frame pointer ($30), not a floating point register.
+ */
+inline constexpr RegisterName REGISTER_LIST[] = {
+    {"$0", 0, false}, {"$1", 1, false}, {"$2", 2, false}, {"$3", 3, false},
+    {"$4", 4, false}, {"$5", 5, false}, {"$6", 6, false}, {"$7", 7, false},
+    {"$8", 8, false}, {"$9", 9, false}, {"$10", 10, false}, {"$11", 11, false},
+    {"$12", 12, false}, {"$13", 13, false}, {"$14", 14, false}, {"$15", 15, false},
+    {"$16", 16, false}, {"$17", 17, false}, {"$18", 18, false}, {"$19", 19, false},
+    {"$20", 20, false}, {"$21", 21, false}, {"$22", 22, false}, {"$23", 23, false},
+    {"$24", 24, false}, {"$25", 25, false}, {"$26", 26, false}, {"$27", 27, false},
+    {"$28", 28, false}, {"$29", 29, false}, {"$30", 30, false}, {"$31", 31, false},
+
+    {"$zero", 0, false}, {"$at", 1, false}, {"$v0", 2, false}, {"$v1", 3, false},
+    {"$a0", 4, false}, {"$a1", 5, false}, {"$a2", 6, false}, {"$a3", 7, false},
+    {"$t0", 8, false}, {"$t1", 9, false}, {"$t2", 10, false}, {"$t3", 11, false},
+    {"$t4", 12, false}, {"$t5", 13, false}, {"$t6", 14, false}, {"$t7", 15, false},
+    {"$s0", 16, false}, {"$s1", 17, false}, {"$s2", 18, false}, {"$s3", 19, false},
+    {"$s4", 20, false}, {"$s5", 21, false}, {"$s6", 22, false}, {"$s7", 23, false},
+    {"$t8", 24, false}, {"$t9", 25, false}, {"$k0", 26, false}, {"$k1", 27, false},
+    {"$gp", 28, false}, {"$sp", 29, false}, {"$fp", 30, false}, {"$ra", 31, false},
+
+    {"$f0", 0, true}, {"$f1", 1, true}, {"$f2", 2, true}, {"$f3", 3, true},
+    {"$f4", 4, true}, {"$f5", 5, true}, {"$f6", 6, true}, {"$f7", 7, true},
+    {"$f8", 8, true}, {"$f9", 9, true}, {"$f10", 10, true}, {"$f11", 11, true},
+    {"$f12", 12, true}, {"$f13", 13, true}, {"$f14", 14, true}, {"$f15", 15, true},
+    {"$f16", 16, true}, {"$f17", 17, true}, {"$f18", 18, true}, {"$f19", 19, true},
+    {"$f20", 20, true}, {"$f21", 21, true}, {"$f22", 22, true}, {"$f23", 23, true},
+    {"$f24", 24, true}, {"$f25", 25, true}, {"$f26", 26, true}, {"$f27", 27, true},
+    {"$f28", 28, true}, {"$f29", 29, true}, {"$f30", 30, true}, {"$f31", 31, true},
+};
+
+/* Register name -> RegisterName, e.g. registers.find("$sp"). A constexpr perfect hash. */
+inline constexpr auto registers = make_keyword_table(REGISTER_LIST, [](const RegisterName &reg) { return reg.name; });
+
+}  // namespace mips_parser
+
+#endif
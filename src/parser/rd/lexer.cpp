@@ -0,0 +1,304 @@
+#include "lexer.h"
+
+#include <array>
+#include <string>
+
+#include "../directive/directive_names.h"
+#include "../primitives/opcodes.h"
+#include "../primitives/register_names.h"
+
+namespace mips_parser {
+namespace rd {
+
+namespace {
+
+/* Character classes */
+constexpr uint8_t C_BLANK = 0x01;
+constexpr uint8_t C_DIGIT = 0x02;
+constexpr uint8_t C_IDENT_FIRST = 0x04;  // [a-zA-Z$_]
+constexpr uint8_t C_IDENT = 0x08;        // [a-zA-Z0-9$_]
+constexpr uint8_t C_HEX = 0x10;
+
+constexpr std::array<uint8_t, 256> make_classes() {
+    std::array<uint8_t, 256> table{};
+    table[' '] = table['\t'] = table['\r'] = table['\v'] = table['\f'] = C_BLANK;
+    for (int c = '0'; c <= '9'; c++) {
+        table[c] = C_DIGIT | C_IDENT | C_HEX;
+    }
+    for (int c = 'a'; c <= 'z'; c++) {
+        table[c] = C_IDENT_FIRST | C_IDENT;
+        table[c - 'a' + 'A'] = C_IDENT_FIRST | C_IDENT;
+    }
+    for (int c = 'a'; c <= 'f'; c++) {
+        table[c] |= C_HEX;
+        table[c - 'a' + 'A'] |= C_HEX;
+    }
+    table['$'] = table['_'] = C_IDENT_FIRST | C_IDENT;
+    return table;
+}
+
+constexpr std::array<TokenKind, 256> make_punctuation() {
+    std::array<TokenKind, 256> table{};
+    for (auto &kind : table) {
+        kind = TokenKind::ERROR;
+    }
+    table[','] = TokenKind::COMMA;
+    table[':'] = TokenKind::COLON;
+    table['('] = TokenKind::LPAREN;
+    table[')'] = TokenKind::RPAREN;
+    table['+'] = TokenKind::PLUS;
+    table['-'] = TokenKind::MINUS;
+    table['*'] = TokenKind::STAR;
+    table['/'] = TokenKind::SLASH;
+    table['~'] = TokenKind::TILDE;
+    table['&'] = TokenKind::AMP;
+    table['|'] = TokenKind::PIPE;
+    return table;
+}
+
+constexpr auto classes = make_classes();
+constexpr auto punctuation = make_punctuation();
+
+inline bool is(char c, uint8_t cls) { return (classes[static_cast<unsigned char>(c)] & cls) != 0; }
+
+inline int digit_value(char c) {
+    if (c <= '9') {
+        return c - '0';
+    }
+    return (c | 0x20) - 'a' + 10;
+}
+
+}  // namespace
+
+bool Lexer::skip() {
+    const size_t n = this->source.size();
+    bool blank = this->pos < n && is(this->source[this->pos], C_BLANK);
+
+    while (this->pos < n) {
+        char c = this->source[this->pos];
+        if (is(c, C_BLANK)) {
+            this->pos++;
+        } else if (c == '#' || (c == '/' && this->pos + 1 < n && this->source[this->pos + 1] == '/')) {
+            while (this->pos < n && this->source[this->pos] != '\n') {
+                this->pos++;
+            }
+        } else if (c == '/' && this->pos + 1 < n && this->source[this->pos + 1] == '*') {
+            size_t end = this->source.find("*/", this->pos + 2);
+            if (end == std::string_view::npos) {
+                return blank;  // Unterminated; next() reports it
+            }
+            for (size_t i = this->pos; i < end; i++) {
+                this->line += this->source[i] == '\n';
+            }
+            this->pos = end + 2;
+        } else {
+            break;
+        }
+    }
+    return blank;
+}
+
+Token Lexer::make(TokenKind kind, size_t begin) {
+    Token token;
+    token.kind = kind;
+    token.line = this->line;
+    token.text = this->source.substr(begin, this->pos - begin);
+    return token;
+}
+
+Token Lexer::next() {
+    bool blank = skip();
+    const size_t n = this->source.size();
+    size_t begin = this->pos;
+
+    Token token;
+    if (this->pos >= n) {
+        token = make(TokenKind::END, begin);
+    } else {
+        char c = this->source[this->pos];
+        if (c == '\n') {
+            this->pos++;
+            token = make(TokenKind::NEWLINE, begin);
+            this->line++;
+        } else if (is(c, C_DIGIT) || (c == '.' && this->pos + 1 < n && is(this->source[this->pos + 1], C_DIGIT))) {
+            token = number(begin);
+        } else if (is(c, C_IDENT_FIRST) || c == '.') {
+            token = word(begin);
+        } else if (c == '"') {
+            token = string(begin);
+        } else if (c == '/' && this->pos + 1 < n && this->source[this->pos + 1] == '*') {
+            this->pos = n;  // Unterminated block comment
+            token = make(TokenKind::ERROR, begin);
+        } else {
+            this->pos++;
+            token = make(punctuation[static_cast<unsigned char>(c)], begin);
+        }
+    }
+    token.blank_before = blank;
+    return token;
+}
+
+/**
+ * Integers follow the expression grammar: `0x` hex, `0b` binary or decimal, where a prefix with
+ * no digits is an error. Decimal literals with a fraction or exponent are REAL tokens, which only
+ * the floating point directives accept.
+ */
+Token Lexer::number(size_t begin) {
+    const size_t n = this->source.size();
+    const std::string_view &s = this->source;
+
+    uint8_t base = 10;
+    if (s[begin] == '0' && begin + 1 < n && (s[begin + 1] == 'x' || s[begin + 1] == 'b')) {
+        base = s[begin + 1] == 'x' ? 16 : 2;
+        this->pos += 2;
+    }
+
+    uint64_t value = 0;
+    bool overflow = false;
+    size_t digits = this->pos;
+    while (this->pos < n && is(s[this->pos], base == 16 ? C_HEX : C_DIGIT)) {
+        int d = digit_value(s[this->pos]);
+        if (d >= base) {
+            break;
+        }
+        if (!overflow) {
+            value = value * base + d;
+            overflow = value > UINT32_MAX;
+        }
+        this->pos++;
+    }
+
+    if (base != 10) {
+        if (this->pos == digits) {
+            return make(TokenKind::ERROR, begin);
+        }
+    } else {
+        bool real = false;
+        if (this->pos < n && s[this->pos] == '.') {
+            real = true;
+            this->pos++;
+            while (this->pos < n && is(s[this->pos], C_DIGIT)) {
+                this->pos++;
+            }
+        }
+        if (this->pos < n && (s[this->pos] | 0x20) == 'e') {
+            size_t exp = this->pos + 1;
+            if (exp < n && (s[exp] == '+' || s[exp] == '-')) {
+                exp++;
+            }
+            if (exp < n && is(s[exp], C_DIGIT)) {
+                real = true;
+                this->pos = exp;
+                while (this->pos < n && is(s[this->pos], C_DIGIT)) {
+                    this->pos++;
+                }
+            }
+        }
+        if (real) {
+            return make(TokenKind::REAL, begin);
+        }
+    }
+
+    Token token = make(TokenKind::INTEGER, begin);
+    token.base = base;
+    token.overflow = overflow;
+    token.value = static_cast<uint32_t>(value);
+    return token;
+}
+
+/**
+ * Identifiers, registers, opcodes and directives. A word is only a keyword if the whole word
+ * matches, so `$ras` is an identifier and `.alias$0` is not a directive.
+ */
+Token Lexer::word(size_t begin) {
+    const size_t n = this->source.size();
+    const std::string_view &s = this->source;
+
+    if (s[begin] == '.') {
+        this->pos++;
+        while (this->pos < n && is(s[this->pos], C_IDENT)) {
+            this->pos++;
+        }
+        Token token = make(TokenKind::ERROR, begin);
+        DirectiveKind kind;
+        if (lookup_directive(token.text, kind)) {
+            token.kind = TokenKind::DIRECTIVE;
+            token.value = static_cast<uint32_t>(kind);
+        }
+        return token;
+    }
+
+    while (this->pos < n && is(s[this->pos], C_IDENT)) {
+        this->pos++;
+    }
+
+    /* Mnemonics such as c.eq.d contain dots, which identifiers cannot. */
+    if (this->pos < n && s[this->pos] == '.') {
+        size_t end = this->pos;
+        while (end < n && (is(s[end], C_IDENT) || s[end] == '.')) {
+            end++;
+        }
+        if (is_opcode(s.substr(begin, end - begin))) {
+            this->pos = end;
+            return make(TokenKind::OPCODE, begin);
+        }
+    }
+
+    Token token = make(TokenKind::IDENT, begin);
+    int reg;
+    bool fp;
+    if (s[begin] == '$' && lookup_register(token.text, reg, fp)) {
+        token.kind = fp ? TokenKind::FP_REGISTER : TokenKind::REGISTER;
+        token.value = static_cast<uint32_t>(reg);
+    } else if (is_opcode(token.text)) {
+        token.kind = TokenKind::OPCODE;
+    }
+    return token;
+}
+
+/* Find the closing quote. Escaped characters never close the string; newlines do not either. */
+Token Lexer::string(size_t begin) {
+    const size_t n = this->source.size();
+    uint32_t first_line = this->line;
+
+    this->pos++;
+    while (this->pos < n && this->source[this->pos] != '"') {
+        if (this->source[this->pos] == '\\' && this->pos + 1 < n) {
+            this->pos++;
+        }
+        this->line += this->source[this->pos] == '\n';
+        this->pos++;
+    }
+    if (this->pos >= n) {
+        return make(TokenKind::ERROR, begin);
+    }
+    this->pos++;
+
+    Token token = make(TokenKind::STRING, begin);
+    token.line = first_line;
+    return token;
+}
+
+bool lookup_directive(std::string_view name, DirectiveKind &kind) {
+    const DirectiveName *dir = directives.find(name);
+    if (dir == nullptr) {
+        return false;
+    }
+    kind = dir->kind;
+    return true;
+}
+
+bool lookup_register(std::string_view name, int &reg, bool &floating_point) {
+    const RegisterName *r = registers.find(name);
+    if (r == nullptr) {
+        return false;
+    }
+    reg = r->number;
+    floating_point = r->floating_point;
+    return true;
+}
+
+bool is_opcode(std::string_view name) { return opcodes.contains(name); }
+
+}  // namespace rd
+}  // namespace mips_parser
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_RD_LEXER_H
+#define SPIMBOT_PARSER_RD_LEXER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../directive/directive_names.h"
+
+namespace mips_parser {
+namespace rd {
+
+enum class TokenKind : uint8_t {
+    END,
+    NEWLINE,
+    IDENT,        // Label or symbol name (never a reserved word)
+    OPCODE,       // Instruction mnemonic, including dotted ones such as `add.d`
+    DIRECTIVE,    // `.word`, `.text`, ...; value is a DirectiveKind
+    REGISTER,     // General purpose register; value is its number
+    FP_REGISTER,  // $f0 - $f31; value is its number
+    INTEGER,      // Decimal, 0x hex or 0b binary literal; value holds it if it fits in 32 bits
+    REAL,         // Decimal literal with a fraction and/or exponent
+    STRING,       // Double-quoted string; text includes the quotes and the raw escapes
+    COMMA,
+    COLON,
+    LPAREN,
+    RPAREN,
+    PLUS,
+    MINUS,
+    STAR,
+    SLASH,
+    TILDE,
+    AMP,
+    PIPE,
+    ERROR,  // Malformed token; text covers the offending characters
+};
+
+struct Token {
+    TokenKind kind = TokenKind::END;
+
+    /* A blank (space or tab) immediately precedes this token. Used for the grammar's blank_after[]. */
+    bool blank_before = false;
+
+    /* INTEGER: radix it was written in (2, 10 or 16) and whether it overflowed 32 bits. */
+    uint8_t base = 10;
+    bool overflow = false;
+
+    uint32_t line = 1;
+    uint32_t value = 0;
+    std::string_view text;
+};
+
+/**
+ * Hand-written scanner for MIPS assembly.
+ *
+ * Characters are classified through a 256-entry table, so each token is recognized with one
+ * pass over its bytes and no backtracking. Blanks and comments (`#`, `//` and block comments)
+ * are skipped; newlines are tokens, since they end statements. Tokens are views into SOURCE,
+ * which must outlive the lexer.
+ */
+class Lexer {
+   public:
+    explicit Lexer(std::string_view source) : source(source) {}
+
+    Token next();
+
+    std::string_view input() const { return this->source; }
+
+   private:
+    /* Skip blanks and comments; returns true if the first character skipped was a blank. */
+    bool skip();
+
+    Token make(TokenKind kind, size_t begin);
+    Token number(size_t begin);
+    Token word(size_t begin);
+    Token string(size_t begin);
+
+    std::string_view source;
+    size_t pos = 0;
+    uint32_t line = 1;
+};
+
+/* Lookups shared with the parser. Return false if NAME is not in the table. */
+bool lookup_directive(std::string_view name, DirectiveKind &kind);
+bool lookup_register(std::string_view name, int &reg, bool &floating_point);
+bool is_opcode(std::string_view name);
+
+}  // namespace rd
+}  // namespace mips_parser
+
+#endif
@@ -0,0 +1,665 @@
+#include "parser.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <utility>
+
+namespace mips_parser {
+namespace rd {
+
+namespace ast = client::ast;
+
+Parser::Parser(std::string_view source) : lexer(source) { this->tok = this->lexer.next(); }
+
+const Token &Parser::peek() {
+    if (!this->has_ahead) {
+        this->ahead = this->lexer.next();
+        this->has_ahead = true;
+    }
+    return this->ahead;
+}
+
+void Parser::advance() {
+    if (this->has_ahead) {
+        this->tok = this->ahead;
+        this->has_ahead = false;
+    } else {
+        this->tok = this->lexer.next();
+    }
+}
+
+bool Parser::accept(TokenKind kind) {
+    if (this->tok.kind != kind) {
+        return false;
+    }
+    advance();
+    return true;
+}
+
+void Parser::expect(TokenKind kind, const char *what) {
+    if (!accept(kind)) {
+        fail(what);
+    }
+}
+
+std::string_view Parser::line_of(const Token &token) const {
+    std::string_view input = this->lexer.input();
+    size_t offset = static_cast<size_t>(token.text.data() - input.data());
+    size_t newline = offset == 0 ? std::string_view::npos : input.rfind('\n', offset - 1);
+    size_t line_start = newline == std::string_view::npos ? 0 : newline + 1;
+    size_t line_end = std::min(input.find('\n', offset), input.size());
+    if (line_end > line_start && input[line_end - 1] == '\r') {
+        line_end--;
+    }
+    return input.substr(line_start, line_end - line_start);
+}
+
+void Parser::fail(const char *what) const {
+    std::string_view input = this->lexer.input();
+    size_t offset = static_cast<size_t>(this->tok.text.data() - input.data());
+    size_t line_start = static_cast<size_t>(line_of(this->tok).data() - input.data());
+
+    std::string message = std::string("expected ") + what;
+    if (this->tok.kind == TokenKind::END || this->tok.kind == TokenKind::NEWLINE) {
+        message += " at end of line";
+    } else {
+        message += " before '" + std::string(this->tok.text) + "'";
+    }
+    throw syntax_error(message, this->tok.line, static_cast<uint32_t>(offset - line_start + 1));
+}
+
+void Parser::expect_end() {
+    if (this->tok.kind != TokenKind::END) {
+        fail("end of input");
+    }
+}
+
+/*
+ * Expressions. Levels, loosest first: | & (+ -) (* /). Unary operators apply to a primary.
+ */
+
+static bool binary_op(int level, TokenKind kind, ast::optoken &op) {
+    switch (level) {
+        case 0:
+            op = ast::op_bitwise_or;
+            return kind == TokenKind::PIPE;
+        case 1:
+            op = ast::op_bitwise_and;
+            return kind == TokenKind::AMP;
+        case 2:
+            op = kind == TokenKind::PLUS ? ast::op_plus : ast::op_minus;
+            return kind == TokenKind::PLUS || kind == TokenKind::MINUS;
+        default:
+            op = kind == TokenKind::STAR ? ast::op_times : ast::op_divide;
+            return kind == TokenKind::STAR || kind == TokenKind::SLASH;
+    }
+}
+
+constexpr int UNARY_LEVEL = 4;
+
+ast::operand Parser::binary(int level) {
+    if (level == UNARY_LEVEL) {
+        return unary();
+    }
+
+    ast::operand first = binary(level + 1);
+    ast::optoken op;
+    if (!binary_op(level, this->tok.kind, op)) {
+        return first;
+    }
+
+    ast::expression ex;
+    ex.first = std::move(first);
+    do {
+        advance();
+        ast::operation operation;
+        operation.operator_ = op;
+        operation.operand_ = binary(level + 1);
+        ex.rest.push_back(std::move(operation));
+    } while (binary_op(level, this->tok.kind, op));
+
+    return ast::operand(x3::forward_ast<ast::expression>(std::move(ex)));
+}
+
+ast::operand Parser::unary() {
+    ast::optoken op;
+    switch (this->tok.kind) {
+        case TokenKind::PLUS:
+            op = ast::op_positive;
+            break;
+        case TokenKind::MINUS:
+            op = ast::op_negative;
+            break;
+        case TokenKind::TILDE:
+            op = ast::op_bitwise_not;
+            break;
+        default:
+            return primary();
+    }
+    advance();
+
+    ast::unary node;
+    node.operator_ = op;
+    node.operand_ = primary();
+    return ast::operand(x3::forward_ast<ast::unary>(std::move(node)));
+}
+
+ast::operand Parser::primary() {
+    switch (this->tok.kind) {
+        case TokenKind::INTEGER: {
+            if (this->tok.overflow) {
+                fail("a 32-bit integer");
+            }
+            unsigned int value = this->tok.value;
+            advance();
+            return ast::operand(value);
+        }
+        case TokenKind::IDENT: {
+            ast::label label;
+            label.name = this->tok.text;
+            advance();
+            return ast::operand(std::move(label));
+        }
+        case TokenKind::LPAREN: {
+            advance();
+            ast::expression ex = expression();
+            expect(TokenKind::RPAREN, "')'");
+            return ast::operand(x3::forward_ast<ast::expression>(std::move(ex)));
+        }
+        default:
+            fail("an expression");
+    }
+}
+
+bool Parser::starts_expression() const {
+    switch (this->tok.kind) {
+        case TokenKind::INTEGER:
+        case TokenKind::IDENT:
+        case TokenKind::LPAREN:
+        case TokenKind::PLUS:
+        case TokenKind::MINUS:
+        case TokenKind::TILDE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ast::expression Parser::expression() {
+    ast::operand result = binary(0);
+
+    if (auto *nested = boost::get<x3::forward_ast<ast::expression>>(&result.get())) {
+        return std::move(nested->get());
+    }
+    ast::expression ex;
+    ex.first = std::move(result);
+    return ex;
+}
+
+/*
+ * Directive operands
+ */
+
+/* EXPR_LST or REPEAT_EXPR_LST: `e1 [,] e2 ...` or `value : count`. */
+template <class ListDir, class RepeatDir>
+ast::Directive Parser::expression_list() {
+    ast::expression first = expression();
+
+    if (accept(TokenKind::COLON)) {
+        RepeatDir dir;
+        dir.repeat_list.repeat_value = std::move(first);
+        dir.repeat_list.repeat_num = expression();
+        return ast::Directive(std::move(dir));
+    }
+
+    ListDir dir;
+    dir.expression_list.push_back(std::move(first));
+    for (;;) {
+        if (accept(TokenKind::COMMA) || starts_expression()) {
+            dir.expression_list.push_back(expression());
+        } else {
+            return ast::Directive(std::move(dir));
+        }
+    }
+}
+
+static bool is_fp_word(std::string_view word) {
+    for (const char *name : {"nan", "inf", "infinity"}) {
+        if (word.size() == strlen(name) && strncasecmp(word.data(), name, word.size()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Parser::starts_fp_literal() const {
+    switch (this->tok.kind) {
+        case TokenKind::REAL:
+        case TokenKind::INTEGER:
+        case TokenKind::PLUS:
+        case TokenKind::MINUS:
+            return true;
+        case TokenKind::IDENT:
+            return is_fp_word(this->tok.text);
+        default:
+            return false;
+    }
+}
+
+/* A double_ literal: optional sign directly followed by a decimal number, nan or inf. */
+double Parser::fp_literal() {
+    bool negative = false;
+    if (this->tok.kind == TokenKind::PLUS || this->tok.kind == TokenKind::MINUS) {
+        negative = this->tok.kind == TokenKind::MINUS;
+        advance();
+        if (this->tok.blank_before) {
+            fail("a floating point number");
+        }
+    }
+
+    bool number = this->tok.kind == TokenKind::REAL || (this->tok.kind == TokenKind::INTEGER && this->tok.base == 10);
+    if (!number && !(this->tok.kind == TokenKind::IDENT && is_fp_word(this->tok.text))) {
+        fail("a floating point number");
+    }
+
+    double value = std::strtod(std::string(this->tok.text).c_str(), nullptr);
+    advance();
+    return negative ? -value : value;
+}
+
+template <class ListDir, class RepeatDir>
+ast::Directive Parser::fp_list() {
+    double first = fp_literal();
+
+    if (accept(TokenKind::COLON)) {
+        RepeatDir dir;
+        dir.repeat_list.repeat_value = first;
+        dir.repeat_list.repeat_num = expression();
+        return ast::Directive(std::move(dir));
+    }
+
+    ListDir dir;
+    dir.expression_list.push_back(first);
+    for (;;) {
+        if (accept(TokenKind::COMMA) || starts_fp_literal()) {
+            dir.expression_list.push_back(fp_literal());
+        } else {
+            return ast::Directive(std::move(dir));
+        }
+    }
+}
+
+/* QUOTE_STRING % "," */
+std::vector<ast::StringLiteral> Parser::string_list() {
+    std::vector<ast::StringLiteral> strings;
+    do {
+        if (this->tok.kind != TokenKind::STRING) {
+            fail("a string");
+        }
+        strings.emplace_back(this->tok.text);
+        advance();
+    } while (accept(TokenKind::COMMA));
+    return strings;
+}
+
+std::string_view Parser::ident() {
+    if (this->tok.kind != TokenKind::IDENT) {
+        fail("an identifier");
+    }
+    std::string_view name = this->tok.text;
+    advance();
+    return name;
+}
+
+int Parser::reg() {
+    if (this->tok.kind != TokenKind::REGISTER) {
+        fail("a register");
+    }
+    int number = static_cast<int>(this->tok.value);
+    advance();
+    return number;
+}
+
+/* uint_ (decimal only) or, with ANY_BASE, the unsigned_ helper that also takes 0x and 0b. */
+uint32_t Parser::uint(bool any_base) {
+    if (this->tok.kind != TokenKind::INTEGER || this->tok.overflow || (!any_base && this->tok.base != 10)) {
+        fail("an unsigned integer");
+    }
+    uint32_t value = this->tok.value;
+    advance();
+    return value;
+}
+
+/* blank_after[uint_]: the number must be followed by a blank. */
+uint32_t Parser::uint_then_blank(bool any_base) {
+    uint32_t value = uint(any_base);
+    if (!this->tok.blank_before) {
+        fail("a blank");
+    }
+    return value;
+}
+
+std::optional<uint32_t> Parser::optional_uint(bool any_base) {
+    if (this->tok.kind != TokenKind::INTEGER) {
+        return std::nullopt;
+    }
+    return uint(any_base);
+}
+
+ast::Directive Parser::directive() {
+    if (this->tok.kind != TokenKind::DIRECTIVE) {
+        fail("a directive");
+    }
+    auto kind = static_cast<DirectiveKind>(this->tok.value);
+    advance();
+
+    switch (kind) {
+        case DirectiveKind::ALIAS: {
+            ast::AliasDir dir;
+            dir.reg1 = reg();
+            dir.reg2 = reg();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ALIGN: {
+            ast::AlignDir dir;
+            dir.alignment = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ASCII: {
+            ast::AsciiDir dir;
+            static_cast<std::vector<ast::StringLiteral> &>(dir) = string_list();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ASCIIZ: {
+            ast::AsciizDir dir;
+            static_cast<std::vector<ast::StringLiteral> &>(dir) = string_list();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ASM0:
+            return ast::Directive(ast::Asm0Dir{});
+        case DirectiveKind::BGNB: {
+            ast::BgnbDir dir;
+            dir.symno = static_cast<int>(uint(false));
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::BYTE:
+            return expression_list<ast::ByteDir, ast::ByteRepeatDir>();
+        case DirectiveKind::COMM: {
+            ast::CommDir dir;
+            dir.ident = ident();
+            expect(TokenKind::COMMA, "','");
+            dir.expr = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::DATA: {
+            ast::DataDir dir;
+            dir.addr = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::KDATA: {
+            ast::KDataDir dir;
+            dir.addr = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::DOUBLE:
+            return fp_list<ast::DoubleDir, ast::DoubleRepeatDir>();
+        case DirectiveKind::END: {
+            ast::EndDir dir;
+            if (this->tok.kind == TokenKind::IDENT) {
+                dir.proc_name = ident();
+            }
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ENDB: {
+            ast::EndbDir dir;
+            dir.symno = static_cast<int>(uint(false));
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ENDR:
+            return ast::Directive(ast::EndrDir{});
+        case DirectiveKind::ENT: {
+            ast::EntDir dir;
+            dir.proc_name = ident();
+            dir.lex_level = optional_uint(false);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::ERR:
+            return ast::Directive(ast::ErrDir{});
+        case DirectiveKind::EXTERN: {
+            ast::ExternDir dir;
+            dir.name = ident();
+            dir.number = optional_uint(false);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::FILE: {
+            ast::FileDir dir;
+            dir.file_no = static_cast<int32_t>(uint_then_blank(false));
+            if (this->tok.kind != TokenKind::STRING) {
+                fail("a string");
+            }
+            dir.filename = this->tok.text;
+            advance();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::FLOAT:
+            return fp_list<ast::FloatDir, ast::FloatRepeatDir>();
+        case DirectiveKind::FMASK: {
+            ast::FmaskDir dir;
+            dir.mask = uint_then_blank(true);
+            dir.offset = uint(false);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::FRAME: {
+            ast::FrameDir dir;
+            dir.frame_register = static_cast<uint32_t>(reg());
+            dir.frame_size = uint_then_blank(false);
+            dir.return_pc_register = static_cast<uint32_t>(reg());
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::GLOBAL: {
+            ast::GlobalDir dir;
+            dir.id = ident();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::HALF:
+            return expression_list<ast::HalfDir, ast::HalfRepeatDir>();
+        case DirectiveKind::LABEL: {
+            ast::LabelDir dir;
+            dir.label_name = ident();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::LCOMM: {
+            ast::LcommDir dir;
+            dir.name = ident();
+            dir.expr = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::LIVEREG: {
+            ast::LiveregDir dir;
+            dir.int_bitmask = uint_then_blank(true);
+            dir.fp_bitmask = uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::LOC: {
+            ast::LocDir dir;
+            dir.file_number = static_cast<int32_t>(uint_then_blank(false));
+            dir.line_number = static_cast<int32_t>(uint(false));
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::MASK: {
+            ast::MaskDir dir;
+            dir.mask = uint_then_blank(true);
+            dir.offset = uint(false);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::NOALIAS: {
+            ast::NoaliasDir dir;
+            dir.reg1 = static_cast<uint32_t>(reg());
+            dir.reg2 = static_cast<uint32_t>(reg());
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::OPTIONS: {
+            ast::OptionDir dir;
+            dir.option = ident();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::RDATA: {
+            ast::RDataDir dir;
+            dir.address = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::REPEAT: {
+            ast::RepeatDir dir;
+            dir.repeat_num = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::SDATA: {
+            ast::SDataDir dir;
+            dir.address = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::SET: {
+            ast::SetDir dir;
+            dir.option = ident();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::SPACE: {
+            ast::SpaceDir dir;
+            dir.num_bytes = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::STRUCT: {
+            ast::StructDir dir;
+            dir.num_bytes = expression();
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::TEXT: {
+            ast::TextDir dir;
+            dir.addr = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::KTEXT: {
+            ast::KTextDir dir;
+            dir.addr = optional_uint(true);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::VERSTAMP: {
+            ast::VerstampDir dir;
+            dir.major_ver = uint_then_blank(false);
+            dir.minor_ver = uint(false);
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::VREG: {
+            ast::VregDir dir;
+            dir.reg = static_cast<uint32_t>(reg());
+            dir.offset = static_cast<int32_t>(uint_then_blank(false));
+            dir.symno = static_cast<int32_t>(uint(false));
+            return ast::Directive(std::move(dir));
+        }
+        case DirectiveKind::WORD:
+            return expression_list<ast::WordDir, ast::WordRepeatDir>();
+    }
+    fail("a directive");
+}
+
+/*
+ * Instructions
+ */
+
+/* A register, `expr`, `(reg)` or `expr(reg)`. */
+ast::InstOperand Parser::operand() {
+    if (this->tok.kind == TokenKind::REGISTER || this->tok.kind == TokenKind::FP_REGISTER) {
+        ast::RegisterOperand reg;
+        reg.reg = static_cast<int>(this->tok.value);
+        reg.floating_point = this->tok.kind == TokenKind::FP_REGISTER;
+        advance();
+        return ast::InstOperand(reg);
+    }
+
+    ast::AddressOperand addr;
+    if (this->tok.kind != TokenKind::LPAREN || peek().kind != TokenKind::REGISTER) {
+        ast::expression offset = expression();
+        if (this->tok.kind != TokenKind::LPAREN || peek().kind != TokenKind::REGISTER) {
+            return ast::InstOperand(std::move(offset));
+        }
+        addr.offset = std::move(offset);
+    }
+    advance();
+    addr.base_reg = reg();
+    expect(TokenKind::RPAREN, "')'");
+    return ast::InstOperand(std::move(addr));
+}
+
+ast::InstructionStmt Parser::instruction() {
+    ast::InstructionStmt inst;
+    inst.mnemonic = this->tok.text;
+    advance();
+
+    if (this->tok.kind == TokenKind::NEWLINE || this->tok.kind == TokenKind::END) {
+        return inst;
+    }
+    for (;;) {
+        inst.operands.push_back(operand());
+        if (!accept(TokenKind::COMMA) && this->tok.kind != TokenKind::REGISTER &&
+            this->tok.kind != TokenKind::FP_REGISTER && !starts_expression()) {
+            return inst;
+        }
+    }
+}
+
+ast::Statement Parser::statement() {
+    ast::Statement st;
+    st.line = this->tok.line;
+    if (this->tok.kind != TokenKind::NEWLINE && this->tok.kind != TokenKind::END) {
+        st.source = line_of(this->tok);
+    }
+
+    while (this->tok.kind == TokenKind::IDENT && peek().kind == TokenKind::COLON) {
+        st.labels.emplace_back(this->tok.text);
+        advance();
+        advance();
+    }
+
+    if (this->tok.kind == TokenKind::DIRECTIVE) {
+        st.body = directive();
+    } else if (this->tok.kind == TokenKind::OPCODE) {
+        st.body = instruction();
+    }
+
+    if (!accept(TokenKind::NEWLINE) && this->tok.kind != TokenKind::END) {
+        fail("end of line");
+    }
+    return st;
+}
+
+std::vector<ast::Statement> Parser::program() {
+    std::vector<ast::Statement> statements;
+    while (this->tok.kind != TokenKind::END) {
+        ast::Statement st = statement();
+        if (!st.labels.empty() || st.body.get().which() != 0) {
+            statements.push_back(std::move(st));
+        }
+    }
+    return statements;
+}
+
+ast::expression parse_expression(std::string_view source) {
+    Parser parser(source);
+    ast::expression ex = parser.expression();
+    parser.expect_end();
+    return ex;
+}
+
+ast::Directive parse_directive(std::string_view source) {
+    Parser parser(source);
+    ast::Directive dir = parser.directive();
+    parser.expect_end();
+    return ast::Directive(std::move(dir));
+}
+
+std::vector<ast::Statement> parse_program(std::string_view source) { return Parser(source).program(); }
+
+}  // namespace rd
+}  // namespace mips_parser
@@ -0,0 +1,101 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_RD_PARSER_H
+#define SPIMBOT_PARSER_RD_PARSER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../statement/ast.h"
+#include "lexer.h"
+
+namespace mips_parser {
+namespace rd {
+
+class syntax_error : public std::runtime_error {
+   public:
+    syntax_error(const std::string &what, uint32_t line, uint32_t column)
+        : std::runtime_error(what), line(line), column(column) {}
+
+    uint32_t line;
+    uint32_t column;
+};
+
+/**
+ * Recursive-descent parser over Lexer tokens.
+ *
+ * Accepts the same language as the Spirit X3 grammar in this directory and builds the same
+ * client::ast nodes, but decides every alternative from at most two tokens of lookahead instead
+ * of trying rules in order, so each byte of input is examined once. Expression trees are the
+ * minimal equivalent of the X3 ones: a precedence level with no operator is not wrapped in its
+ * own expression node. Errors throw syntax_error.
+ */
+class Parser {
+   public:
+    explicit Parser(std::string_view source);
+
+    client::ast::expression expression();
+    client::ast::Directive directive();
+
+    /* One line: labels, then an optional directive or instruction, then the end of the line. */
+    client::ast::Statement statement();
+
+    /* All non-empty statements up to the end of the input. */
+    std::vector<client::ast::Statement> program();
+
+    /* Throw unless all input has been consumed (trailing blanks and comments are fine). */
+    void expect_end();
+
+   private:
+    const Token &peek();
+    void advance();
+    bool accept(TokenKind kind);
+    void expect(TokenKind kind, const char *what);
+    [[noreturn]] void fail(const char *what) const;
+
+    /* The source line TOKEN is on, without its line terminator. */
+    std::string_view line_of(const Token &token) const;
+
+    /* Expressions */
+    client::ast::operand binary(int level);
+    client::ast::operand unary();
+    client::ast::operand primary();
+    bool starts_expression() const;
+
+    /* Directive operands */
+    template <class ListDir, class RepeatDir>
+    client::ast::Directive expression_list();
+    template <class ListDir, class RepeatDir>
+    client::ast::Directive fp_list();
+    double fp_literal();
+    bool starts_fp_literal() const;
+
+    std::vector<client::ast::StringLiteral> string_list();
+    std::string_view ident();
+    int reg();
+    uint32_t uint(bool any_base);
+    uint32_t uint_then_blank(bool any_base);
+    std::optional<uint32_t> optional_uint(bool any_base);
+
+    /* Instructions */
+    client::ast::InstructionStmt instruction();
+    client::ast::InstOperand operand();
+
+    Lexer lexer;
+    Token tok;
+    Token ahead;
+    bool has_ahead = false;
+};
+
+/* Parse SOURCE as exactly one expression / directive, or as a whole program. The results point
+   into SOURCE, so it must outlive them. */
+client::ast::expression parse_expression(std::string_view source);
+client::ast::Directive parse_directive(std::string_view source);
+std::vector<client::ast::Statement> parse_program(std::string_view source);
+
+}  // namespace rd
+}  // namespace mips_parser
+
+#endif
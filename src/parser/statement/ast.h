@@ -0,0 +1,62 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_STATEMENT_AST_H
+#define SPIMBOT_PARSER_STATEMENT_AST_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/blank.hpp>
+
+#include "../directive/ast.h"
+#include "../expression/ast.h"
+
+namespace client {
+namespace ast {
+
+/* Instruction operands */
+struct RegisterOperand : x3::position_tagged {
+    int reg;
+    bool floating_point = false;
+};
+
+/**
+ * Memory operand: `offset(base)`, `(base)` or a bare `offset`. Mirrors SPIM's addr_expr.
+ */
+struct AddressOperand : x3::position_tagged {
+    std::optional<client::ast::expression> offset;
+    int base_reg;
+};
+
+struct InstOperand : x3::variant<RegisterOperand, AddressOperand, client::ast::expression> {
+    using base_type::base_type;
+    using base_type::operator=;
+};
+
+/**
+ * An instruction as written. Operand kinds are not checked against the opcode here; that is the
+ * job of the code that encodes it.
+ */
+struct InstructionStmt : x3::position_tagged {
+    std::string_view mnemonic;
+    std::vector<InstOperand> operands;
+};
+
+/**
+ * One logical line of a source file: any number of `label:` definitions followed by an optional
+ * directive or instruction. Like the names in it, SOURCE (the line as written, without its newline)
+ * is a view into the source text.
+ */
+struct Statement : x3::position_tagged {
+    uint32_t line = 0;
+    std::string_view source;
+    std::vector<std::string_view> labels;
+    x3::variant<boost::blank, Directive, InstructionStmt> body;
+};
+
+}  // namespace ast
+}  // namespace client
+
+#endif
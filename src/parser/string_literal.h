@@ -0,0 +1,103 @@
+#pragma once
+#ifndef SPIMBOT_PARSER_STRING_LITERAL_H
+#define SPIMBOT_PARSER_STRING_LITERAL_H
+
+#include <string>
+#include <string_view>
+
+namespace client {
+namespace ast {
+
+/**
+ * A double-quoted string as written in the source: quotes included, escapes not yet expanded.
+ *
+ * Only the directives that store bytes (.ascii, .asciiz) need the expanded text, so parsing
+ * keeps a view into the source and decode() does the work when, and if, it is needed.
+ */
+struct StringLiteral {
+    std::string_view quoted;
+
+    StringLiteral() = default;
+    StringLiteral(std::string_view quoted) : quoted(quoted) {}
+
+    /* Expand the escapes the way the QUOTE_STRING grammar used to. */
+    std::string decode() const {
+        std::string_view s = this->quoted.substr(1, this->quoted.size() - 2);
+        std::string out;
+        out.reserve(s.size());
+
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] != '\\' || i + 1 == s.size()) {
+                out.push_back(s[i]);
+                continue;
+            }
+
+            char e = s[i + 1];
+            switch (e) {
+                case 'n':
+                    out.push_back('\n');
+                    i++;
+                    continue;
+                case 'b':
+                    out.push_back('\b');
+                    i++;
+                    continue;
+                case 'f':
+                    out.push_back('\f');
+                    i++;
+                    continue;
+                case 't':
+                    out.push_back('\t');
+                    i++;
+                    continue;
+                case 'v':
+                    out.push_back('\v');
+                    i++;
+                    continue;
+                case 'r':
+                    out.push_back('\r');
+                    i++;
+                    continue;
+                case '"':
+                case '\\':
+                    out.push_back(e);
+                    i++;
+                    continue;
+                default:
+                    break;
+            }
+
+            if (e >= '0' && e <= '7') {
+                int value = 0;
+                size_t j = i + 1;
+                for (; j < s.size() && j < i + 4 && s[j] >= '0' && s[j] <= '7'; j++) {
+                    value = value * 8 + (s[j] - '0');
+                }
+                out.push_back(static_cast<char>(value));
+                i = j - 1;
+            } else if (e == 'x' && i + 3 < s.size() && hex_value(s[i + 2]) >= 0 && hex_value(s[i + 3]) >= 0) {
+                out.push_back(static_cast<char>(hex_value(s[i + 2]) * 16 + hex_value(s[i + 3])));
+                i += 3;
+            } else {
+                out.push_back('\\');  // Not an escape; the backslash is literal
+            }
+        }
+        return out;
+    }
+
+    bool operator==(std::string_view decoded) const { return decode() == decoded; }
+    bool operator!=(std::string_view decoded) const { return !(*this == decoded); }
+
+   private:
+    static int hex_value(char c) {
+        if ('0' <= c && c <= '9') return c - '0';
+        if ('a' <= c && c <= 'f') return c - 'a' + 10;
+        if ('A' <= c && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+};
+
+}  // namespace ast
+}  // namespace client
+
+#endif
@@ -0,0 +1,207 @@
+#include "journal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "util/hash.h"
+
+namespace {
+
+constexpr char JOURNAL_MAGIC[8] = {'S', 'P', 'I', 'M', 'J', 'R', 'N', 'L'};
+constexpr uint32_t JOURNAL_VERSION = 1;
+
+/* Grow the file this many records at a time so most appends do not touch the file size. */
+constexpr size_t RECORDS_PER_CHUNK = 1024;
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    unsigned char reserved[48];
+};
+static_assert(sizeof(JournalHeader) == 64, "journal header is fixed at 64 bytes");
+
+uint32_t record_crc(const MatchRecord &record) {
+    return util::crc32(&record, offsetof(MatchRecord, crc));
+}
+
+bool record_is_empty(const MatchRecord &record) {
+    static const MatchRecord empty = {};
+    return memcmp(&record, &empty, sizeof(MatchRecord)) == 0;
+}
+
+JournalHeader new_header() {
+    JournalHeader header = {};
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header.version = JOURNAL_VERSION;
+    header.record_size = sizeof(MatchRecord);
+    return header;
+}
+
+}  // namespace
+
+TournamentJournal::~TournamentJournal() { close(); }
+
+bool TournamentJournal::fail(const char *what) {
+    this->last_error = std::string(what) + ": " + strerror(errno);
+    return false;
+}
+
+const MatchRecord *TournamentJournal::records() const {
+    return reinterpret_cast<const MatchRecord *>(this->base + sizeof(JournalHeader));
+}
+
+bool TournamentJournal::map(size_t capacity) {
+    size_t size = sizeof(JournalHeader) + capacity * sizeof(MatchRecord);
+    if (ftruncate(this->fd, size) != 0) {
+        return fail("cannot grow journal");
+    }
+
+    if (this->base != nullptr) {
+        munmap(this->base, this->mapped_size);
+        this->base = nullptr;
+    }
+
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+    if (addr == MAP_FAILED) {
+        return fail("cannot map journal");
+    }
+    this->base = static_cast<unsigned char *>(addr);
+    this->mapped_size = size;
+    return true;
+}
+
+bool TournamentJournal::open(const std::string &path) {
+    close();
+
+    this->fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (this->fd == -1) {
+        return fail("cannot open journal");
+    }
+
+    struct stat st;
+    if (fstat(this->fd, &st) != 0) {
+        return fail("cannot stat journal");
+    }
+
+    /* A file shorter than a header is one whose creation was interrupted: start it over. The
+       header reaches the disk before the file grows, so a crash never leaves a full-size file
+       without one. */
+    if ((size_t)st.st_size < sizeof(JournalHeader)) {
+        JournalHeader header = new_header();
+        if (ftruncate(this->fd, 0) != 0 || pwrite(this->fd, &header, sizeof(header), 0) != sizeof(header) ||
+            fsync(this->fd) != 0) {
+            return fail("cannot create journal");
+        }
+        st.st_size = sizeof(JournalHeader);
+    }
+
+    size_t on_disk = (st.st_size - sizeof(JournalHeader)) / sizeof(MatchRecord);
+    size_t capacity = (on_disk / RECORDS_PER_CHUNK + 1) * RECORDS_PER_CHUNK;
+    if (!map(capacity)) {
+        return false;
+    }
+
+    /* An all-zero header over no records is also an interrupted creation (by code that grew the
+       file first), not someone else's file. */
+    JournalHeader *header = reinterpret_cast<JournalHeader *>(this->base);
+    MatchRecord *recs = reinterpret_cast<MatchRecord *>(this->base + sizeof(JournalHeader));
+    static const JournalHeader blank = {};
+    if (memcmp(header, &blank, sizeof(JournalHeader)) == 0 &&
+        std::all_of(recs, recs + on_disk, record_is_empty)) {
+        *header = new_header();
+        msync(this->base, sizeof(JournalHeader), MS_SYNC);
+    } else if (memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+               header->version != JOURNAL_VERSION ||
+               header->record_size != sizeof(MatchRecord)) {
+        close();
+        this->last_error = path + " is not a version " + std::to_string(JOURNAL_VERSION) +
+                           " tournament journal";
+        return false;
+    }
+
+    /* Keep records up to the first empty or torn one; anything after it was never acknowledged. */
+    size_t valid = 0;
+    while (valid < on_disk && !record_is_empty(recs[valid]) &&
+           recs[valid].crc == record_crc(recs[valid])) {
+        this->index[recs[valid].match_id] = valid;
+        ++valid;
+    }
+
+    for (size_t i = valid; i < on_disk; ++i) {
+        if (!record_is_empty(recs[i])) {
+            ++this->dropped;
+        }
+    }
+    if (this->dropped != 0) {
+        memset(recs + valid, 0, (capacity - valid) * sizeof(MatchRecord));
+        msync(this->base, this->mapped_size, MS_SYNC);
+    }
+
+    this->count = valid;
+    return true;
+}
+
+void TournamentJournal::close() {
+    if (this->base != nullptr) {
+        msync(this->base, this->mapped_size, MS_SYNC);
+        munmap(this->base, this->mapped_size);
+        this->base = nullptr;
+    }
+    if (this->fd != -1) {
+        ::close(this->fd);
+        this->fd = -1;
+    }
+    this->mapped_size = 0;
+    this->count = 0;
+    this->dropped = 0;
+    this->index.clear();
+}
+
+bool TournamentJournal::append(MatchRecord record) {
+    if (this->base == nullptr) {
+        errno = EBADF;
+        return fail("journal is not open");
+    }
+
+    size_t capacity = (this->mapped_size - sizeof(JournalHeader)) / sizeof(MatchRecord);
+    if (this->count == capacity && !map(capacity + RECORDS_PER_CHUNK)) {
+        return false;
+    }
+
+    record.crc = record_crc(record);
+
+    MatchRecord *slot =
+        reinterpret_cast<MatchRecord *>(this->base + sizeof(JournalHeader)) + this->count;
+    memcpy(slot, &record, sizeof(MatchRecord));
+
+    /* Flush just the page(s) holding the new record before reporting success. */
+    uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = reinterpret_cast<uintptr_t>(slot) & ~(page - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(slot + 1);
+    if (msync(reinterpret_cast<void *>(start), end - start, MS_SYNC) != 0) {
+        return fail("cannot flush journal");
+    }
+
+    this->index[record.match_id] = this->count;
+    ++this->count;
+    return true;
+}
+
+const MatchRecord *TournamentJournal::find(uint64_t match_id) const {
+    auto it = this->index.find(match_id);
+    return it == this->index.end() ? nullptr : &records()[it->second];
+}
+
+bool TournamentJournal::is_complete(uint64_t match_id, uint64_t seed, uint64_t bot_hash0,
+                                    uint64_t bot_hash1) const {
+    const MatchRecord *record = find(match_id);
+    return record != nullptr && record->seed == seed && record->bot_hash[0] == bot_hash0 &&
+           record->bot_hash[1] == bot_hash1;
+}
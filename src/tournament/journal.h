@@ -0,0 +1,97 @@
+/**
+ * Crash-safe, append-only record of finished tournament matches.
+ *
+ * The tournament runner appends one record per finished match. If the run dies (OOM, reboot, a
+ * bot bringing down the process), reopening the journal recovers every record that made it to
+ * disk intact and the runner skips those matches instead of replaying the whole bracket.
+ *
+ * Layout: a 64-byte header followed by fixed-size 64-byte records, each carrying a CRC-32 of
+ * its contents. The file is memory-mapped and grown in chunks; a record torn by a crash fails its
+ * checksum and everything from it onwards is discarded on open.
+ */
+
+#pragma once
+
+#ifndef TOURNAMENT_JOURNAL_H_
+#define TOURNAMENT_JOURNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+/**
+ * Outcome of one match. Bot hashes identify the exact programs that played, so a resubmitted bot
+ * does not inherit an old result.
+ */
+struct MatchRecord {
+    uint64_t match_id;
+    uint64_t seed;
+    uint64_t bot_hash[2];
+    uint64_t cycles;
+    int32_t score[2];
+    int32_t winner;  // 0 or 1, -1 for a draw
+    uint32_t flags;  // MATCH_* bits
+    uint32_t reserved;
+    uint32_t crc;  // CRC-32 of all the bytes above
+};
+static_assert(sizeof(MatchRecord) == 64, "journal records are fixed at 64 bytes");
+
+constexpr uint32_t MATCH_TIMED_OUT = 0x1;   // Hit the cycle limit
+constexpr uint32_t MATCH_BOT_FAILED = 0x2;  // A bot crashed the simulator or raised a fatal error
+
+class TournamentJournal {
+   public:
+    TournamentJournal() = default;
+    ~TournamentJournal();
+
+    TournamentJournal(const TournamentJournal &) = delete;
+    TournamentJournal &operator=(const TournamentJournal &) = delete;
+
+    /**
+     * Open (creating if needed) the journal at PATH and recover the records already in it.
+     * Returns false and sets error() if the file cannot be opened or is not a journal.
+     */
+    bool open(const std::string &path);
+    void close();
+
+    /**
+     * Durably append RECORD (its crc is filled in). Returns false and sets error() on I/O
+     * failure.
+     */
+    bool append(MatchRecord record);
+
+    /**
+     * Return the recorded outcome of MATCH_ID, or nullptr if it has not been played. The
+     * pointer is invalidated by the next append.
+     */
+    const MatchRecord *find(uint64_t match_id) const;
+
+    /**
+     * True if MATCH_ID was already played with the same seed and the same two bots.
+     */
+    bool is_complete(uint64_t match_id, uint64_t seed, uint64_t bot_hash0, uint64_t bot_hash1) const;
+
+    size_t size() const { return this->count; }
+
+    /* Number of trailing records dropped on open because they failed their checksum. */
+    size_t discarded() const { return this->dropped; }
+
+    const std::string &error() const { return this->last_error; }
+
+   private:
+    bool fail(const char *what);
+    bool map(size_t capacity);
+    const MatchRecord *records() const;
+
+    int fd = -1;
+    unsigned char *base = nullptr;
+    size_t mapped_size = 0;
+    size_t count = 0;
+    size_t dropped = 0;
+    std::unordered_map<uint64_t, size_t> index;  // match_id -> record number
+    std::string last_error;
+};
+
+#endif
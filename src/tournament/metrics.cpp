@@ -0,0 +1,219 @@
+#include "metrics.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+
+namespace {
+
+constexpr char METRICS_MAGIC[8] = {'S', 'P', 'I', 'M', 'M', 'E', 'T', 'R'};
+constexpr uint32_t METRICS_VERSION = 1;
+
+constexpr size_t FIELDS = sizeof(WorkerMetrics) / sizeof(uint64_t);
+
+/* Attempts before read() gives up on a slot whose writer stopped mid-publish. */
+constexpr int READ_ATTEMPTS = 1000;
+
+struct MetricsHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t workers;
+    uint32_t slot_size;
+    unsigned char reserved[44];
+};
+static_assert(sizeof(MetricsHeader) == 64, "metrics header is fixed at 64 bytes");
+
+}  // namespace
+
+/* Odd SEQ means an update is in progress. The fields are atomics only so that the racing reads
+   of a sequence lock are defined; all accesses are relaxed. */
+struct alignas(64) MetricsSlot {
+    std::atomic<uint32_t> seq;
+    std::atomic<uint64_t> fields[FIELDS];
+};
+static_assert(sizeof(MetricsSlot) == 128, "metrics slots are fixed at 128 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+uint64_t metrics_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+MetricsWriter::MetricsWriter(MetricsSlot *slot) : slot(slot) {
+    this->local.started_ns = metrics_now_ns();
+    this->publish();
+}
+
+void MetricsWriter::start_match(uint64_t match_id) {
+    this->local.current_match = match_id;
+    this->publish();
+}
+
+void MetricsWriter::quantum(uint64_t instructions, uint64_t ns) {
+    this->local.instructions += instructions;
+    this->local.busy_ns += ns;
+    this->publish();
+}
+
+void MetricsWriter::bot_finished(uint64_t bot_hash, uint64_t instructions, uint64_t ns) {
+    if (instructions == 0) {
+        return;
+    }
+    uint64_t ps = ns * 1000 / instructions;
+    if (ps > this->local.slowest_ps) {
+        this->local.slowest_bot = bot_hash;
+        this->local.slowest_ps = ps;
+        this->publish();
+    }
+}
+
+void MetricsWriter::finish_match() {
+    ++this->local.matches;
+    this->local.current_match = 0;
+    this->publish();
+}
+
+void MetricsWriter::publish() {
+    if (this->slot == nullptr) {
+        return;
+    }
+    this->local.updated_ns = metrics_now_ns();
+
+    uint64_t values[FIELDS];
+    memcpy(values, &this->local, sizeof(values));
+
+    uint32_t seq = this->slot->seq.load(std::memory_order_relaxed);
+    this->slot->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < FIELDS; ++i) {
+        this->slot->fields[i].store(values[i], std::memory_order_relaxed);
+    }
+    this->slot->seq.store(seq + 2, std::memory_order_release);
+}
+
+TournamentMetrics::~TournamentMetrics() { close(); }
+
+bool TournamentMetrics::fail(const char *what) {
+    this->last_error = std::string(what) + ": " + strerror(errno);
+    return false;
+}
+
+bool TournamentMetrics::map(int fd, bool writable) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return fail("cannot stat metrics");
+    }
+    int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *addr = mmap(nullptr, st.st_size, prot, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return fail("cannot map metrics");
+    }
+    this->base = static_cast<unsigned char *>(addr);
+    this->mapped_size = st.st_size;
+    this->writable = writable;
+    return true;
+}
+
+bool TournamentMetrics::create(const std::string &name, uint32_t workers) {
+    close();
+    shm_unlink(name.c_str());
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1) {
+        return fail("cannot create metrics");
+    }
+    if (ftruncate(fd, sizeof(MetricsHeader) + workers * sizeof(MetricsSlot)) != 0) {
+        ::close(fd);
+        return fail("cannot size metrics");
+    }
+    if (!map(fd, true)) {
+        return false;
+    }
+
+    /* The new segment is zero-filled, which is every slot unused at sequence 0. */
+    MetricsHeader *header = reinterpret_cast<MetricsHeader *>(this->base);
+    memcpy(header->magic, METRICS_MAGIC, sizeof(METRICS_MAGIC));
+    header->version = METRICS_VERSION;
+    header->slot_size = sizeof(MetricsSlot);
+    header->workers = workers;
+    this->slot_count = workers;
+    return true;
+}
+
+bool TournamentMetrics::open(const std::string &name, bool writable) {
+    close();
+
+    int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+    if (fd == -1) {
+        return fail("cannot open metrics");
+    }
+    if (!map(fd, writable)) {
+        return false;
+    }
+
+    const MetricsHeader *header = reinterpret_cast<const MetricsHeader *>(this->base);
+    if (this->mapped_size < sizeof(MetricsHeader) ||
+        memcmp(header->magic, METRICS_MAGIC, sizeof(METRICS_MAGIC)) != 0 || header->version != METRICS_VERSION ||
+        header->slot_size != sizeof(MetricsSlot) ||
+        this->mapped_size < sizeof(MetricsHeader) + header->workers * sizeof(MetricsSlot)) {
+        close();
+        this->last_error = name + " is not a version " + std::to_string(METRICS_VERSION) + " metrics segment";
+        return false;
+    }
+    this->slot_count = header->workers;
+    return true;
+}
+
+void TournamentMetrics::close() {
+    if (this->base != nullptr) {
+        munmap(this->base, this->mapped_size);
+        this->base = nullptr;
+    }
+    this->mapped_size = 0;
+    this->slot_count = 0;
+    this->writable = false;
+}
+
+bool TournamentMetrics::unlink(const std::string &name) { return shm_unlink(name.c_str()) == 0; }
+
+MetricsWriter TournamentMetrics::writer(uint32_t worker) {
+    if (!this->writable || worker >= this->slot_count) {
+        return MetricsWriter();
+    }
+    return MetricsWriter(reinterpret_cast<MetricsSlot *>(this->base + sizeof(MetricsHeader)) + worker);
+}
+
+bool TournamentMetrics::read(uint32_t worker, WorkerMetrics &out) const {
+    if (worker >= this->slot_count) {
+        return false;
+    }
+    const MetricsSlot *slot = reinterpret_cast<const MetricsSlot *>(this->base + sizeof(MetricsHeader)) + worker;
+
+    uint64_t values[FIELDS];
+    for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+        uint32_t before = slot->seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            sched_yield();
+            continue;
+        }
+        for (size_t i = 0; i < FIELDS; ++i) {
+            values[i] = slot->fields[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == before) {
+            memcpy(&out, values, sizeof(out));
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,115 @@
+/**
+ * Live metrics for a tournament run, published through POSIX shared memory.
+ *
+ * The runner creates a segment with one slot per worker before starting its workers (forked
+ * workers inherit the mapping). Each worker writes only its own slot, at quantum boundaries:
+ * counters go into a private copy and are then published under a per-slot sequence lock, so a
+ * worker never takes a lock, makes a system call or shares a cache line with another worker.
+ * Readers such as tools/spimbot_metrics map the segment read-only, copy a slot and retry if its
+ * sequence number moved underneath them.
+ *
+ * Layout: a 64-byte header followed by 128-byte slots, one per worker. Everything is cumulative
+ * since the worker started, so rates are the difference of two reads.
+ */
+
+#pragma once
+
+#ifndef TOURNAMENT_METRICS_H_
+#define TOURNAMENT_METRICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+struct MetricsSlot;
+
+/* One worker's counters as published. */
+struct WorkerMetrics {
+    uint64_t started_ns;     // CLOCK_MONOTONIC when the worker took its slot, 0 if unused
+    uint64_t updated_ns;     // CLOCK_MONOTONIC of the last publish
+    uint64_t instructions;   // Guest instructions executed
+    uint64_t busy_ns;        // Host time spent running guests
+    uint64_t matches;        // Matches completed
+    uint64_t current_match;  // match_id being played, 0 between matches
+    uint64_t slowest_bot;    // bot_hash of the slowest bot this worker has run
+    uint64_t slowest_ps;     // Its host picoseconds per guest instruction
+};
+static_assert(sizeof(WorkerMetrics) == 64, "worker metrics are eight u64s");
+
+/* Publishes one worker's metrics. A default-constructed writer ignores every call. */
+class MetricsWriter {
+   public:
+    MetricsWriter() = default;
+
+    void start_match(uint64_t match_id);
+
+    /* At the end of a quantum: INSTRUCTIONS guest instructions run in NS host nanoseconds. */
+    void quantum(uint64_t instructions, uint64_t ns);
+
+    /* BOT_HASH ran INSTRUCTIONS instructions in NS nanoseconds over the match just played. */
+    void bot_finished(uint64_t bot_hash, uint64_t instructions, uint64_t ns);
+
+    void finish_match();
+
+   private:
+    friend class TournamentMetrics;
+    explicit MetricsWriter(MetricsSlot *slot);
+
+    void publish();
+
+    MetricsSlot *slot = nullptr;
+    WorkerMetrics local = {};
+};
+
+class TournamentMetrics {
+   public:
+    TournamentMetrics() = default;
+    ~TournamentMetrics();
+
+    TournamentMetrics(const TournamentMetrics &) = delete;
+    TournamentMetrics &operator=(const TournamentMetrics &) = delete;
+
+    /**
+     * Create the shared-memory segment NAME (such as "/spimbot-metrics"), replacing any left over
+     * from an earlier run, with room for WORKERS workers. Returns false and sets error() on
+     * failure.
+     */
+    bool create(const std::string &name, uint32_t workers);
+
+    /* Map the existing segment NAME, read-only unless WRITABLE. */
+    bool open(const std::string &name, bool writable = false);
+    void close();
+
+    /* Remove the segment NAME; existing mappings stay valid. */
+    static bool unlink(const std::string &name);
+
+    uint32_t workers() const { return this->slot_count; }
+
+    /* Claim WORKER's slot for publishing, resetting its counters. The writer is inactive if
+       WORKER is out of range or the segment is mapped read-only. */
+    MetricsWriter writer(uint32_t worker);
+
+    /**
+     * Copy WORKER's counters consistently into OUT. False if WORKER is out of range or its
+     * worker died part-way through publishing.
+     */
+    bool read(uint32_t worker, WorkerMetrics &out) const;
+
+    const std::string &error() const { return this->last_error; }
+
+   private:
+    bool fail(const char *what);
+    bool map(int fd, bool writable);
+
+    unsigned char *base = nullptr;
+    size_t mapped_size = 0;
+    bool writable = false;
+    uint32_t slot_count = 0;
+    std::string last_error;
+};
+
+/* CLOCK_MONOTONIC in nanoseconds, the clock of WorkerMetrics' timestamps. */
+uint64_t metrics_now_ns();
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * Small, dependency-free hashes used to identify and checksum on-disk data (journals, image
+ * caches). None of these are cryptographic.
+ */
+
+#pragma once
+
+#ifndef UTIL_HASH_H_
+#define UTIL_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <string_view>
+
+namespace util {
+
+constexpr uint64_t FNV1A_64_OFFSET = 0xcbf29ce484222325ull;
+constexpr uint64_t FNV1A_64_PRIME = 0x100000001b3ull;
+
+/**
+ * 64-bit FNV-1a. Pass the previous result as SEED to hash data that arrives in pieces. Use the
+ * string_view overload in constant expressions.
+ */
+inline uint64_t fnv1a_64(const void *data, size_t size, uint64_t seed = FNV1A_64_OFFSET) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+}
+
+constexpr uint64_t fnv1a_64(std::string_view str, uint64_t seed = FNV1A_64_OFFSET) {
+    uint64_t hash = seed;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+}
+
+namespace detail {
+
+constexpr std::array<uint32_t, 256> make_crc32_table() {
+    std::array<uint32_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC32_TABLE = make_crc32_table();
+
+}  // namespace detail
+
+/**
+ * CRC-32 (IEEE 802.3, as used by zlib). Pass the previous result as CRC to continue a checksum.
+ */
+inline uint32_t crc32(const void *data, size_t size, uint32_t crc = 0) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = detail::CRC32_TABLE[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+}  // namespace util
+
+#endif
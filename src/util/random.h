@@ -0,0 +1,141 @@
+/**
+ * Counter-based random numbers for game logic.
+ *
+ * A counter-based generator is a keyed bijection: random block = philox(counter, key). There is
+ * no hidden state to advance, so the value drawn for (match seed, bot, event) is the same no
+ * matter which worker thread runs the match, in which order matches run, or whether we are
+ * replaying it. Generators are a few words on the stack, need no locking and never allocate.
+ *
+ * Uses Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11).
+ * MatchRng also models UniformRandomBitGenerator, so it can drive std:: or Boost.Random
+ * distributions.
+ */
+
+#pragma once
+
+#ifndef UTIL_RANDOM_H_
+#define UTIL_RANDOM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <limits>
+
+namespace util {
+
+using philox_ctr = std::array<uint32_t, 4>;
+using philox_key = std::array<uint32_t, 2>;
+
+namespace detail {
+
+constexpr uint32_t PHILOX_M0 = 0xd2511f53;
+constexpr uint32_t PHILOX_M1 = 0xcd9e8d57;
+constexpr uint32_t PHILOX_W0 = 0x9e3779b9;
+constexpr uint32_t PHILOX_W1 = 0xbb67ae85;
+
+constexpr philox_ctr philox_round(philox_ctr ctr, philox_key key) {
+    uint64_t p0 = uint64_t(PHILOX_M0) * ctr[0];
+    uint64_t p1 = uint64_t(PHILOX_M1) * ctr[2];
+    return {uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1), uint32_t(p0 >> 32) ^ ctr[3] ^ key[1],
+            uint32_t(p0)};
+}
+
+}  // namespace detail
+
+/**
+ * Philox4x32 with 10 rounds: maps a 128-bit counter to 128 random bits under a 64-bit key.
+ */
+constexpr philox_ctr philox4x32(philox_ctr ctr, philox_key key) {
+    for (int round = 0; round < 10; ++round) {
+        if (round != 0) {
+            key[0] += detail::PHILOX_W0;
+            key[1] += detail::PHILOX_W1;
+        }
+        ctr = detail::philox_round(ctr, key);
+    }
+    return ctr;
+}
+
+/**
+ * Random stream for one purpose (STREAM) of one bot (BOT_ID) in one match (MATCH_SEED).
+ *
+ * Word i of the stream is a pure function of (match_seed, bot_id, stream, i), available in
+ * O(1) through at(i). operator() walks the stream sequentially from position(). Use a distinct
+ * stream number for each independent use (map generation, spawns, ...) so adding draws to one
+ * never shifts another.
+ */
+class MatchRng {
+   public:
+    using result_type = uint32_t;
+
+    constexpr MatchRng(uint64_t match_seed, uint32_t bot_id, uint32_t stream = 0)
+        : key{uint32_t(match_seed), uint32_t(match_seed >> 32)}, bot_id(bot_id), stream(stream) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /* The four words of block BLOCK, i.e. words 4*BLOCK .. 4*BLOCK+3. */
+    constexpr philox_ctr block(uint64_t block) const {
+        return philox4x32({uint32_t(block), uint32_t(block >> 32), this->bot_id, this->stream},
+                          this->key);
+    }
+
+    /* Word INDEX of the stream (e.g. the cycle or event number). */
+    constexpr result_type at(uint64_t index) const { return block(index >> 2)[index & 3]; }
+
+    /* Uniform double in [0, 1) built from words 2*INDEX and 2*INDEX+1. */
+    constexpr double uniform(uint64_t index) const {
+        philox_ctr words = block(index >> 1);
+        size_t lane = (index & 1) * 2;
+        uint64_t bits = (uint64_t(words[lane]) << 21) ^ (words[lane + 1] >> 11);
+        return double(bits & ((uint64_t(1) << 53) - 1)) * (1.0 / 9007199254740992.0);
+    }
+
+    /* Uniform integer in [0, BOUND) from word INDEX (Lemire's multiply-shift; BOUND > 0). */
+    constexpr uint32_t below(uint64_t index, uint32_t bound) const {
+        return uint32_t((uint64_t(at(index)) * bound) >> 32);
+    }
+
+    /**
+     * Write blocks FIRST .. FIRST+COUNT-1 to OUT (4 * COUNT words). The loop body has no
+     * cross-iteration dependence, so the compiler is free to vectorize it.
+     */
+    void fill(uint64_t first, uint32_t *out, size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            philox_ctr words = block(first + i);
+            out[4 * i + 0] = words[0];
+            out[4 * i + 1] = words[1];
+            out[4 * i + 2] = words[2];
+            out[4 * i + 3] = words[3];
+        }
+    }
+
+    /* Sequential interface. */
+    constexpr result_type operator()() {
+        if ((this->next & 3) == 0) {
+            this->cached = block(this->next >> 2);
+        }
+        return this->cached[this->next++ & 3];
+    }
+
+    constexpr void seek(uint64_t index) {
+        this->next = index;
+        this->cached = block(index >> 2);
+    }
+
+    constexpr uint64_t position() const { return this->next; }
+
+    void discard(uint64_t count) { seek(this->next + count); }
+
+   private:
+    philox_key key;
+    uint32_t bot_id;
+    uint32_t stream;
+    uint64_t next = 0;
+    philox_ctr cached = {};
+};
+
+}  // namespace util
+
+#endif
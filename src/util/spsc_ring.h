@@ -0,0 +1,82 @@
+/**
+ * Bounded single-producer, single-consumer queue.
+ *
+ * One thread pushes and one other thread pops; neither ever blocks or takes a lock. The two
+ * indices live on separate cache lines, and each side keeps a private copy of the other's index
+ * so that it only touches the shared one when the ring looks full (producer) or looks to hold
+ * less than the batch asked for (consumer).
+ * Indices count up forever and are masked into the power-of-two buffer.
+ */
+
+#pragma once
+
+#ifndef UTIL_SPSC_RING_H_
+#define UTIL_SPSC_RING_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+namespace util {
+
+template <class T>
+class SpscRing {
+   public:
+    /* Room for at least CAPACITY items (rounded up to a power of two, at least 2). */
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        this->slots.resize(size);
+        this->mask = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return this->slots.size(); }
+
+    /* Producer only. False, leaving the ring unchanged, if it is full. */
+    bool try_push(const T &item) {
+        size_t head = this->head.load(std::memory_order_relaxed);
+        if (head - this->producer_tail == this->slots.size()) {
+            this->producer_tail = this->tail.load(std::memory_order_acquire);
+            if (head - this->producer_tail == this->slots.size()) {
+                return false;
+            }
+        }
+        this->slots[head & this->mask] = item;
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer only. Move up to MAX items into OUT, oldest first, and return how many. */
+    size_t pop(T *out, size_t max) {
+        size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (this->consumer_head - tail < max) {
+            this->consumer_head = this->head.load(std::memory_order_acquire);
+        }
+        size_t count = 0;
+        for (; count < max && tail != this->consumer_head; ++count, ++tail) {
+            out[count] = this->slots[tail & this->mask];
+        }
+        this->tail.store(tail, std::memory_order_release);
+        return count;
+    }
+
+   private:
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head{0}; /* Next slot to write */
+    size_t producer_tail = 0;                /* Producer's last view of TAIL */
+
+    alignas(64) std::atomic<size_t> tail{0}; /* Next slot to read */
+    size_t consumer_head = 0;                /* Consumer's last view of HEAD */
+};
+
+}  // namespace util
+
+#endif
@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "grading/fork_server.h"
+
+/* Exit status is the submission's number; "throw" and "crash" misbehave. */
+static int grade_by_name(const std::string &submission) {
+    if (submission == "throw") {
+        throw std::runtime_error("bad submission");
+    }
+    if (submission == "crash") {
+        signal(SIGSEGV, SIG_DFL); /* Not Catch2's handler, which would report a failure */
+        raise(SIGSEGV);
+    }
+    return std::stoi(submission);
+}
+
+static std::string serve_lines(ForkServer &server, const std::string &input, int &failures) {
+    FILE *in = fmemopen(const_cast<char *>(input.data()), input.size(), "r");
+    char *output = nullptr;
+    size_t size = 0;
+    FILE *out = open_memstream(&output, &size);
+    failures = server.serve(in, out);
+    fclose(in);
+    fclose(out);
+    std::string text(output, size);
+    free(output);
+    return text;
+}
+
+TEST_CASE("Fork server reports each child's outcome", "[grading][fork_server]") {
+    ForkServer server(grade_by_name);
+
+    GradingResult ok = server.grade("0");
+    REQUIRE(ok.submission == "0");
+    REQUIRE(ok.exit_status == 0);
+
+    GradingResult failed = server.grade("3");
+    REQUIRE(failed.exit_status == 3);
+
+    GradingResult crashed = server.grade("crash");
+    REQUIRE(crashed.term_signal == SIGSEGV);
+    REQUIRE_FALSE(crashed.timed_out);
+}
+
+TEST_CASE("Fork server children do not outlive a throwing grader", "[grading][fork_server]") {
+    ForkServer server(grade_by_name, 2);
+
+    int failures = 0;
+    std::string output = serve_lines(server, "throw\n0\n", failures);
+
+    /* One line per submission: the throwing child exited instead of serving the rest itself. */
+    REQUIRE(failures == 1);
+    REQUIRE(output.find("throw\texit 1\t") != std::string::npos);
+    REQUIRE(output.find("0\texit 0\t") != std::string::npos);
+    REQUIRE(std::count(output.begin(), output.end(), '\n') == 2);
+}
+
+TEST_CASE("Fork server leaves the caller's other children alone", "[grading][fork_server]") {
+    pid_t other = fork();
+    if (other == 0) {
+        _exit(42);
+    }
+    REQUIRE(other > 0);
+
+    ForkServer server([](const std::string &) {
+        usleep(50000);
+        return 0;
+    }, 2);
+    int failures = 0;
+    std::string output = serve_lines(server, "a\nb\n", failures);
+    REQUIRE(failures == 0);
+    REQUIRE(std::count(output.begin(), output.end(), '\n') == 2);
+
+    int status = 0;
+    REQUIRE(waitpid(other, &status, 0) == other);
+    REQUIRE(WEXITSTATUS(status) == 42);
+}
+
+TEST_CASE("Fork server reports results in completion order", "[grading][fork_server]") {
+    ForkServer server([](const std::string &submission) {
+        usleep(submission == "slow" ? 300000 : 10000);
+        return 0;
+    }, 2);
+    int failures = 0;
+    std::string output = serve_lines(server, "slow\nfast\n", failures);
+    REQUIRE(failures == 0);
+    REQUIRE(output.rfind("fast\texit 0\t", 0) == 0);
+    REQUIRE(output.find("slow\texit 0\t") != std::string::npos);
+}
+
+TEST_CASE("Fork server says when a child's status was lost", "[grading][fork_server]") {
+    /* With SIGCHLD ignored the kernel reaps children itself, and waitpid fails with ECHILD. */
+    signal(SIGCHLD, SIG_IGN);
+    ForkServer server(grade_by_name);
+    GradingResult result = server.grade("0");
+    signal(SIGCHLD, SIG_DFL);
+
+    REQUIRE(result.status_lost);
+    REQUIRE_FALSE(result.fork_failed);
+    REQUIRE(result.exit_status == -1);
+}
@@ -0,0 +1,74 @@
+#ifndef TEST_MIPS_H
+#define TEST_MIPS_H
+
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "controllers/mips/config.h"
+#include "controllers/mips/spim.h"
+
+/* QtSpimbot's default machine, without console output. */
+inline CPUConfig test_cpu_config() {
+    CPUConfig config = {};
+    config.memory.text_size = TEXT_SIZE;
+    config.memory.data_size = DATA_SIZE;
+    config.memory.stack_size = STACK_SIZE;
+    config.memory.k_text_size = K_TEXT_SIZE;
+    config.memory.k_data_size = K_DATA_SIZE;
+    config.memory.data_limit = DATA_LIMIT;
+    config.memory.stack_limit = STACK_LIMIT;
+    config.memory.k_data_limit = K_DATA_LIMIT;
+    config.accept_pseudo_insts = true;
+    config.mapped_io = true;
+    config.quiet = true;
+    return config;
+}
+
+/* Write SIZE bytes at DATA to a fresh temporary file and return its path. */
+inline std::string temp_file(const void *data, size_t size) {
+    char path[] = "/tmp/spimbot_mips_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd != -1);
+    REQUIRE(write(fd, data, size) == (ssize_t)size);
+    close(fd);
+    return path;
+}
+
+inline std::string temp_file(const std::string &text) { return temp_file(text.data(), text.size()); }
+
+/* The contents of the file at PATH. */
+inline std::string read_file(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    REQUIRE(file != nullptr);
+    std::string bytes;
+    char buffer[4096];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) != 0;) {
+        bytes.append(buffer, n);
+    }
+    fclose(file);
+    return bytes;
+}
+
+/* Everything WRITE(FILE *) prints, as a string. */
+template <typename F>
+std::string capture_output(F &&write) {
+    FILE *out = tmpfile();
+    REQUIRE(out != nullptr);
+    write(out);
+    rewind(out);
+
+    std::string text;
+    char buffer[4096];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), out)) != 0;) {
+        text.append(buffer, n);
+    }
+    fclose(out);
+    return text;
+}
+
+#endif
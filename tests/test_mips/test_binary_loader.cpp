@@ -0,0 +1,255 @@
+#include <catch2/catch.hpp>
+
+#include <elf.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "controllers/mips/binary_loader.h"
+#include "mips_test.h"
+
+static const std::vector<int32_t> CODE = {
+    0x20020005, /* addi $v0, $zero, 5 */
+    0x03e00008, /* jr $ra */
+    0x00000000, /* nop */
+};
+static const std::vector<int32_t> DATA = {42, -1};
+
+template <typename T>
+static void put(std::string &file, size_t offset, const T &value) {
+    if (file.size() < offset + sizeof(T)) {
+        file.resize(offset + sizeof(T), '\0');
+    }
+    memcpy(&file[offset], &value, sizeof(T));
+}
+
+static void put_words(std::string &file, size_t offset, const std::vector<int32_t> &words) {
+    for (size_t i = 0; i < words.size(); ++i) {
+        put(file, offset + i * sizeof(int32_t), words[i]);
+    }
+}
+
+/* A little ELF32 MIPS executable: CODE at TEXT_BOT, DATA at DATA_BOT, and a .symtab naming
+   `main` (the entry point), `table` and `_gp`. Tests corrupt fields of the result. */
+struct test_elf {
+    static constexpr size_t PHDRS = sizeof(Elf32_Ehdr);
+    static constexpr size_t TEXT = 0x80;
+    static constexpr size_t DATA = 0x100;
+    static constexpr size_t SYMTAB = 0x140;
+    static constexpr size_t STRTAB = 0x180;
+    static constexpr size_t SHDRS = 0x1a0;
+
+    std::string bytes;
+
+    Elf32_Ehdr &ehdr() { return *reinterpret_cast<Elf32_Ehdr *>(&bytes[0]); }
+    Elf32_Phdr &phdr(size_t i) { return *reinterpret_cast<Elf32_Phdr *>(&bytes[PHDRS + i * sizeof(Elf32_Phdr)]); }
+    Elf32_Shdr &shdr(size_t i) { return *reinterpret_cast<Elf32_Shdr *>(&bytes[SHDRS + i * sizeof(Elf32_Shdr)]); }
+
+    test_elf() {
+        static const char strings[] = "\0main\0table\0_gp";
+
+        Elf32_Ehdr eh = {};
+        memcpy(eh.e_ident, ELFMAG, SELFMAG);
+        eh.e_ident[EI_CLASS] = ELFCLASS32;
+        eh.e_ident[EI_DATA] = ELFDATA2LSB;
+        eh.e_ident[EI_VERSION] = EV_CURRENT;
+        eh.e_type = ET_EXEC;
+        eh.e_machine = EM_MIPS;
+        eh.e_version = EV_CURRENT;
+        eh.e_entry = TEXT_BOT;
+        eh.e_phoff = PHDRS;
+        eh.e_shoff = SHDRS;
+        eh.e_ehsize = sizeof(Elf32_Ehdr);
+        eh.e_phentsize = sizeof(Elf32_Phdr);
+        eh.e_phnum = 2;
+        eh.e_shentsize = sizeof(Elf32_Shdr);
+        eh.e_shnum = 3;
+        put(bytes, 0, eh);
+
+        Elf32_Phdr text = {};
+        text.p_type = PT_LOAD;
+        text.p_offset = TEXT;
+        text.p_vaddr = TEXT_BOT;
+        text.p_filesz = CODE.size() * sizeof(int32_t);
+        text.p_memsz = text.p_filesz;
+        put(bytes, PHDRS, text);
+        put_words(bytes, TEXT, CODE);
+
+        Elf32_Phdr data = {};
+        data.p_type = PT_LOAD;
+        data.p_offset = DATA;
+        data.p_vaddr = DATA_BOT;
+        data.p_filesz = ::DATA.size() * sizeof(int32_t);
+        data.p_memsz = 64; /* The rest is .bss */
+        put(bytes, PHDRS + sizeof(Elf32_Phdr), data);
+        put_words(bytes, DATA, ::DATA);
+
+        Elf32_Sym syms[4] = {};
+        syms[1].st_name = 1;
+        syms[1].st_value = TEXT_BOT;
+        syms[1].st_info = ELF32_ST_INFO(STB_GLOBAL, STT_FUNC);
+        syms[1].st_shndx = 1;
+        syms[2].st_name = 6;
+        syms[2].st_value = DATA_BOT + 4;
+        syms[2].st_info = ELF32_ST_INFO(STB_LOCAL, STT_OBJECT);
+        syms[2].st_shndx = 2;
+        syms[3].st_name = 12;
+        syms[3].st_value = DATA_BOT + 0x8000;
+        syms[3].st_info = ELF32_ST_INFO(STB_LOCAL, STT_NOTYPE);
+        syms[3].st_shndx = SHN_ABS;
+        put(bytes, SYMTAB, syms);
+        bytes.resize(STRTAB, '\0');
+        bytes.append(strings, sizeof(strings));
+
+        Elf32_Shdr sh[3] = {};
+        sh[1].sh_type = SHT_SYMTAB;
+        sh[1].sh_offset = SYMTAB;
+        sh[1].sh_size = sizeof(syms);
+        sh[1].sh_link = 2;
+        sh[1].sh_entsize = sizeof(Elf32_Sym);
+        sh[2].sh_type = SHT_STRTAB;
+        sh[2].sh_offset = STRTAB;
+        sh[2].sh_size = sizeof(strings);
+        put(bytes, SHDRS, sh);
+    }
+
+    std::shared_ptr<const program_image_t> load(const MemConfig &memory) const {
+        return BinaryLoader::load_elf(temp_file(bytes), memory);
+    }
+};
+
+static std::string words_file(size_t count) {
+    std::vector<int32_t> words(count, 0);
+    return temp_file(words.data(), words.size() * sizeof(int32_t));
+}
+
+TEST_CASE("Load an ELF executable", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    auto image = test_elf().load(memory);
+    REQUIRE(image != nullptr);
+
+    REQUIRE(image->text_seg.size() == TEXT_SIZE / BYTES_PER_WORD);
+    for (size_t i = 0; i < CODE.size(); ++i) {
+        REQUIRE(image->text_seg[i] != nullptr);
+        CHECK(image->text_seg[i]->ENCODING() == CODE[i]);
+    }
+    CHECK(image->text_seg[CODE.size()] == nullptr);
+    CHECK(image->next_text_pc == TEXT_BOT + CODE.size() * BYTES_PER_WORD);
+
+    CHECK(image->data_seg[0] == 42);
+    CHECK(image->data_seg[1] == -1);
+    CHECK(image->data_seg[2] == 0);
+    CHECK(image->next_data_pc == DATA_BOT + 64);
+
+    CHECK(image->gp_midpoint == DATA_BOT + 0x8000);
+    CHECK(image->symbol_table->find_symbol_address("main") == TEXT_BOT);
+    CHECK(image->symbol_table->find_symbol_address("table") == DATA_BOT + 4);
+    CHECK(image->symbol_table->find_symbol_address(DEFAULT_RUN_LOCATION) == TEXT_BOT);
+    CHECK(image->symbol_table->label_is_defined("main")->global_flag);
+    CHECK_FALSE(image->symbol_table->label_is_defined("table")->global_flag);
+    CHECK(image->symbol_table->label_is_defined("_gp")->const_flag);
+}
+
+TEST_CASE("Reject malformed ELF files", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    test_elf elf;
+
+    SECTION("Not ELF") { elf.bytes[1] = 'X'; }
+    SECTION("64-bit") { elf.bytes[EI_CLASS] = ELFCLASS64; }
+    SECTION("Big-endian") { elf.bytes[EI_DATA] = ELFDATA2MSB; }
+    SECTION("Not an executable") { elf.ehdr().e_type = ET_REL; }
+    SECTION("Wrong machine") { elf.ehdr().e_machine = EM_386; }
+    SECTION("Odd program header size") { elf.ehdr().e_phentsize = sizeof(Elf32_Phdr) + 4; }
+    SECTION("Program headers past the end") { elf.ehdr().e_phnum = 1000; }
+    SECTION("Program header table offset past the end") { elf.ehdr().e_phoff = 0xfffffff0; }
+    SECTION("Segment contents past the end") { elf.phdr(0).p_filesz = 0x10000; }
+    SECTION("Segment offset overflows") { elf.phdr(1).p_offset = 0xfffffffc; }
+    SECTION("Unaligned segment") { elf.phdr(0).p_vaddr = TEXT_BOT + 2; }
+    SECTION("File size beyond memory size") { elf.phdr(1).p_memsz = 4; }
+    SECTION("Below the text segment") { elf.phdr(0).p_vaddr = TEXT_BOT - 0x1000; }
+    SECTION("Section headers past the end") { elf.ehdr().e_shnum = 1000; }
+    SECTION("Odd section header size") { elf.ehdr().e_shentsize = sizeof(Elf32_Shdr) + 4; }
+    SECTION("Unterminated string table") { elf.bytes[test_elf::STRTAB + elf.shdr(2).sh_size - 1] = 'p'; }
+    SECTION("Symbol table past the end") { elf.shdr(1).sh_size = 0x100000; }
+
+    CHECK(elf.load(memory) == nullptr);
+}
+
+TEST_CASE("ELF segments are capped at the configured memory", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    test_elf elf;
+
+    SECTION("Text fills the text segment") {
+        elf.phdr(0).p_memsz = memory.text_size;
+        CHECK(elf.load(memory) != nullptr);
+    }
+    SECTION("Text beyond the text segment") {
+        elf.phdr(0).p_memsz = memory.text_size + BYTES_PER_WORD;
+        CHECK(elf.load(memory) == nullptr);
+    }
+    SECTION("Text starting past the text segment") {
+        elf.phdr(0).p_vaddr = TEXT_BOT + memory.text_size;
+        CHECK(elf.load(memory) == nullptr);
+    }
+    SECTION("Data beyond the data limit") {
+        memory.data_limit = memory.data_size;
+        elf.phdr(1).p_memsz = memory.data_limit + BYTES_PER_WORD;
+        CHECK(elf.load(memory) == nullptr);
+    }
+    SECTION("Data reaching the data limit") {
+        memory.data_limit = memory.data_size;
+        elf.phdr(1).p_memsz = memory.data_limit;
+        CHECK(elf.load(memory) != nullptr);
+    }
+    SECTION("Kernel data beyond its limit") {
+        elf.phdr(1).p_vaddr = K_DATA_BOT + memory.k_data_limit - 4;
+        CHECK(elf.load(memory) == nullptr);
+    }
+}
+
+TEST_CASE("Load raw word images", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    BinaryLoader::raw_paths paths;
+    paths.text = temp_file(CODE.data(), CODE.size() * sizeof(int32_t));
+    paths.data = temp_file(DATA.data(), DATA.size() * sizeof(int32_t));
+
+    auto image = BinaryLoader::load_raw(paths, memory);
+    REQUIRE(image != nullptr);
+    REQUIRE(image->text_seg[1] != nullptr);
+    CHECK(image->text_seg[1]->ENCODING() == CODE[1]);
+    CHECK(image->data_seg[0] == 42);
+    CHECK(image->k_text_seg.size() == K_TEXT_SIZE / BYTES_PER_WORD);
+    CHECK(image->next_k_text_pc == K_TEXT_BOT);
+    CHECK(image->symbol_table->find_symbol_address(DEFAULT_RUN_LOCATION) == TEXT_BOT);
+}
+
+TEST_CASE("Reject raw images that do not fit", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    BinaryLoader::raw_paths paths;
+
+    SECTION("Missing file") { paths.text = "/nonexistent/spimbot.bin"; }
+    SECTION("Partial word") { paths.data = temp_file("abcdef"); }
+    SECTION("Text beyond the text segment") { paths.text = words_file(memory.text_size / BYTES_PER_WORD + 1); }
+    SECTION("Kernel text beyond its segment") {
+        paths.k_text = words_file(memory.k_text_size / BYTES_PER_WORD + 1);
+    }
+    SECTION("Kernel data beyond its limit") {
+        memory.k_data_limit = memory.k_data_size;
+        paths.k_data = words_file(memory.k_data_limit / BYTES_PER_WORD + 1);
+    }
+
+    CHECK(BinaryLoader::load_raw(paths, memory) == nullptr);
+}
+
+TEST_CASE("Raw images may fill their segments", "[mips][binary_loader]") {
+    MemConfig memory = test_cpu_config().memory;
+    BinaryLoader::raw_paths paths;
+    paths.text = words_file(memory.text_size / BYTES_PER_WORD);
+    paths.k_data = words_file(memory.k_data_size / BYTES_PER_WORD + 1); /* Grows towards its limit */
+
+    auto image = BinaryLoader::load_raw(paths, memory);
+    REQUIRE(image != nullptr);
+    CHECK(image->text_seg.size() == size_t(memory.text_size / BYTES_PER_WORD));
+    CHECK(image->k_data_seg.size() == size_t(memory.k_data_size / BYTES_PER_WORD + 1));
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "controllers/mips/block_profile.h"
+#include "mips_test.h"
+
+/* A ten-iteration loop at 0x00400000 whose second instruction takes one exception, then a jr out:
+ *
+ *   0x00400000  ...
+ *   0x00400004  ...               <- interrupted once; the handler at 0x80000180 erets back here
+ *   0x00400008  bne ..., 0x00400000
+ *   0x0040000c  ...
+ *   0x00400010  jr  (to 0x00400020)
+ */
+static block_profile_t loop_profile() {
+    block_profile_t profile;
+    profile.reset(0x00400000, 64, 0x80000000, 16);
+    profile.transfer(0, 0x00400000, profile_edge_t::ENTRY);
+    for (int i = 0; i < 10; ++i) {
+        profile.branch(0x00400008, 0x00400000, i < 9);
+    }
+    profile.transfer(0x00400004, 0x80000180, profile_edge_t::EXCEPTION);
+    profile.transfer(0x80000190, 0x00400004, profile_edge_t::INDIRECT);
+    profile.transfer(0x00400010, 0x00400020, profile_edge_t::INDIRECT);
+    profile.sample(0x00400004);
+    profile.sample(0x00400004);
+    profile.sample(0x80000184);
+    return profile;
+}
+
+static std::string written_profile(const profile_data_t &data) {
+    std::string path = temp_file("");
+    REQUIRE(block_profile_t::write(path, data));
+    return path;
+}
+
+struct rendered_block_t {
+    mem_addr start;
+    mem_addr end; /* 0 for "-" */
+    unsigned long long entries;
+    unsigned long long instructions;
+};
+
+/* The "# blocks" section of render_text's output, in order. */
+static std::vector<rendered_block_t> rendered_blocks(const std::string &text) {
+    std::vector<rendered_block_t> blocks;
+    size_t line = text.find('\n') + 1; /* Past the heading */
+    while (line < text.size() && text[line] != '\n') {
+        rendered_block_t b = {0, 0, 0, 0};
+        int fields = sscanf(text.c_str() + line, "%x %x %llu %llu", &b.start, &b.end, &b.entries, &b.instructions);
+        if (fields == 1) {
+            REQUIRE(sscanf(text.c_str() + line, "%x - %llu", &b.start, &b.entries) == 2);
+        } else {
+            REQUIRE(fields == 4);
+        }
+        blocks.push_back(b);
+        line = text.find('\n', line) + 1;
+    }
+    return blocks;
+}
+
+TEST_CASE("Block profile: edges from branch sites and transfers", "[mips][block_profile]") {
+    profile_data_t data = loop_profile().data(false);
+
+    REQUIRE(data.edges.size() == 8);
+    CHECK(data.edges[0].from == 0);
+    CHECK(data.edges[0].kind == profile_edge_t::ENTRY);
+
+    /* Taken and fall-through edges of the bne, sorted by target */
+    CHECK(data.edges[3].from == 0x00400008);
+    CHECK(data.edges[3].to == 0x00400000);
+    CHECK(data.edges[3].count == 9);
+    CHECK(data.edges[4].to == 0x0040000c);
+    CHECK(data.edges[4].count == 1);
+
+    /* With delayed branches the fall-through skips the delay slot */
+    profile_data_t delayed = loop_profile().data(true);
+    CHECK(delayed.delayed_branches);
+    CHECK(delayed.edges[4].to == 0x00400010);
+}
+
+TEST_CASE("Block profile: write and read back", "[mips][block_profile]") {
+    profile_data_t data = loop_profile().data(true);
+    std::string path = written_profile(data);
+
+    profile_data_t read;
+    REQUIRE(block_profile_t::read(path, read));
+    unlink(path.c_str());
+
+    CHECK(read.delayed_branches);
+    REQUIRE(read.edges.size() == data.edges.size());
+    for (size_t i = 0; i < data.edges.size(); ++i) {
+        CHECK(read.edges[i].from == data.edges[i].from);
+        CHECK(read.edges[i].to == data.edges[i].to);
+        CHECK(read.edges[i].kind == data.edges[i].kind);
+        CHECK(read.edges[i].count == data.edges[i].count);
+    }
+}
+
+TEST_CASE("Block profile: corrupt files are rejected", "[mips][block_profile]") {
+    std::string path = written_profile(loop_profile().data(false));
+    std::string bytes = read_file(path);
+    unlink(path.c_str());
+
+    profile_data_t data;
+    SECTION("A flipped bit in a count") {
+        bytes[16 + 12] ^= 0x4;
+    }
+    SECTION("A flipped bit in the checksum") {
+        bytes.back() ^= 0x1;
+    }
+    SECTION("A truncated file") {
+        bytes.resize(bytes.size() - 5);
+    }
+    SECTION("Another file format") {
+        bytes[0] = 'X';
+    }
+    path = temp_file(bytes);
+    CHECK_FALSE(block_profile_t::read(path, data));
+    unlink(path.c_str());
+}
+
+TEST_CASE("Block profile: blocks rebuilt from edges", "[mips][block_profile]") {
+    profile_data_t data = loop_profile().data(false);
+    std::string text = capture_output([&](FILE *out) { block_profile_t::render_text(out, data); });
+
+    /* Hottest first. The exception splits the loop body at 0x00400004, whose block is entered
+       ten times by falling through and once by eret. */
+    std::vector<rendered_block_t> blocks = rendered_blocks(text);
+    REQUIRE(blocks.size() == 5);
+    CHECK(blocks[0].start == 0x00400004);
+    CHECK(blocks[0].end == 0x0040000c);
+    CHECK(blocks[0].entries == 11);
+    CHECK(blocks[0].instructions == 22);
+
+    CHECK(blocks[1].start == 0x00400000);
+    CHECK(blocks[1].end == 0x00400004);
+    CHECK(blocks[1].entries == 10);
+    CHECK(blocks[1].instructions == 10);
+
+    CHECK(blocks[2].start == 0x80000180);
+    CHECK(blocks[2].end == 0x80000194);
+    CHECK(blocks[2].instructions == 5);
+
+    CHECK(blocks[3].start == 0x0040000c);
+    CHECK(blocks[3].end == 0x00400014);
+    CHECK(blocks[3].entries == 1);
+
+    /* Nothing ends the jr's target, and it must not run on into kernel text */
+    CHECK(blocks[4].start == 0x00400020);
+    CHECK(blocks[4].end == 0);
+    CHECK(blocks[4].entries == 1);
+
+    CHECK(text.find("0x00400004            2  66.67%") != std::string::npos);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+
+#include <string>
+
+#include "controllers/mips/call_profile.h"
+#include "mips_test.h"
+
+constexpr mem_addr MAIN = 0x00400000;
+constexpr mem_addr F = 0x00400100;
+constexpr mem_addr G = 0x00400200;
+constexpr mem_addr HANDLER = 0x80000180;
+
+static symbolizer_t symbols() {
+    symbolizer_t symbols;
+    symbols.add(MAIN, "main");
+    symbols.add(F, "f");
+    symbols.add(G, "g");
+    symbols.add(HANDLER, "handler");
+    return symbols;
+}
+
+static std::string folded(call_profile_t &profile) {
+    return capture_output([&](FILE *out) { profile.write_folded(out, symbols()); });
+}
+
+static std::string summary(call_profile_t &profile) {
+    return capture_output([&](FILE *out) { profile.write_summary(out, symbols()); });
+}
+
+TEST_CASE("Call profile: symbolizer names addresses after labels", "[mips][call_profile]") {
+    symbolizer_t names = symbols();
+    names.add(F, "f_alias");
+    CHECK(names.name(F) == "f");
+    CHECK(names.name(F + 0x1c) == "f+0x1c");
+    CHECK(names.name(0x00100000) == "0x00100000");
+}
+
+TEST_CASE("Call profile: calls and returns", "[mips][call_profile]") {
+    call_profile_t profile;
+    profile.reset();
+    profile.enter(MAIN);
+    profile.clock = 5;
+    profile.call(F, MAIN + 8);
+    profile.clock = 9;
+    profile.jump_register(0x00400abc); /* Not a return; f keeps running */
+    profile.clock = 12;
+    profile.jump_register(MAIN + 8);
+    profile.clock = 20;
+
+    CHECK(folded(profile) == "main 13\nmain;f 7\n");
+}
+
+TEST_CASE("Call profile: a jump past several frames unwinds them all", "[mips][call_profile]") {
+    call_profile_t profile;
+    profile.reset();
+    profile.enter(MAIN);
+    profile.clock = 2;
+    profile.call(F, MAIN + 8);
+    profile.clock = 4;
+    profile.call(G, F + 8);
+    profile.clock = 10;
+    profile.jump_register(MAIN + 8); /* longjmp back into main */
+    profile.clock = 13;
+
+    CHECK(folded(profile) == "main 5\nmain;f 2\nmain;f;g 6\n");
+}
+
+TEST_CASE("Call profile: exceptions nest over the interrupted code", "[mips][call_profile]") {
+    call_profile_t profile;
+    profile.reset();
+    profile.enter(MAIN);
+    profile.clock = 3;
+    profile.call(F, MAIN + 8);
+    profile.clock = 4;
+    profile.exception(HANDLER);
+    profile.clock = 6;
+    profile.jump_register(MAIN + 8); /* A handler does not return with jr */
+    profile.clock = 10;
+    profile.exception_return();
+    profile.clock = 11;
+    profile.jump_register(MAIN + 8);
+    profile.clock = 12;
+
+    CHECK(folded(profile) == "main 4\nmain;f 2\nmain;f;handler 6\n");
+}
+
+TEST_CASE("Call profile: recursion counts towards the total once", "[mips][call_profile]") {
+    call_profile_t profile;
+    profile.reset();
+    profile.enter(MAIN);
+    profile.clock = 1;
+    profile.call(F, MAIN + 8);
+    profile.clock = 3;
+    profile.call(F, F + 0x10);
+    profile.clock = 6;
+    profile.call(F, F + 0x10);
+    profile.clock = 10;
+    profile.jump_register(F + 0x10);
+    profile.clock = 11;
+    profile.jump_register(F + 0x10);
+    profile.clock = 12;
+    profile.jump_register(MAIN + 8);
+    profile.clock = 14;
+
+    CHECK(folded(profile) == "main 3\nmain;f 3\nmain;f;f 4\nmain;f;f;f 4\n");
+    CHECK(summary(profile) ==
+          "function\taddress\tcalls\tself\ttotal\tself_percent\ttotal_percent\n"
+          "f\t0x00400100\t3\t11\t11\t78.57\t78.57\n"
+          "main\t0x00400000\t1\t3\t14\t21.43\t100.00\n");
+}
+
+TEST_CASE("Call profile: the stack stops growing at MAX_DEPTH", "[mips][call_profile]") {
+    call_profile_t profile;
+    profile.reset();
+    profile.enter(MAIN);
+    for (size_t i = 0; i < 2 * call_profile_t::MAX_DEPTH; ++i) {
+        profile.call(F, F + 8); /* jal used as a plain jump */
+    }
+    profile.clock = 1;
+
+    std::string text = summary(profile);
+    CHECK(text.find("f\t0x00400100\t2048\t1\t1\t") != std::string::npos);
+}
@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+
+#include <unistd.h>
+
+#include <string>
+
+#include "controllers/mips/cpu.h"
+#include "mips_test.h"
+
+static const char *PROGRAM =
+    ".text\n"
+    "main: addiu $t0, $t0, 1\n"
+    "      jr $ra\n";
+
+TEST_CASE("CPU memory: self-modifying stores decode in place", "[mips][cpu_mem]") {
+    std::string path = temp_file(PROGRAM);
+    CPU cpu(test_cpu_config());
+    REQUIRE(cpu.read_assembly_file(path.c_str(), path.c_str()));
+    unlink(path.c_str());
+
+    const text_segment_t &text = cpu.memory_image().text_seg;
+    size_t slot = 0;
+    while (slot < text.size() && text[slot] == nullptr) {
+        ++slot;
+    }
+    REQUIRE(slot < text.size());
+    mem_addr addr = TEXT_BOT + 4 * slot;
+    const instruction *inst = text[slot];
+
+    /* The first store may copy a shared segment; after that nothing more is allocated. */
+    cpu.set_mem_word(addr, 0);
+    size_t used = text.arena_bytes();
+    for (int i = 0; i < 10000; ++i) {
+        cpu.set_mem_byte(addr, i & 0xff);
+        cpu.set_mem_half(addr + 2, i & 0xffff);
+        cpu.set_mem_word(addr, 0x25080000 | i); /* addiu $t0, $t0, i */
+    }
+    CHECK(text.arena_bytes() == used);
+    CHECK(text[slot] == inst);
+    CHECK(text[slot]->ENCODING() == (0x25080000 | 9999));
+    CHECK(text[slot]->IMM() == 9999);
+}
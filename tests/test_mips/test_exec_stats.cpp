@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "controllers/mips/exec_stats.h"
+#include "mips_test.h"
+
+/* A stand-in for opcode_name that only knows two opcodes. */
+static const char *test_opcode_name(int opcode) {
+    switch (opcode) {
+        case 1:
+            return "addu";
+        case 2:
+            return "beq";
+        default:
+            return nullptr;
+    }
+}
+
+static std::string json_of(const exec_stats_t &stats, const std::vector<branch_site_t> &branches = {}) {
+    return capture_output([&](FILE *out) { stats.write_json(out, branches, test_opcode_name); });
+}
+
+TEST_CASE("Exec stats: nothing executed", "[mips][exec_stats]") {
+    exec_stats_t stats;
+    CHECK(json_of(stats) ==
+          "{\n"
+          "  \"instructions\": 0,\n"
+          "  \"opcodes\": {},\n"
+          "  \"loads\": {\"text\": 0, \"data\": 0, \"stack\": 0, \"k_text\": 0, \"k_data\": 0, \"special\": 0, "
+          "\"mmio\": 0, \"unmapped\": 0},\n"
+          "  \"stores\": {\"text\": 0, \"data\": 0, \"stack\": 0, \"k_text\": 0, \"k_data\": 0, \"special\": 0, "
+          "\"mmio\": 0, \"unmapped\": 0},\n"
+          "  \"branches\": []\n"
+          "}\n");
+}
+
+TEST_CASE("Exec stats: opcodes and memory segments", "[mips][exec_stats]") {
+    exec_stats_t stats;
+    for (int i = 0; i < 3; ++i) {
+        stats.instruction(1);
+    }
+    for (int i = 0; i < 5; ++i) {
+        stats.instruction(2);
+    }
+    stats.instruction(300); /* Unknown to the name table */
+    stats.instruction(-1);  /* Pseudo-ops never count */
+
+    stats.load(mem_segment_t::DATA);
+    stats.load(mem_segment_t::DATA);
+    stats.load(mem_segment_t::MMIO);
+    stats.store(mem_segment_t::STACK);
+    stats.store(mem_segment_t::UNMAPPED);
+
+    /* Most executed first; ties keep opcode order */
+    std::string json = json_of(stats);
+    CHECK(json.find("  \"instructions\": 9,\n"
+                    "  \"opcodes\": {\n"
+                    "    \"beq\": 5,\n"
+                    "    \"addu\": 3,\n"
+                    "    \"op300\": 1\n"
+                    "  },\n") != std::string::npos);
+    CHECK(json.find("  \"loads\": {\"text\": 0, \"data\": 2, \"stack\": 0, \"k_text\": 0, \"k_data\": 0, "
+                    "\"special\": 0, \"mmio\": 1, \"unmapped\": 0},\n") != std::string::npos);
+    CHECK(json.find("  \"stores\": {\"text\": 0, \"data\": 0, \"stack\": 1, \"k_text\": 0, \"k_data\": 0, "
+                    "\"special\": 0, \"mmio\": 0, \"unmapped\": 1},\n") != std::string::npos);
+
+    stats.reset();
+    CHECK(json_of(stats) == json_of(exec_stats_t()));
+}
+
+TEST_CASE("Exec stats: branch sites by outcome", "[mips][exec_stats]") {
+    exec_stats_t stats;
+    std::vector<branch_site_t> branches = {
+        {0x00400010, 0x00400000, 2, 1, 1},
+        {0x00400020, 0x00400040, 2, 90, 10},
+        {0x00400030, 0x00400000, -1, 0, 4}, /* Overwritten since it ran */
+    };
+
+    /* Busiest site first */
+    std::string json = json_of(stats, branches);
+    CHECK(json.find("  \"branches\": [\n"
+                    "    {\"pc\": \"0x00400020\", \"opcode\": \"beq\", \"target\": \"0x00400040\", \"taken\": 90, "
+                    "\"not_taken\": 10},\n"
+                    "    {\"pc\": \"0x00400030\", \"opcode\": \"?\", \"target\": \"0x00400000\", \"taken\": 0, "
+                    "\"not_taken\": 4},\n"
+                    "    {\"pc\": \"0x00400010\", \"opcode\": \"beq\", \"target\": \"0x00400000\", \"taken\": 1, "
+                    "\"not_taken\": 1}\n"
+                    "  ]\n"
+                    "}\n") != std::string::npos);
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "controllers/mips/exec_trace.h"
+#include "mips_test.h"
+
+/* The registers as the CPU holds them: 32 general registers, then HI and LO. */
+struct trace_regs_t {
+    int32_t r[exec_trace_t::REGS] = {};
+
+    int32_t hi() const { return this->r[exec_trace_t::REG_HI]; }
+    int32_t lo() const { return this->r[exec_trace_t::REG_LO]; }
+};
+
+/* Three instructions: one write, four writes (past the inline count) and a negative write after
+   a jump. */
+static std::string write_trace(trace_regs_t &regs) {
+    std::string path = temp_file("");
+    for (int r = 0; r < 32; ++r) {
+        regs.r[r] = 0x100 * r;
+    }
+    auto trace = exec_trace_t::open(path, regs.r, true);
+    REQUIRE(trace != nullptr);
+
+    trace->step(0x00400000, regs.r, regs.hi(), regs.lo());
+    regs.r[8] = 5;
+    trace->step(0x00400004, regs.r, regs.hi(), regs.lo());
+    regs.r[9] += 1;
+    regs.r[10] = -1;
+    regs.r[11] = 0x7fffffff;
+    regs.r[exec_trace_t::REG_HI] = 42;
+    trace->step(0x00400100, regs.r, regs.hi(), regs.lo());
+    regs.r[2] = -7;
+    REQUIRE(trace->close(regs.r, regs.hi(), regs.lo()));
+    return path;
+}
+
+static void check_write(const exec_step_t &step, size_t i, uint8_t reg, int32_t value) {
+    REQUIRE(i < step.writes);
+    CHECK(step.reg[i] == reg);
+    CHECK(step.value[i] == value);
+}
+
+TEST_CASE("Exec trace: read back what was written", "[mips][exec_trace]") {
+    trace_regs_t regs;
+    std::string path = write_trace(regs);
+
+    exec_trace_reader_t reader;
+    REQUIRE(reader.open(path));
+    CHECK(reader.delayed_branches());
+    CHECK(reader.registers()[9] == 0x900);
+
+    exec_step_t step;
+    REQUIRE(reader.next(step));
+    CHECK(step.pc == 0x00400000);
+    CHECK(step.writes == 1);
+    check_write(step, 0, 8, 5);
+
+    REQUIRE(reader.next(step));
+    CHECK(step.pc == 0x00400004);
+    CHECK(step.writes == 4);
+    check_write(step, 0, 9, 0x901);
+    check_write(step, 1, 10, -1);
+    check_write(step, 2, 11, 0x7fffffff);
+    check_write(step, 3, exec_trace_t::REG_HI, 42);
+
+    REQUIRE(reader.next(step));
+    CHECK(step.pc == 0x00400100);
+    CHECK(step.writes == 1);
+    check_write(step, 0, 2, -7);
+
+    CHECK_FALSE(reader.next(step));
+    for (size_t r = 0; r < exec_trace_t::REGS; ++r) {
+        CHECK(reader.registers()[r] == regs.r[r]);
+    }
+    unlink(path.c_str());
+}
+
+TEST_CASE("Exec trace: a truncated trace decodes up to its last complete record", "[mips][exec_trace]") {
+    trace_regs_t regs;
+    std::string path = write_trace(regs);
+    std::string bytes = read_file(path);
+    unlink(path.c_str());
+
+    /* Cut the last record short */
+    bytes.resize(bytes.size() - 1);
+    path = temp_file(bytes);
+
+    exec_trace_reader_t reader;
+    REQUIRE(reader.open(path));
+    exec_step_t step;
+    CHECK(reader.next(step));
+    CHECK(reader.next(step));
+    CHECK(step.pc == 0x00400004);
+    CHECK_FALSE(reader.next(step));
+    unlink(path.c_str());
+}
+
+TEST_CASE("Exec trace: other files are not traces", "[mips][exec_trace]") {
+    std::string path = temp_file("SPBP not a trace");
+    exec_trace_reader_t reader;
+    CHECK_FALSE(reader.open(path));
+    CHECK_FALSE(reader.open("/nonexistent/trace"));
+    unlink(path.c_str());
+}
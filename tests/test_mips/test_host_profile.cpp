@@ -0,0 +1,35 @@
+#include <catch2/catch.hpp>
+
+#include "controllers/mips/host_profile.h"
+#include "mips_test.h"
+
+TEST_CASE("Host profile: scopes publish their phase and guest PC together", "[mips][host_profile]") {
+    if (!SPIMBOT_PROFILING) {
+        return; /* Scopes compile to nothing */
+    }
+    mem_addr pc = 0x00400000;
+    {
+        /* Begun before sampling starts: stays inactive */
+        host_phase_scope before(host_phase_t::DISPATCH, &pc);
+        CHECK(host_thread_context == nullptr);
+    }
+
+    REQUIRE(host_profile::start(1));
+    {
+        host_phase_scope dispatch(host_phase_t::DISPATCH, &pc);
+        const host_context_t *outer = host_thread_context;
+        REQUIRE(outer != nullptr);
+        CHECK(outer->phase == host_phase_t::DISPATCH);
+        CHECK(outer->guest_pc == &pc);
+        {
+            /* Nested scopes keep the enclosing CPU's PC */
+            host_phase_scope memory(host_phase_t::MEMORY);
+            REQUIRE(host_thread_context != nullptr);
+            CHECK(host_thread_context->phase == host_phase_t::MEMORY);
+            CHECK(host_thread_context->guest_pc == &pc);
+        }
+        CHECK(host_thread_context == outer);
+    }
+    CHECK(host_thread_context == nullptr);
+    host_profile::stop();
+}
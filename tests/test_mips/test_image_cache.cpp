@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "controllers/mips/cpu.h"
+#include "controllers/mips/image_cache.h"
+#include "mips_test.h"
+
+static const char *PROGRAM =
+    ".data\n"
+    "value: .word 42\n"
+    ".text\n"
+    "main: la $t0, value\n"
+    "      lw $v0, 0($t0)\n"
+    "      jr $ra\n";
+
+static std::shared_ptr<const program_image_t> assemble(const std::string &path, const CPUConfig &config) {
+    CPU cpu(config);
+    REQUIRE(cpu.read_assembly_file(path.c_str(), path.c_str()));
+    auto image = cpu.share_program_image();
+    REQUIRE(image != nullptr);
+    return image;
+}
+
+static std::string cache_directory() {
+    char dir[] = "/tmp/spimbot_cache_XXXXXX";
+    REQUIRE(mkdtemp(dir) != nullptr);
+    return dir;
+}
+
+static std::string entry_path(const std::string &dir, uint64_t key) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.spimg", (unsigned long long)key);
+    return dir + "/" + name;
+}
+
+TEST_CASE("Image cache: a stored image loads back unchanged", "[mips][image_cache]") {
+    CPUConfig config = test_cpu_config();
+    std::string source = temp_file(PROGRAM);
+    std::string dir = cache_directory();
+    ImageCache cache(dir);
+
+    std::optional<uint64_t> key = ImageCache::key({source}, config);
+    REQUIRE(key.has_value());
+    REQUIRE(cache.load(*key) == nullptr);
+
+    auto image = assemble(source, config);
+    REQUIRE(cache.store(*key, *image));
+    auto cached = cache.load(*key);
+    REQUIRE(cached != nullptr);
+
+    REQUIRE(cached->text_top == image->text_top);
+    REQUIRE(cached->text_seg.size() == image->text_seg.size());
+    for (size_t i = 0; i < image->text_seg.size(); ++i) {
+        REQUIRE((cached->text_seg[i] == nullptr) == (image->text_seg[i] == nullptr));
+        if (image->text_seg[i] != nullptr) {
+            REQUIRE(cached->text_seg[i]->ENCODING() == image->text_seg[i]->ENCODING());
+        }
+    }
+    REQUIRE(cached->data_seg == image->data_seg);
+    REQUIRE(cached->k_data_seg == image->k_data_seg);
+    REQUIRE(cached->gp_midpoint == image->gp_midpoint);
+    REQUIRE(cached->symbol_table->find_symbol_address("main") ==
+            image->symbol_table->find_symbol_address("main"));
+    REQUIRE(cached->symbol_table->find_symbol_address("value") ==
+            image->symbol_table->find_symbol_address("value"));
+
+    unlink(entry_path(dir, *key).c_str());
+    rmdir(dir.c_str());
+    unlink(source.c_str());
+}
+
+TEST_CASE("Image cache: keys follow the sources and the assembler flags", "[mips][image_cache]") {
+    CPUConfig config = test_cpu_config();
+    std::string source = temp_file(PROGRAM);
+    std::string changed = temp_file(std::string(PROGRAM) + "      nop\n");
+
+    std::optional<uint64_t> key = ImageCache::key({source}, config);
+    REQUIRE(key.has_value());
+    REQUIRE(ImageCache::key({source}, config) == key);
+    REQUIRE(ImageCache::key({changed}, config) != key);
+    REQUIRE(ImageCache::key({source, changed}, config) != ImageCache::key({changed, source}, config));
+
+    CPUConfig delayed = config;
+    delayed.delayed_branches = true;
+    REQUIRE(ImageCache::key({source}, delayed) != key);
+    CPUConfig bare = config;
+    bare.bare_machine = true;
+    REQUIRE(ImageCache::key({source}, bare) != key);
+
+    REQUIRE_FALSE(ImageCache::key({"/nonexistent/bot.s"}, config).has_value());
+
+    /* A changed source misses even though an entry for the old one exists. */
+    std::string dir = cache_directory();
+    ImageCache cache(dir);
+    REQUIRE(cache.store(*key, *assemble(source, config)));
+    REQUIRE(cache.load(*ImageCache::key({changed}, config)) == nullptr);
+
+    unlink(entry_path(dir, *key).c_str());
+    rmdir(dir.c_str());
+    unlink(source.c_str());
+    unlink(changed.c_str());
+}
+
+TEST_CASE("Image cache: corrupt entries are misses", "[mips][image_cache]") {
+    CPUConfig config = test_cpu_config();
+    std::string source = temp_file(PROGRAM);
+    std::string dir = cache_directory();
+    ImageCache cache(dir);
+    uint64_t key = *ImageCache::key({source}, config);
+    REQUIRE(cache.store(key, *assemble(source, config)));
+    std::string path = entry_path(dir, key);
+
+    SECTION("Flipped payload byte") {
+        FILE *file = fopen(path.c_str(), "r+b");
+        REQUIRE(file != nullptr);
+        REQUIRE(fseek(file, -1, SEEK_END) == 0);
+        int c = fgetc(file);
+        REQUIRE(fseek(file, -1, SEEK_END) == 0);
+        fputc(c ^ 0xff, file);
+        fclose(file);
+        REQUIRE(cache.load(key) == nullptr);
+    }
+
+    SECTION("Truncated file") {
+        REQUIRE(truncate(path.c_str(), 40) == 0);
+        REQUIRE(cache.load(key) == nullptr);
+    }
+
+    SECTION("Entry stored under another key") {
+        std::string other = entry_path(dir, key + 1);
+        REQUIRE(rename(path.c_str(), other.c_str()) == 0);
+        REQUIRE(cache.load(key + 1) == nullptr);
+        path = other;
+    }
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+    unlink(source.c_str());
+}
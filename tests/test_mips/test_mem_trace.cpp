@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "controllers/mips/mem_trace.h"
+#include "mips_test.h"
+
+TEST_CASE("Memory trace: read back what was written", "[mips][mem_trace]") {
+    std::string path = temp_file("");
+    auto trace = mem_trace_t::open(path);
+    REQUIRE(trace != nullptr);
+
+    trace->clock = 1;
+    trace->record(0x00400000, 0x10010000, 4, 42, false);
+    trace->clock = 3;
+    trace->record(0x00400008, 0x10010004, 1, -1, true);
+    trace->record(0x00400008, 0x7fffeffc, 2, -32768, true);
+    REQUIRE(trace->close());
+
+    std::vector<mem_access_t> accesses;
+    uint64_t dropped = 1;
+    REQUIRE(mem_trace_t::read(path, accesses, dropped));
+    unlink(path.c_str());
+
+    CHECK(dropped == 0);
+    REQUIRE(accesses.size() == 3);
+    CHECK(accesses[0].cycle == 1);
+    CHECK(accesses[0].pc == 0x00400000);
+    CHECK(accesses[0].addr == 0x10010000);
+    CHECK(accesses[0].value == 42);
+    CHECK(accesses[0].size == 4);
+    CHECK_FALSE(accesses[0].store);
+
+    CHECK(accesses[1].cycle == 3);
+    CHECK(accesses[1].addr == 0x10010004);
+    CHECK(accesses[1].value == -1);
+    CHECK(accesses[1].size == 1);
+    CHECK(accesses[1].store);
+
+    CHECK(accesses[2].cycle == 3);
+    CHECK(accesses[2].addr == 0x7fffeffc);
+    CHECK(accesses[2].value == -32768);
+    CHECK(accesses[2].size == 2);
+    for (const mem_access_t &a : accesses) {
+        CHECK(a.gap == 0);
+    }
+}
+
+TEST_CASE("Memory trace: gaps mark where accesses were dropped", "[mips][mem_trace]") {
+    /* Far more accesses than a two-entry ring holds before the writer wakes up */
+    const uint64_t COUNT = 100000;
+    std::string path = temp_file("");
+    auto trace = mem_trace_t::open(path, 2);
+    REQUIRE(trace != nullptr);
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        trace->clock = i;
+        trace->record(0x00400000, 0x10010000 + 4 * (i % 16), 4, (int32_t)i, true);
+    }
+    REQUIRE(trace->close());
+
+    std::vector<mem_access_t> accesses;
+    uint64_t dropped = 0;
+    REQUIRE(mem_trace_t::read(path, accesses, dropped));
+    unlink(path.c_str());
+    CHECK(dropped > 0);
+
+    /* Every access is either in the trace or counted by the gap in its place */
+    uint64_t next = 0, gaps = 0;
+    for (const mem_access_t &a : accesses) {
+        REQUIRE(a.cycle == next);
+        if (a.gap != 0) {
+            gaps += a.gap;
+            next += a.gap;
+        } else {
+            CHECK(a.value == (int32_t)a.cycle);
+            ++next;
+        }
+    }
+    CHECK(next == COUNT);
+    CHECK(gaps == dropped);
+}
+
+TEST_CASE("Memory trace: other files are not traces", "[mips][mem_trace]") {
+    std::vector<mem_access_t> accesses;
+    uint64_t dropped;
+    std::string path = temp_file("SPMT");
+    CHECK_FALSE(mem_trace_t::read(path, accesses, dropped));
+    unlink(path.c_str());
+    CHECK_FALSE(mem_trace_t::read("/nonexistent/trace", accesses, dropped));
+}
@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "controllers/mips/sym-tbl.h"
+
+/* Each "file" defines the same local names and one new global, then flushes its locals. */
+static void assemble_files(SymbolTable &table, int files, int locals) {
+    for (int file = 0; file < files; ++file) {
+        for (int i = 0; i < locals; ++i) {
+            label *l = table.lookup_label("loop" + std::to_string(i));
+            REQUIRE(l->addr == 0);
+            l->addr = 0x00400000 + 4 * i;
+            table.record_local_label(l);
+        }
+        label *g = table.make_label_global("main" + std::to_string(file));
+        g->addr = 0x00400000 + 4 * file;
+        table.flush_local_labels(false);
+    }
+}
+
+TEST_CASE("Flushed locals do not hide later labels", "[mips][sym_tbl]") {
+    SymbolTable table;
+    assemble_files(table, 200, 100);
+
+    for (int file = 0; file < 200; ++file) {
+        REQUIRE(table.find_symbol_address("main" + std::to_string(file)) == 0x00400000u + 4 * file);
+    }
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(table.label_is_defined("loop" + std::to_string(i)) == nullptr);
+    }
+}
+
+TEST_CASE("A flushed local name can be defined again", "[mips][sym_tbl]") {
+    SymbolTable table;
+    assemble_files(table, 3, 1000);
+
+    label *l = table.lookup_label("loop7");
+    CHECK(l->addr == 0);
+    CHECK(table.label_is_defined("loop7") == l);
+    CHECK(table.find_symbol_address("main2") == 0x00400008u);
+}
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
 
 const std::unordered_map<std::string, uint32_t> variable_table = {
     {"a", 1},
@@ -20,6 +21,6 @@ const std::unordered_map<std::string, uint32_t> variable_table = {
     {"three", 3},
 };
 
-inline uint32_t lookup(const std::string& str) { return variable_table.at(str); }
+inline uint32_t lookup(std::string_view str) { return variable_table.at(std::string(str)); }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include "../test_parser.h"
+#include "parser/primitives/keywords.h"
+
+using mips_parser::directives;
+using mips_parser::opcodes;
+using mips_parser::registers;
+
+static_assert(opcodes.contains("add.d"), "constexpr opcode lookup");
+static_assert(registers.find("$ra")->number == 31, "constexpr register lookup");
+static_assert(directives.find(".word")->kind == mips_parser::DirectiveKind::WORD, "constexpr directive lookup");
+
+TEST_CASE("Keyword tables", "[parser][keywords]") {
+    SECTION("Every entry finds itself") {
+        for (const auto& op : opcodes) {
+            REQUIRE(opcodes.find(op.name) == &op);
+        }
+        for (const auto& reg : registers) {
+            REQUIRE(registers.find(reg.name) == &reg);
+        }
+        for (const auto& dir : directives) {
+            REQUIRE(directives.find(dir.name) == &dir);
+        }
+    }
+
+    SECTION("Misses") {
+        REQUIRE(opcodes.find("") == nullptr);
+        REQUIRE(opcodes.find("adds") == nullptr);
+        REQUIRE(opcodes.find("ADD") == nullptr);
+        REQUIRE(registers.find("$32") == nullptr);
+        REQUIRE(registers.find("$f32") == nullptr);
+        REQUIRE(registers.find("ra") == nullptr);
+        REQUIRE(directives.find("word") == nullptr);
+        REQUIRE(directives.find(".words") == nullptr);
+    }
+
+    SECTION("Floating point registers") {
+        REQUIRE(registers.find("$f30")->floating_point);
+        REQUIRE_FALSE(registers.find("$fp")->floating_point);
+        REQUIRE(registers.find("$fp")->number == 30);
+    }
+}
+
+TEST_CASE("Reserved words", "[parser][keywords]") {
+    using mips_parser::IDENT;
+    using mips_parser::RESERVED;
+
+    REQUIRE(test_parser("add", RESERVED));
+    REQUIRE(test_parser("add.d", RESERVED));
+    REQUIRE(test_parser(".word", RESERVED));
+    REQUIRE(test_parser("$sp", RESERVED));
+    REQUIRE_FALSE(test_parser("adds", RESERVED));
+    REQUIRE_FALSE(test_parser("main", RESERVED));
+
+    REQUIRE(test_parser("main", IDENT));
+    REQUIRE(test_parser("add_1", IDENT));
+    REQUIRE_FALSE(test_parser("add", IDENT));
+    REQUIRE_FALSE(test_parser("la", IDENT));
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "../table.h"
+#include "parser/rd/parser.h"
+
+using mips_parser::rd::Lexer;
+using mips_parser::rd::parse_expression;
+using mips_parser::rd::parse_program;
+using mips_parser::rd::syntax_error;
+using mips_parser::rd::TokenKind;
+
+static client::ast::evaluator<lookup> eval;
+
+static uint32_t eval_expr(char const* input) { return eval(parse_expression(input)); }
+
+TEST_CASE("RD: lexer", "[parser][rd][lexer]") {
+    SECTION("Keywords") {
+        Lexer lexer("add.d $f2, $fp .word abs $ras .wordy");
+        REQUIRE(lexer.next().kind == TokenKind::OPCODE);
+
+        auto fp = lexer.next();
+        REQUIRE(fp.kind == TokenKind::FP_REGISTER);
+        REQUIRE(fp.value == 2);
+        REQUIRE(lexer.next().kind == TokenKind::COMMA);
+
+        auto frame_pointer = lexer.next();
+        REQUIRE(frame_pointer.kind == TokenKind::REGISTER);
+        REQUIRE(frame_pointer.value == 30);
+
+        REQUIRE(lexer.next().kind == TokenKind::DIRECTIVE);
+        REQUIRE(lexer.next().kind == TokenKind::OPCODE);
+        REQUIRE(lexer.next().kind == TokenKind::IDENT);
+        REQUIRE(lexer.next().kind == TokenKind::ERROR);
+        REQUIRE(lexer.next().kind == TokenKind::END);
+    }
+
+    SECTION("Numbers") {
+        Lexer lexer("12 0x1F 0b101 1.5 1e-5 0x 4294967296");
+        REQUIRE(lexer.next().value == 12);
+        REQUIRE(lexer.next().value == 0x1f);
+        REQUIRE(lexer.next().value == 5);
+        REQUIRE(lexer.next().kind == TokenKind::REAL);
+        REQUIRE(lexer.next().kind == TokenKind::REAL);
+        REQUIRE(lexer.next().kind == TokenKind::ERROR);
+        REQUIRE(lexer.next().overflow);
+    }
+
+    SECTION("Comments and lines") {
+        Lexer lexer("a # one\n/* two\n three */ b // four\n");
+        auto a = lexer.next();
+        REQUIRE(a.line == 1);
+        REQUIRE(lexer.next().kind == TokenKind::NEWLINE);
+        auto b = lexer.next();
+        REQUIRE(b.text == "b");
+        REQUIRE(b.line == 3);
+        REQUIRE(lexer.next().kind == TokenKind::NEWLINE);
+        REQUIRE(lexer.next().kind == TokenKind::END);
+    }
+
+    SECTION("Strings") {
+        REQUIRE(client::ast::StringLiteral(R"("a\tb\"\\\101\x42\q")").decode() == "a\tb\"\\AB\\q");
+        REQUIRE(Lexer("\"abc").next().kind == TokenKind::ERROR);
+    }
+}
+
+TEST_CASE("RD: expression parsing", "[parser][rd][expressions]") {
+    SECTION("Constants") {
+        REQUIRE(eval_expr("1") == 1);
+        REQUIRE(eval_expr("20") == 20);
+        REQUIRE(eval_expr("a") == 1);
+        REQUIRE(eval_expr("a0") == 3);
+        REQUIRE(eval_expr("deadbeef") == 0xdeadbeef);
+        REQUIRE_NOTHROW(parse_expression("asda"));
+        REQUIRE_THROWS_AS(parse_expression("$a0"), syntax_error);
+    }
+
+    SECTION("Unary Operators") {
+        REQUIRE(eval_expr("- 0b111110000") == (uint32_t)-496);
+        REQUIRE(eval_expr("-0xff0000") == (uint32_t)-16711680);
+        REQUIRE_THROWS(eval_expr("-0xfffffffff"));
+        REQUIRE_THROWS(eval_expr("--1"));
+    }
+
+    SECTION("Mul/Div Operators") {
+        REQUIRE(eval_expr("1*2") == (uint32_t)2);
+        REQUIRE(eval_expr("1 / 2") == (uint32_t)0);
+        REQUIRE(eval_expr("1 / 2 * 2") == (uint32_t)0);
+        REQUIRE(eval_expr("1 * 2 / 2") == (uint32_t)1);
+        REQUIRE(eval_expr("1 * 2 / -2") == (uint32_t)-1);
+        REQUIRE(eval_expr("-1 * 2 / -2") == (uint32_t)1);
+        REQUIRE(eval_expr("-1 * -2 / -2") == (uint32_t)-1);
+        REQUIRE(eval_expr("two/one") == (uint32_t)2);
+        REQUIRE_THROWS(eval_expr("2 ** -1"));
+    }
+
+    SECTION("Add/Sub Operators") {
+        REQUIRE(eval_expr("1+2") == (uint32_t)3);
+        REQUIRE(eval_expr("1 - 2") == (uint32_t)-1);
+    }
+
+    SECTION("Or/And Operators") {
+        REQUIRE(eval_expr("1 | 2") == (uint32_t)3);
+        REQUIRE(eval_expr("1 | deadbeef") == (uint32_t)(1 | 0xdeadbeef));
+        REQUIRE(eval_expr("-1 | 2") == (uint32_t)-1);
+        REQUIRE(eval_expr("2 | -1") == (uint32_t)-1);
+        REQUIRE_THROWS(eval_expr("2 || -1"));
+
+        REQUIRE(eval_expr("1 & 2") == (uint32_t)0);
+        REQUIRE(eval_expr("1 & deadbeef") == (uint32_t)(1 & 0xdeadbeef));
+        REQUIRE(eval_expr("-1 & 2") == (uint32_t)2);
+        REQUIRE(eval_expr("2 & -1") == (uint32_t)2);
+        REQUIRE_THROWS(eval_expr("2 && -1"));
+    }
+
+    SECTION("Parentheses") {
+        REQUIRE(eval_expr("(1 & 2) | 3") == (uint32_t)3);
+        REQUIRE(eval_expr("(0b10101 | 0b1010) + (5 * 5)") == (uint32_t)56);
+        REQUIRE(eval_expr("(0b10101 | 0b1010) & (5 * 5)") == (uint32_t)25);
+        REQUIRE(eval_expr("-(-1)") == (uint32_t)1);
+        REQUIRE_THROWS(eval_expr("(0b10101 | 0b1010"));
+    }
+
+    SECTION("Order of Operations") {
+        REQUIRE(eval_expr("1 & 2 * 3 | +4 + ~5 - 1") == (uint32_t)-3);
+        REQUIRE(eval_expr("(1 & (2 * 3 | +4) + ~5) - 1") == (uint32_t)-1);
+    }
+}
+
+TEST_CASE("RD: program parsing", "[parser][rd][statement]") {
+    using namespace client::ast;
+
+    auto program = parse_program(
+        "# bot\n"
+        ".data\n"
+        "x: .word 1, 2 /* spans\n lines */\n"
+        "\n"
+        ".text\n"
+        "main: a: lw $t0, 4($sp)\n"
+        "    sw $t0 ($sp)\n"
+        "    add.s $f0, $f1, $f2\n"
+        "    la $a0, a+4\n"
+        "    jr $ra\n");
+
+    REQUIRE(program.size() == 8);
+    REQUIRE(program[1].labels == std::vector<std::string_view>{"x"});
+    REQUIRE(boost::get<WordDir>(boost::get<Directive>(program[1].body)).expression_list.size() == 2);
+
+    const auto& lw = program[3];
+    REQUIRE(lw.line == 7);
+    REQUIRE(lw.source == "main: a: lw $t0, 4($sp)");
+    REQUIRE(lw.labels == std::vector<std::string_view>{"main", "a"});
+    const auto& lw_inst = boost::get<InstructionStmt>(lw.body);
+    REQUIRE(lw_inst.mnemonic == "lw");
+    REQUIRE(lw_inst.operands.size() == 2);
+    REQUIRE(boost::get<RegisterOperand>(lw_inst.operands[0]).reg == 8);
+    const auto& addr = boost::get<AddressOperand>(lw_inst.operands[1]);
+    REQUIRE(addr.base_reg == 29);
+    REQUIRE(eval(*addr.offset) == 4);
+
+    const auto& sw_inst = boost::get<InstructionStmt>(program[4].body);
+    REQUIRE_FALSE(boost::get<AddressOperand>(sw_inst.operands[1]).offset.has_value());
+
+    const auto& add_inst = boost::get<InstructionStmt>(program[5].body);
+    REQUIRE(add_inst.mnemonic == "add.s");
+    REQUIRE(boost::get<RegisterOperand>(add_inst.operands[2]).floating_point);
+
+    const auto& la_inst = boost::get<InstructionStmt>(program[6].body);
+    REQUIRE(eval(boost::get<expression>(la_inst.operands[1])) == 1 + 4);
+
+    REQUIRE_THROWS_AS(parse_program("add $t0 $t1 $t2 .word"), syntax_error);
+    try {
+        parse_program(".text\n  lw $t0, 4($sp\n");
+        FAIL("expected a syntax error");
+    } catch (const syntax_error& e) {
+        REQUIRE(e.line == 2);
+        REQUIRE(e.column == 16);
+    }
+}
+
+TEST_CASE("RD: statements point into the source", "[parser][rd][statement]") {
+    using namespace client::ast;
+
+    std::string text = "msg: .asciiz \"hi\\n\"\r\n.text\nmain: jr $ra";
+    auto statements = parse_program(text);
+    REQUIRE(statements.size() == 3);
+
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const auto& msg = statements[0];
+    REQUIRE(msg.source == "msg: .asciiz \"hi\\n\"");
+    REQUIRE((msg.labels[0].data() >= begin && msg.labels[0].data() < end));
+    const auto& str = boost::get<AsciizDir>(boost::get<Directive>(msg.body))[0];
+    REQUIRE(str.quoted == "\"hi\\n\"");
+    REQUIRE(str.decode() == "hi\n");
+    REQUIRE(statements[2].source == "main: jr $ra");
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "tournament/journal.h"
+
+static MatchRecord make_record(uint64_t match_id) {
+    MatchRecord record = {};
+    record.match_id = match_id;
+    record.seed = 1000 + match_id;
+    record.bot_hash[0] = 0xaaaa;
+    record.bot_hash[1] = 0xbbbb;
+    record.winner = match_id % 2;
+    return record;
+}
+
+TEST_CASE("Journal recovers appended matches", "[tournament][journal]") {
+    char path[] = "/tmp/spimbot_journal_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd != -1);
+    ::close(fd);
+
+    {
+        TournamentJournal journal;
+        REQUIRE(journal.open(path));
+        REQUIRE(journal.size() == 0);
+        for (uint64_t i = 1; i <= 1500; ++i) {  // crosses a growth chunk
+            REQUIRE(journal.append(make_record(i)));
+        }
+    }
+
+    SECTION("Reopen keeps every record") {
+        TournamentJournal journal;
+        REQUIRE(journal.open(path));
+        REQUIRE(journal.size() == 1500);
+        REQUIRE(journal.discarded() == 0);
+        REQUIRE(journal.is_complete(7, 1007, 0xaaaa, 0xbbbb));
+        REQUIRE_FALSE(journal.is_complete(7, 1007, 0xaaaa, 0xcccc));
+        REQUIRE_FALSE(journal.is_complete(1501, 2501, 0xaaaa, 0xbbbb));
+        REQUIRE(journal.find(8)->winner == 0);
+    }
+
+    SECTION("A torn record and everything after it is dropped") {
+        fd = ::open(path, O_RDWR);
+        REQUIRE(fd != -1);
+        uint32_t garbage = 0xdeadbeef;
+        REQUIRE(pwrite(fd, &garbage, sizeof(garbage), 64 + 1000 * sizeof(MatchRecord) + 8) ==
+                sizeof(garbage));
+        ::close(fd);
+
+        TournamentJournal journal;
+        REQUIRE(journal.open(path));
+        REQUIRE(journal.size() == 1000);
+        REQUIRE(journal.discarded() == 500);
+        REQUIRE(journal.find(1001) == nullptr);
+
+        REQUIRE(journal.append(make_record(1001)));
+        journal.close();
+        REQUIRE(journal.open(path));
+        REQUIRE(journal.size() == 1001);
+    }
+
+    unlink(path);
+}
+
+TEST_CASE("Journal restarts a file whose header was never completed", "[tournament][journal]") {
+    char path[] = "/tmp/spimbot_journal_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd != -1);
+    REQUIRE(write(fd, "SPIM", 4) == 4);  // crashed part-way through writing the header
+    ::close(fd);
+
+    TournamentJournal journal;
+    REQUIRE(journal.open(path));
+    REQUIRE(journal.size() == 0);
+    REQUIRE(journal.append(make_record(1)));
+    journal.close();
+
+    REQUIRE(journal.open(path));
+    REQUIRE(journal.size() == 1);
+
+    unlink(path);
+}
+
+TEST_CASE("Journal restarts a file that grew before its header was written", "[tournament][journal]") {
+    char path[] = "/tmp/spimbot_journal_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd != -1);
+    REQUIRE(ftruncate(fd, 64 + 1024 * sizeof(MatchRecord)) == 0);  // crashed before the header
+    ::close(fd);
+
+    TournamentJournal journal;
+    REQUIRE(journal.open(path));
+    REQUIRE(journal.size() == 0);
+    REQUIRE(journal.append(make_record(1)));
+    journal.close();
+
+    REQUIRE(journal.open(path));
+    REQUIRE(journal.size() == 1);
+
+    unlink(path);
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "tournament/metrics.h"
+
+static std::string segment_name() { return "/spimbot_metrics_test_" + std::to_string(getpid()); }
+
+TEST_CASE("Metrics published by a worker are visible to a reader", "[tournament][metrics]") {
+    std::string name = segment_name();
+    TournamentMetrics runner;
+    REQUIRE(runner.create(name, 2));
+
+    MetricsWriter worker = runner.writer(1);
+    worker.start_match(42);
+    worker.quantum(1000, 500);
+    worker.quantum(3000, 1500);
+    worker.bot_finished(0xaaaa, 4000, 1000);
+    worker.bot_finished(0xbbbb, 1000, 1000);
+    worker.finish_match();
+
+    TournamentMetrics reader;
+    REQUIRE(reader.open(name));
+    REQUIRE(reader.workers() == 2);
+
+    WorkerMetrics idle, busy;
+    REQUIRE(reader.read(0, idle));
+    REQUIRE(idle.started_ns == 0);
+
+    REQUIRE(reader.read(1, busy));
+    REQUIRE(busy.started_ns != 0);
+    REQUIRE(busy.updated_ns >= busy.started_ns);
+    REQUIRE(busy.instructions == 4000);
+    REQUIRE(busy.busy_ns == 2000);
+    REQUIRE(busy.matches == 1);
+    REQUIRE(busy.current_match == 0);
+    REQUIRE(busy.slowest_bot == 0xbbbb);
+    REQUIRE(busy.slowest_ps == 1000);
+
+    REQUIRE_FALSE(reader.read(2, busy));
+    MetricsWriter read_only = reader.writer(0);
+    read_only.quantum(1, 1);  // ignored
+    REQUIRE(reader.read(0, idle));
+    REQUIRE(idle.instructions == 0);
+
+    REQUIRE(TournamentMetrics::unlink(name));
+}
+
+TEST_CASE("Metrics reads never see a half-published update", "[tournament][metrics]") {
+    std::string name = segment_name();
+    TournamentMetrics runner;
+    REQUIRE(runner.create(name, 1));
+    MetricsWriter worker = runner.writer(0);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 0; i < 200000; ++i) {
+            worker.quantum(2, 1);  // instructions stays exactly twice busy_ns
+        }
+        done = true;
+    });
+
+    TournamentMetrics reader;
+    REQUIRE(reader.open(name));
+    bool consistent = true;
+    uint64_t last = 0;
+    while (!done) {
+        WorkerMetrics metrics;
+        if (reader.read(0, metrics)) {
+            consistent = consistent && metrics.instructions == 2 * metrics.busy_ns && metrics.busy_ns >= last;
+            last = metrics.busy_ns;
+        }
+    }
+    writer.join();
+    REQUIRE(consistent);
+
+    WorkerMetrics final_metrics;
+    REQUIRE(reader.read(0, final_metrics));
+    REQUIRE(final_metrics.busy_ns == 200000);
+
+    TournamentMetrics::unlink(name);
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+
+#include "util/random.h"
+
+TEST_CASE("Philox4x32-10 matches the Random123 known answers", "[util][random]") {
+    using util::philox4x32;
+
+    REQUIRE(philox4x32({0, 0, 0, 0}, {0, 0}) ==
+            util::philox_ctr{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+    REQUIRE(philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                       {0xffffffff, 0xffffffff}) ==
+            util::philox_ctr{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+    REQUIRE(philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                       {0xa4093822, 0x299f31d0}) ==
+            util::philox_ctr{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEST_CASE("MatchRng streams are reproducible and independent", "[util][random]") {
+    util::MatchRng rng(0x123456789abcdefull, 1);
+
+    SECTION("Sequential draws agree with random access") {
+        util::MatchRng replay(0x123456789abcdefull, 1);
+        for (uint64_t i = 0; i < 100; ++i) {
+            REQUIRE(rng() == replay.at(i));
+        }
+        replay.seek(37);
+        REQUIRE(replay() == rng.at(37));
+        REQUIRE(replay.position() == 38);
+    }
+
+    SECTION("Bots, streams and seeds draw different values") {
+        REQUIRE(rng.at(0) != util::MatchRng(0x123456789abcdefull, 2).at(0));
+        REQUIRE(rng.at(0) != util::MatchRng(0x123456789abcdefull, 1, 1).at(0));
+        REQUIRE(rng.at(0) != util::MatchRng(0x123456789abcdeeull, 1).at(0));
+    }
+
+    SECTION("Derived values stay in range") {
+        for (uint64_t i = 0; i < 1000; ++i) {
+            double u = rng.uniform(i);
+            REQUIRE(u >= 0.0);
+            REQUIRE(u < 1.0);
+            REQUIRE(rng.below(i, 7) < 7);
+        }
+        std::uniform_int_distribution<int> die(1, 6);
+        int roll = die(rng);
+        REQUIRE(roll >= 1);
+        REQUIRE(roll <= 6);
+    }
+
+    SECTION("Bulk fill matches block()") {
+        uint32_t words[16];
+        rng.fill(5, words, 4);
+        REQUIRE(words[4] == rng.block(6)[0]);
+        REQUIRE(words[15] == rng.at(4 * 8 + 3));
+    }
+}
+
+static_assert(util::MatchRng(1, 2).at(3) == util::MatchRng(1, 2).block(0)[3],
+              "MatchRng is usable in constant expressions");
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/spsc_ring.h"
+
+TEST_CASE("SpscRing is a bounded FIFO", "[util][spsc_ring]") {
+    util::SpscRing<int> ring(3);
+    REQUIRE(ring.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(ring.try_push(i));
+    }
+    REQUIRE_FALSE(ring.try_push(4));
+
+    int out[8];
+    REQUIRE(ring.pop(out, 3) == 3);
+    REQUIRE(out[0] == 0);
+    REQUIRE(out[2] == 2);
+
+    /* Wraps around the end of the buffer. */
+    REQUIRE(ring.try_push(4));
+    REQUIRE(ring.try_push(5));
+    REQUIRE(ring.pop(out, 8) == 3);
+    REQUIRE(out[0] == 3);
+    REQUIRE(out[2] == 5);
+    REQUIRE(ring.pop(out, 8) == 0);
+}
+
+TEST_CASE("SpscRing hands every item across threads in order", "[util][spsc_ring]") {
+    constexpr uint64_t COUNT = 200000;
+    util::SpscRing<uint64_t> ring(64);
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < COUNT;) {
+            if (ring.try_push(i)) {
+                ++i;
+            }
+        }
+    });
+
+    std::vector<uint64_t> received;
+    uint64_t batch[16];
+    while (received.size() < COUNT) {
+        size_t n = ring.pop(batch, 16);
+        received.insert(received.end(), batch, batch + n);
+    }
+    producer.join();
+
+    bool in_order = true;
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        in_order = in_order && received[i] == i;
+    }
+    REQUIRE(in_order);
+}
@@ -0,0 +1,214 @@
+/**
+ * Watches a running tournament's live metrics (src/tournament/metrics.h).
+ *
+ * Every interval, reads each worker's slot from the shared-memory segment and prints one
+ * tab-separated line per worker (matches, guest MIPS and utilization over the interval, the match
+ * being played and how long ago the worker last published) and a total, then the slowest bot
+ * seen so far. With --prometheus, also writes the same figures in Prometheus text format to FILE,
+ * replacing it atomically each time, for node_exporter's textfile collector:
+ *
+ *     spimbot_metrics [--interval SECONDS] [--count N] [--prometheus FILE] /spimbot-metrics
+ *
+ * Only reads the segment, so it cannot slow the workers down.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "tournament/metrics.h"
+
+namespace {
+
+struct Options {
+    std::string name;
+    std::string prometheus;
+    double interval = 1.0;
+    uint64_t count = 0; /* 0: until interrupted */
+};
+
+/* A worker's figures over the last interval (or its whole life, on the first read). */
+struct Rates {
+    double mips = 0;
+    double utilization = 0;
+};
+
+void usage(FILE *out) {
+    fprintf(out, "usage: spimbot_metrics [--interval SECONDS] [--count N] [--prometheus FILE] NAME\n");
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            usage(stdout);
+            exit(0);
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            if (!options.name.empty()) {
+                return false;
+            }
+            options.name = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+        if (arg == "--interval") {
+            options.interval = atof(value);
+        } else if (arg == "--count") {
+            options.count = strtoull(value, nullptr, 10);
+        } else if (arg == "--prometheus") {
+            options.prometheus = value;
+        } else {
+            return false;
+        }
+    }
+    return !options.name.empty() && options.interval > 0;
+}
+
+Rates rates(const WorkerMetrics &now, const WorkerMetrics *before, uint64_t now_ns, uint64_t before_ns) {
+    Rates r;
+    uint64_t wall = before != nullptr ? now_ns - before_ns : now_ns - now.started_ns;
+    uint64_t instructions = now.instructions - (before != nullptr ? before->instructions : 0);
+    uint64_t busy = now.busy_ns - (before != nullptr ? before->busy_ns : 0);
+    if (wall != 0) {
+        r.mips = instructions * 1e3 / wall;
+        r.utilization = (double)busy / wall;
+    }
+    return r;
+}
+
+bool write_prometheus(const std::string &path, const std::vector<WorkerMetrics> &workers,
+                      const std::vector<Rates> &worker_rates) {
+    std::string temp = path + ".tmp";
+    FILE *out = fopen(temp.c_str(), "w");
+    if (out == nullptr) {
+        return false;
+    }
+
+    struct Counter {
+        const char *name;
+        const char *type;
+        const char *help;
+    };
+    const Counter counters[] = {
+        {"spimbot_guest_instructions_total", "counter", "Guest instructions executed."},
+        {"spimbot_busy_seconds_total", "counter", "Host time spent running guests."},
+        {"spimbot_matches_completed_total", "counter", "Matches completed."},
+        {"spimbot_guest_mips", "gauge", "Guest instructions per host second over the last interval, in millions."},
+        {"spimbot_worker_utilization", "gauge", "Fraction of the last interval spent running guests."},
+    };
+    for (size_t c = 0; c < sizeof(counters) / sizeof(counters[0]); ++c) {
+        fprintf(out, "# HELP %s %s\n# TYPE %s %s\n", counters[c].name, counters[c].help, counters[c].name,
+                counters[c].type);
+        for (size_t w = 0; w < workers.size(); ++w) {
+            if (workers[w].started_ns == 0) {
+                continue;
+            }
+            double values[] = {(double)workers[w].instructions, workers[w].busy_ns * 1e-9, (double)workers[w].matches,
+                               worker_rates[w].mips, worker_rates[w].utilization};
+            fprintf(out, "%s{worker=\"%zu\"} %.17g\n", counters[c].name, w, values[c]);
+        }
+    }
+
+    double total_mips = 0;
+    const WorkerMetrics *slowest = nullptr;
+    for (size_t w = 0; w < workers.size(); ++w) {
+        const WorkerMetrics &m = workers[w];
+        if (m.started_ns == 0) {
+            continue;
+        }
+        total_mips += worker_rates[w].mips;
+        if (m.slowest_ps != 0 && (slowest == nullptr || m.slowest_ps > slowest->slowest_ps)) {
+            slowest = &m;
+        }
+    }
+    fprintf(out, "# HELP spimbot_total_guest_mips Guest MIPS over all workers.\n");
+    fprintf(out, "# TYPE spimbot_total_guest_mips gauge\nspimbot_total_guest_mips %.17g\n", total_mips);
+    if (slowest != nullptr) {
+        fprintf(out, "# HELP spimbot_slowest_bot_ns_per_instruction Host time per instruction of the slowest bot.\n");
+        fprintf(out, "# TYPE spimbot_slowest_bot_ns_per_instruction gauge\n");
+        fprintf(out, "spimbot_slowest_bot_ns_per_instruction{bot=\"%016llx\"} %.3f\n",
+                (unsigned long long)slowest->slowest_bot, slowest->slowest_ps * 1e-3);
+    }
+
+    bool ok = fclose(out) == 0;
+    return ok && rename(temp.c_str(), path.c_str()) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(stderr);
+        return 2;
+    }
+
+    TournamentMetrics metrics;
+    if (!metrics.open(options.name)) {
+        fprintf(stderr, "spimbot_metrics: %s\n", metrics.error().c_str());
+        return 2;
+    }
+
+    std::vector<WorkerMetrics> previous;
+    uint64_t previous_ns = 0;
+    for (uint64_t round = 0; options.count == 0 || round < options.count; ++round) {
+        if (round != 0) {
+            usleep(static_cast<useconds_t>(options.interval * 1e6));
+        }
+
+        uint64_t now_ns = metrics_now_ns();
+        std::vector<WorkerMetrics> workers(metrics.workers());
+        std::vector<Rates> worker_rates(workers.size());
+        for (uint32_t w = 0; w < workers.size(); ++w) {
+            if (!metrics.read(w, workers[w])) {
+                workers[w] = previous.size() > w ? previous[w] : WorkerMetrics{};
+            }
+            bool same_worker = previous.size() > w && previous[w].started_ns == workers[w].started_ns;
+            worker_rates[w] = rates(workers[w], same_worker ? &previous[w] : nullptr, now_ns, previous_ns);
+        }
+
+        printf("worker\tmatches\tmips\tutilization\tmatch\tage_s\n");
+        uint64_t matches = 0;
+        double mips = 0;
+        double utilization = 0;
+        size_t active = 0;
+        const WorkerMetrics *slowest = nullptr;
+        for (size_t w = 0; w < workers.size(); ++w) {
+            const WorkerMetrics &m = workers[w];
+            if (m.started_ns == 0) {
+                continue;
+            }
+            printf("%zu\t%llu\t%.1f\t%.2f\t%llu\t%.1f\n", w, (unsigned long long)m.matches, worker_rates[w].mips,
+                   worker_rates[w].utilization, (unsigned long long)m.current_match, (now_ns - m.updated_ns) * 1e-9);
+            matches += m.matches;
+            mips += worker_rates[w].mips;
+            utilization += worker_rates[w].utilization;
+            ++active;
+            if (m.slowest_ps != 0 && (slowest == nullptr || m.slowest_ps > slowest->slowest_ps)) {
+                slowest = &m;
+            }
+        }
+        printf("total\t%llu\t%.1f\t%.2f\t-\t-\n", (unsigned long long)matches, mips,
+               active != 0 ? utilization / active : 0.0);
+        if (slowest != nullptr) {
+            printf("slowest bot %016llx at %.3f ns/instruction\n", (unsigned long long)slowest->slowest_bot,
+                   slowest->slowest_ps * 1e-3);
+        }
+        printf("\n");
+        fflush(stdout);
+
+        if (!options.prometheus.empty() && !write_prometheus(options.prometheus, workers, worker_rates)) {
+            fprintf(stderr, "spimbot_metrics: cannot write %s\n", options.prometheus.c_str());
+        }
+        previous = workers;
+        previous_ns = now_ns;
+    }
+    return 0;
+}
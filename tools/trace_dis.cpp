@@ -0,0 +1,147 @@
+/**
+ * Disassembles an instruction trace (spim_trace_exec) offline.
+ *
+ * Assembles the traced program again through the C library, then walks the trace and writes one
+ * tab-separated line per executed instruction: its index, the closest label, the instruction as
+ * QtSpimbot prints it, and the registers it wrote:
+ *
+ *     trace_dis [--exception-file FILE] [--from N] [--count N] program.s match.spxt
+ *
+ * The program (and exception handler) must be the ones that were traced; the trace only holds
+ * PCs. Each distinct PC is disassembled once.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "exec_trace.h"
+#include "spimbot.h"
+
+namespace {
+
+struct Options {
+    std::string program;
+    std::string trace;
+    std::string exception_file;
+    uint64_t from = 0;
+    uint64_t count = UINT64_MAX;
+};
+
+struct Line {
+    std::string symbol;
+    std::string text;
+};
+
+void usage(FILE *out) {
+    fprintf(out, "usage: trace_dis [--exception-file FILE] [--from N] [--count N] program.s trace\n");
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            usage(stdout);
+            exit(0);
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+        if (arg == "--exception-file") {
+            options.exception_file = value;
+        } else if (arg == "--from") {
+            options.from = strtoull(value, nullptr, 10);
+        } else if (arg == "--count") {
+            options.count = strtoull(value, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    if (positional.size() != 2) {
+        return false;
+    }
+    options.program = positional[0];
+    options.trace = positional[1];
+    return true;
+}
+
+/* The whole string from an snprintf-style GET(buffer, size). */
+template <class F>
+std::string fetch(F get) {
+    std::string text(get(nullptr, 0), '\0');
+    get(&text[0], text.size() + 1);
+    return text;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(stderr);
+        return 2;
+    }
+
+    exec_trace_reader_t reader;
+    if (!reader.open(options.trace)) {
+        fprintf(stderr, "trace_dis: %s is not an instruction trace\n", options.trace.c_str());
+        return 2;
+    }
+
+    spim_options spim;
+    spim_default_options(&spim);
+    spim.delayed_branches = reader.delayed_branches();
+    spim.exception_file = options.exception_file.empty() ? nullptr : options.exception_file.c_str();
+    spim_cpu *cpu = spim_create(&spim);
+    if (spim_load_asm(cpu, options.program.c_str()) != SPIM_OK) {
+        fprintf(stderr, "trace_dis: %s did not assemble\n", options.program.c_str());
+        spim_destroy(cpu);
+        return 2;
+    }
+
+    std::unordered_map<uint32_t, Line> lines;
+    exec_step_t step;
+    printf("step\tsymbol\tinstruction\twrites\n");
+    for (uint64_t n = 0; reader.next(step); ++n) {
+        if (n < options.from) {
+            continue;
+        }
+        if (n - options.from >= options.count) {
+            break;
+        }
+        auto found = lines.find(step.pc);
+        if (found == lines.end()) {
+            Line line;
+            line.symbol = fetch([&](char *buffer, size_t size) { return spim_symbolize(cpu, step.pc, buffer, size); });
+            line.text = fetch([&](char *buffer, size_t size) { return spim_disassemble(cpu, step.pc, buffer, size); });
+            std::replace(line.text.begin(), line.text.end(), '\t', ' ');
+            found = lines.emplace(step.pc, std::move(line)).first;
+        }
+
+        printf("%llu\t%s\t%s\t", (unsigned long long)n, found->second.symbol.c_str(), found->second.text.c_str());
+        for (size_t i = 0; i < step.writes; ++i) {
+            const char *sep = i == 0 ? "" : " ";
+            if (step.reg[i] == exec_trace_t::REG_HI) {
+                printf("%shi=0x%08x", sep, (uint32_t)step.value[i]);
+            } else if (step.reg[i] == exec_trace_t::REG_LO) {
+                printf("%slo=0x%08x", sep, (uint32_t)step.value[i]);
+            } else {
+                printf("%s$%d=0x%08x", sep, step.reg[i], (uint32_t)step.value[i]);
+            }
+        }
+        printf("\n");
+    }
+
+    spim_destroy(cpu);
+    return 0;
+}